@@ -19,6 +19,7 @@
 
 #include <rmf_fleet_adapter/agv/FleetUpdateHandle.hpp>
 #include <rmf_fleet_adapter/agv/EasyTrafficLight.hpp>
+#include <rmf_fleet_adapter/agv/EasyTrafficLightGroup.hpp>
 
 #include <rmf_traffic/agv/VehicleTraits.hpp>
 #include <rmf_traffic/agv/Graph.hpp>
@@ -151,6 +152,44 @@ public:
     std::function<void()> resume_callback,
     std::function<void(Blockers)> deadlock_callback = nullptr);
 
+  /// Create easy traffic lights for a group of robots that are all managed by
+  /// the same integration. This is meant for integrations that drive many
+  /// robots at once, since the group lets them update any number of robots
+  /// with one call and receive the commands for all of them in one callback.
+  ///
+  /// The same caveats apply as for add_easy_traffic_light.
+  ///
+  /// \param[in] handle_callback
+  ///   The callback that will be triggered when the traffic lights of every
+  ///   robot in the group are ready to be used. This callback will only be
+  ///   triggered once.
+  ///
+  /// \param[in] fleet_name
+  ///   The name of the fleet
+  ///
+  /// \param[in] robot_names
+  ///   The names of the robots. The index of each name is how its robot will
+  ///   be identified by the group.
+  ///
+  /// \param[in] traits
+  ///   The traits of the robots
+  ///
+  /// \param[in] command_callback
+  ///   The callback that will be triggered with the immediate pauses and the
+  ///   resumes that the traffic lights need the robots to perform.
+  ///
+  /// \param[in] deadlock_callback
+  ///   The callback that will be triggered if there is a permanent blocker
+  ///   disrupting the ability of one of the robots to proceed. A callback does
+  ///   not need to be provided for this.
+  void add_easy_traffic_light_group(
+    std::function<void(EasyTrafficLightGroupPtr group)> handle_callback,
+    const std::string& fleet_name,
+    const std::vector<std::string>& robot_names,
+    rmf_traffic::agv::VehicleTraits traits,
+    EasyTrafficLightGroup::CommandCallback command_callback,
+    EasyTrafficLightGroup::DeadlockCallback deadlock_callback = nullptr);
+
 
   /// Get the rclcpp::Node that this adapter will be using for communication.
   std::shared_ptr<rclcpp::Node> node();
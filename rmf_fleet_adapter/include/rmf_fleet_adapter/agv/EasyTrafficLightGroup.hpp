@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_FLEET_ADAPTER__AGV__EASYTRAFFICLIGHTGROUP_HPP
+#define RMF_FLEET_ADAPTER__AGV__EASYTRAFFICLIGHTGROUP_HPP
+
+#include <rmf_fleet_adapter/agv/EasyTrafficLight.hpp>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+/// A group of easy traffic lights for many robots that are driven by the same
+/// integration. The group lets you update any number of its robots with one
+/// call, and it reports the pause and resume commands for all of its robots
+/// through one callback.
+///
+/// Each robot in the group is identified by its index, which is its position
+/// in the list of robot names given to Adapter::add_easy_traffic_light_group.
+class EasyTrafficLightGroup
+  : public std::enable_shared_from_this<EasyTrafficLightGroup>
+{
+public:
+
+  using MovingInstruction = EasyTrafficLight::MovingInstruction;
+  using WaitingInstruction = EasyTrafficLight::WaitingInstruction;
+
+  /// A new path for one robot in the group.
+  struct NewPath
+  {
+    std::size_t robot;
+    std::vector<Waypoint> path;
+  };
+
+  /// Update the traffic lights of several robots with new paths. This has the
+  /// same effect as EasyTrafficLight::follow_new_path for each robot, except
+  /// the plans for all of the paths are found against one view of the traffic
+  /// schedule.
+  ///
+  /// \throws std::out_of_range if any robot index is not in the group.
+  EasyTrafficLightGroup& follow_new_paths(std::vector<NewPath> paths);
+
+  /// The location of one robot in the group while it is idle.
+  struct IdleLocation
+  {
+    std::size_t robot;
+    std::string map_name;
+    Eigen::Vector3d position;
+  };
+
+  /// Update the locations of several idle robots. This has the same effect as
+  /// EasyTrafficLight::update_idle_location for each robot.
+  ///
+  /// \throws std::out_of_range if any robot index is not in the group.
+  EasyTrafficLightGroup& update_idle_locations(
+    std::vector<IdleLocation> locations);
+
+  /// A report that one robot in the group is moving.
+  struct Moving
+  {
+    /// The robot that is moving
+    std::size_t robot;
+
+    /// The last checkpoint which the robot passed over
+    std::size_t checkpoint;
+
+    /// The current location of the robot
+    Eigen::Vector3d location;
+  };
+
+  /// Tell the traffic lights that several robots are moving.
+  ///
+  /// \return the instruction for each robot, in the same order as the updates.
+  /// See EasyTrafficLight::moving_from for what each instruction means and for
+  /// when the updates should be given.
+  ///
+  /// \throws std::out_of_range if any robot index is not in the group.
+  [[nodiscard]]
+  std::vector<MovingInstruction> moving_from(
+    const std::vector<Moving>& updates);
+
+  /// A report that one robot in the group is waiting.
+  struct Waiting
+  {
+    /// The robot that is waiting
+    std::size_t robot;
+
+    /// The checkpoint where the robot is waiting, or the last checkpoint that
+    /// it passed if it is waiting in-between checkpoints.
+    std::size_t checkpoint;
+
+    /// Leave this as nullopt if the robot is waiting at the checkpoint.
+    /// Otherwise give the location where the robot is waiting.
+    std::optional<Eigen::Vector3d> location;
+  };
+
+  /// Tell the traffic lights that several robots are waiting.
+  ///
+  /// \return the instruction for each robot, in the same order as the updates.
+  /// See EasyTrafficLight::waiting_at and EasyTrafficLight::waiting_after for
+  /// what each instruction means.
+  ///
+  /// \throws std::out_of_range if any robot index is not in the group.
+  [[nodiscard]]
+  std::vector<WaitingInstruction> waiting(const std::vector<Waiting>& updates);
+
+  /// Get the traffic light of one robot in the group. This can be used for the
+  /// updates that do not have a group version.
+  ///
+  /// \throws std::out_of_range if the robot index is not in the group.
+  const EasyTrafficLightPtr& light(std::size_t robot) const;
+
+  /// Get the number of robots in the group.
+  std::size_t size() const;
+
+  /// A command that the traffic light system has issued to a robot on its own
+  /// initiative, rather than in response to an update.
+  enum class Command : uint8_t
+  {
+    /// The robot should pause immediately.
+    Pause = 0,
+
+    /// The robot may resume moving forward.
+    Resume
+  };
+
+  struct RobotCommand
+  {
+    std::size_t robot;
+    Command command;
+  };
+
+  /// The callback for receiving commands. The commands that get issued close
+  /// together are all delivered in one call, in the order that they were
+  /// issued.
+  using CommandCallback = std::function<void(std::vector<RobotCommand>)>;
+
+  /// The callback for being told that a robot in the group has a permanent
+  /// blocker.
+  using DeadlockCallback = std::function<
+    void(std::size_t robot, std::vector<EasyTrafficLight::Blocker>)>;
+
+  class Implementation;
+private:
+  EasyTrafficLightGroup();
+  rmf_utils::unique_impl_ptr<Implementation> _pimpl;
+};
+
+using EasyTrafficLightGroupPtr = std::shared_ptr<EasyTrafficLightGroup>;
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // RMF_FLEET_ADAPTER__AGV__EASYTRAFFICLIGHTGROUP_HPP
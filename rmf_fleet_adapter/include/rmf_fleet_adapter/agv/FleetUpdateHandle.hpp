@@ -75,6 +75,29 @@ public:
     rmf_traffic::agv::Plan::StartSet start,
     std::function<void(std::shared_ptr<RobotUpdateHandle> handle)> handle_cb);
 
+  /// The information needed to add one robot with add_robots(~). Each field
+  /// has the same meaning as the argument of the same name in add_robot(~).
+  struct NewRobot
+  {
+    std::shared_ptr<RobotCommandHandle> command;
+    std::string name;
+    rmf_traffic::Profile profile;
+    rmf_traffic::agv::Plan::StartSet start;
+    std::function<void(std::shared_ptr<RobotUpdateHandle> handle)> handle_cb;
+  };
+
+  /// Add several robots to this fleet adapter. This has the same effect as
+  /// calling add_robot(~) for each robot, but all of the robots are registered
+  /// with the Schedule Node together, which is much faster when a large fleet
+  /// is starting up.
+  ///
+  /// The handle_cb of each robot will be triggered once all of the robots are
+  /// ready, in the same order as the robots were given.
+  ///
+  /// \throws std::runtime_error if the StartSet of any robot is empty. None of
+  /// the robots will be added in that case.
+  void add_robots(std::vector<NewRobot> robots);
+
   /// Confirmation is a class used by the task acceptance callbacks to decide if
   /// a task description should be accepted.
   class Confirmation
@@ -286,6 +309,27 @@ public:
     bool account_for_battery_drain,
     rmf_task::ConstRequestFactoryPtr finishing_requst = nullptr);
 
+  /// Warm up the caches of the traffic planner in the background so that the
+  /// first tasks after the fleet adapter starts up can be planned at
+  /// steady-state speed. Once this is called, the caches will also be warmed
+  /// again each time the planner gets rebuilt, e.g. because lanes were closed
+  /// or speed limits were changed, and each time set_task_planner_params() is
+  /// called.
+  ///
+  /// \param[in] goals
+  ///   Additional goal waypoints to warm. Chargers, parking spots, holding
+  ///   points and named waypoints (which include pickup, dropoff and dock
+  ///   locations) are always warmed.
+  ///
+  /// \param[in] cache_file
+  ///   If provided, the set of warmed goals will be saved to this file, keyed
+  ///   by a fingerprint of the navigation graph and vehicle traits. When the
+  ///   fleet adapter restarts with the same graph and traits, every goal that
+  ///   was saved will be warmed immediately.
+  FleetUpdateHandle& warm_planner_caches(
+    std::vector<std::size_t> goals = {},
+    std::optional<std::string> cache_file = std::nullopt);
+
   /// A callback function that evaluates whether a fleet will accept a task
   /// request
   ///
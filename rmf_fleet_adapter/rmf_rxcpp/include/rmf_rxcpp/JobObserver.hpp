@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef RMF_RXCPP__JOBOBSERVER_HPP
+#define RMF_RXCPP__JOBOBSERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <type_traits>
+
+namespace rmf_rxcpp {
+
+//==============================================================================
+/// Receives the queueing delay and execution time of the jobs that rmf_rxcpp
+/// runs, sorted into the categories that the actions declare.
+class JobObserver
+{
+public:
+
+  using clock_type = std::chrono::steady_clock;
+
+  //============================================================================
+  /// Receives the timing of one category of jobs
+  class Category
+  {
+  public:
+
+    /// A job waited this long between being scheduled and a thread starting it
+    virtual void queued(clock_type::duration delay) = 0;
+
+    /// A thread spent this long running a job
+    virtual void executed(clock_type::duration time) = 0;
+
+    virtual ~Category() = default;
+  };
+
+  /// Get the category with the given name. Each category is looked up once,
+  /// so the reference must remain valid for as long as this observer does.
+  virtual Category& category(const std::string& name) = 0;
+
+  virtual ~JobObserver() = default;
+};
+
+namespace detail {
+
+//==============================================================================
+inline std::atomic<JobObserver*>& job_observer()
+{
+  static std::atomic<JobObserver*> observer{nullptr};
+  return observer;
+}
+
+} // namespace detail
+
+//==============================================================================
+/// Set the observer of every job in the process. The observer must remain
+/// valid for the rest of the process. Jobs that run before this is called are
+/// not observed.
+///
+/// \return false if another observer has already been set, in which case the
+/// other observer is kept.
+inline bool set_job_observer(JobObserver& observer)
+{
+  JobObserver* expected = nullptr;
+  return detail::job_observer().compare_exchange_strong(expected, &observer);
+}
+
+namespace detail {
+
+//==============================================================================
+/// Actions can choose their category by declaring
+/// static constexpr const char* job_category = "...";
+template<typename Action, typename = void>
+struct JobCategoryName
+{
+  static constexpr const char* value = "job";
+};
+
+template<typename Action>
+struct JobCategoryName<Action, std::void_t<decltype(Action::job_category)>>
+{
+  static constexpr const char* value = Action::job_category;
+};
+
+//==============================================================================
+/// Get the category that jobs of this Action report to, or nullptr if there is
+/// no observer yet.
+template<typename Action>
+JobObserver::Category* job_category()
+{
+  static std::atomic<JobObserver::Category*> category{nullptr};
+  if (const auto c = category.load(std::memory_order_acquire))
+    return c;
+
+  const auto observer = job_observer().load(std::memory_order_acquire);
+  if (!observer)
+    return nullptr;
+
+  const auto c = &observer->category(JobCategoryName<Action>::value);
+  category.store(c, std::memory_order_release);
+  return c;
+}
+
+} // namespace detail
+} // namespace rmf_rxcpp
+
+#endif // RMF_RXCPP__JOBOBSERVER_HPP
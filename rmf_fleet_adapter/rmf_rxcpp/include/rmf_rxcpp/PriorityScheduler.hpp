@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_RXCPP__PRIORITYSCHEDULER_HPP
+#define RMF_RXCPP__PRIORITYSCHEDULER_HPP
+
+#include <rmf_rxcpp/JobObserver.hpp>
+#include <rxcpp/rx.hpp>
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace rmf_rxcpp {
+
+//==============================================================================
+/// The priority classes that jobs can be given. Whenever a thread of the
+/// PriorityScheduler becomes free, it picks the next action of the highest
+/// priority class that is ready to run.
+enum class JobPriority : std::size_t
+{
+  /// Jobs that keep a robot safe, e.g. finding an emergency pullover
+  emergency = 0,
+
+  /// Jobs that other fleets are waiting on, e.g. negotiation responses
+  negotiation,
+
+  /// Ordinary jobs, e.g. replanning the route of an active task
+  routine,
+
+  /// Jobs that nobody is waiting on, e.g. warming planner caches
+  background
+};
+
+constexpr std::size_t NumJobPriorities = 4;
+
+//==============================================================================
+/// The name of the JobObserver category that a priority class reports to
+inline const char* job_category_name(JobPriority priority)
+{
+  switch (priority)
+  {
+    case JobPriority::emergency: return "priority/emergency";
+    case JobPriority::negotiation: return "priority/negotiation";
+    case JobPriority::routine: return "priority/routine";
+    case JobPriority::background: return "priority/background";
+  }
+
+  return "priority/unknown";
+}
+
+//==============================================================================
+/// A thread pool that implements the rxcpp scheduler interface and runs the
+/// actions of its workers according to their priority class. Within a class,
+/// actions with an earlier deadline go first, and actions without a deadline
+/// are run in the order that they were scheduled.
+///
+/// Like an rxcpp event loop, the actions of any one worker never run
+/// concurrently with each other, but different workers run in parallel.
+///
+/// Each priority class reports the time from an action becoming ready until a
+/// thread starts it, and the time spent running it, to the job observer under
+/// job_category_name().
+class PriorityScheduler
+{
+public:
+
+  using clock_type = rxcpp::schedulers::scheduler::clock_type;
+  using time_point = clock_type::time_point;
+
+  /// Constructor
+  ///
+  /// \param[in] num_threads
+  ///   The number of threads in the pool. If this is zero, one thread per
+  ///   hardware thread will be used.
+  explicit PriorityScheduler(std::size_t num_threads = 0)
+  : _state(std::make_shared<State>())
+  {
+    if (num_threads == 0)
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+      _threads.emplace_back([state = _state]() { state->run(); });
+  }
+
+  PriorityScheduler(const PriorityScheduler&) = delete;
+  PriorityScheduler& operator=(const PriorityScheduler&) = delete;
+
+  ~PriorityScheduler()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      _state->stopping = true;
+    }
+    _state->wake.notify_all();
+
+    for (auto& thread : _threads)
+    {
+      if (thread.get_id() == std::this_thread::get_id())
+        thread.detach();
+      else if (thread.joinable())
+        thread.join();
+    }
+  }
+
+  /// Get an rxcpp scheduler whose workers run their actions with the given
+  /// priority and deadline.
+  rxcpp::schedulers::scheduler get_scheduler(
+    JobPriority priority,
+    std::optional<time_point> deadline = std::nullopt) const
+  {
+    return rxcpp::schedulers::make_scheduler<ClassScheduler>(
+      _state, priority, deadline);
+  }
+
+private:
+
+  struct WorkerState
+  {
+    JobPriority priority;
+    std::optional<time_point> deadline;
+    bool running = false;
+  };
+
+  struct Item
+  {
+    time_point when;
+    std::size_t sequence;
+    rxcpp::schedulers::schedulable what;
+    std::shared_ptr<WorkerState> worker;
+  };
+
+  struct ReadyOrder
+  {
+    // std::priority_queue puts the largest element on top, so this returns
+    // true when a should run after b.
+    bool operator()(const Item& a, const Item& b) const
+    {
+      const auto pa = static_cast<std::size_t>(a.worker->priority);
+      const auto pb = static_cast<std::size_t>(b.worker->priority);
+      if (pa != pb)
+        return pb < pa;
+
+      const auto& da = a.worker->deadline;
+      const auto& db = b.worker->deadline;
+      if (da != db)
+      {
+        if (!da)
+          return true;
+
+        if (!db)
+          return false;
+
+        return *db < *da;
+      }
+
+      return b.sequence < a.sequence;
+    }
+  };
+
+  struct TimedOrder
+  {
+    bool operator()(const Item& a, const Item& b) const
+    {
+      if (a.when != b.when)
+        return b.when < a.when;
+
+      return b.sequence < a.sequence;
+    }
+  };
+
+  struct State
+  {
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::size_t next_sequence = 0;
+    std::priority_queue<Item, std::vector<Item>, ReadyOrder> ready;
+    std::priority_queue<Item, std::vector<Item>, TimedOrder> timed;
+    std::array<JobObserver::Category*, NumJobPriorities> categories = {};
+
+    /// Get the observer category of a priority class, or nullptr if there is
+    /// no job observer yet. The caller must hold the mutex.
+    JobObserver::Category* observer_category(JobPriority priority)
+    {
+      auto& category = categories[static_cast<std::size_t>(priority)];
+      if (category)
+        return category;
+
+      const auto observer =
+        detail::job_observer().load(std::memory_order_acquire);
+      if (observer)
+        category = &observer->category(job_category_name(priority));
+
+      return category;
+    }
+
+    void push(
+      time_point when,
+      const rxcpp::schedulers::schedulable& what,
+      const std::shared_ptr<WorkerState>& worker)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        Item item{when, next_sequence++, what, worker};
+        if (when <= clock_type::now())
+          ready.push(std::move(item));
+        else
+          timed.push(std::move(item));
+      }
+
+      wake.notify_one();
+    }
+
+    /// Pop the highest priority item whose worker is not already running
+    /// another action. The caller must hold the mutex.
+    std::optional<Item> pop_ready()
+    {
+      std::vector<Item> busy;
+      std::optional<Item> next;
+      while (!ready.empty())
+      {
+        Item item = ready.top();
+        ready.pop();
+
+        if (!item.what.is_subscribed())
+          continue;
+
+        if (item.worker->running)
+        {
+          busy.push_back(std::move(item));
+          continue;
+        }
+
+        next = std::move(item);
+        break;
+      }
+
+      for (auto& item : busy)
+        ready.push(std::move(item));
+
+      return next;
+    }
+
+    void run()
+    {
+      rxcpp::schedulers::recursion r;
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!stopping)
+      {
+        const auto now = clock_type::now();
+        while (!timed.empty() && timed.top().when <= now)
+        {
+          ready.push(timed.top());
+          timed.pop();
+        }
+
+        auto next = pop_ready();
+        if (!next)
+        {
+          if (timed.empty())
+            wake.wait(lock);
+          else
+            wake.wait_until(lock, timed.top().when);
+
+          continue;
+        }
+
+        const auto category = observer_category(next->worker->priority);
+        next->worker->running = true;
+        lock.unlock();
+
+        const auto start = clock_type::now();
+        if (category)
+          category->queued(start - std::min(start, next->when));
+
+        // Tail recursion would let an action keep its thread without going
+        // back through the queue, so it is never allowed here.
+        r.reset(false);
+        next->what(r.get_recurse());
+
+        if (category)
+          category->executed(clock_type::now() - start);
+
+        lock.lock();
+        next->worker->running = false;
+        if (!ready.empty())
+        {
+          // Another thread may have skipped an action of this worker while it
+          // was running.
+          wake.notify_one();
+        }
+      }
+    }
+  };
+
+  struct ClassWorker : public rxcpp::schedulers::worker_interface
+  {
+    ClassWorker(
+      std::weak_ptr<State> state_,
+      std::shared_ptr<WorkerState> worker_)
+    : state(std::move(state_)),
+      worker(std::move(worker_))
+    {
+      // Do nothing
+    }
+
+    clock_type::time_point now() const override
+    {
+      return clock_type::now();
+    }
+
+    void schedule(const rxcpp::schedulers::schedulable& scbl) const override
+    {
+      schedule(now(), scbl);
+    }
+
+    void schedule(
+      clock_type::time_point when,
+      const rxcpp::schedulers::schedulable& scbl) const override
+    {
+      if (!scbl.is_subscribed())
+        return;
+
+      if (const auto s = state.lock())
+        s->push(when, scbl, worker);
+    }
+
+    std::weak_ptr<State> state;
+    std::shared_ptr<WorkerState> worker;
+  };
+
+  struct ClassScheduler : public rxcpp::schedulers::scheduler_interface
+  {
+    ClassScheduler(
+      std::weak_ptr<State> state_,
+      JobPriority priority_,
+      std::optional<time_point> deadline_)
+    : state(std::move(state_)),
+      priority(priority_),
+      deadline(deadline_)
+    {
+      // Do nothing
+    }
+
+    clock_type::time_point now() const override
+    {
+      return clock_type::now();
+    }
+
+    rxcpp::schedulers::worker create_worker(
+      rxcpp::composite_subscription cs) const override
+    {
+      auto worker = std::make_shared<WorkerState>();
+      worker->priority = priority;
+      worker->deadline = deadline;
+      return rxcpp::schedulers::worker(
+        std::move(cs), std::make_shared<ClassWorker>(state, std::move(worker)));
+    }
+
+    std::weak_ptr<State> state;
+    JobPriority priority;
+    std::optional<time_point> deadline;
+  };
+
+  std::shared_ptr<State> _state;
+  std::vector<std::thread> _threads;
+};
+
+} // namespace rmf_rxcpp
+
+#endif // RMF_RXCPP__PRIORITYSCHEDULER_HPP
@@ -31,6 +31,20 @@ inline auto make_job(const std::shared_ptr<Action>& action)
   return detail::make_observable<T>(action);
 }
 
+/// Make a job that runs on the thread pool that is dedicated to path planning.
+/// Concurrent planning jobs progress in parallel with each other, but whenever
+/// the pool is busy, each step of a job waits behind the steps of jobs with a
+/// higher priority class or, within the same class, an earlier deadline.
+template<typename T, typename Action>
+inline auto make_planning_job(
+  const std::shared_ptr<Action>& action,
+  JobPriority priority = JobPriority::routine,
+  std::optional<PriorityScheduler::time_point> deadline = std::nullopt)
+{
+  return detail::make_observable_on<T>(
+    action, detail::get_planning_scheduler().get_scheduler(priority, deadline));
+}
+
 template<typename Job0, typename... Jobs>
 inline auto merge_jobs(const Job0& o0, Jobs&& ... os)
 {
@@ -46,6 +60,21 @@ inline auto make_job_from_action_list(const ActionsIterable& actions)
   return detail::make_merged_observable<typename Action::Result>(actions);
 }
 
+/// Same as make_job_from_action_list, but the jobs are run as planning jobs
+/// with the given priority and deadline.
+template<typename ActionsIterable>
+inline auto make_planning_job_from_action_list(
+  const ActionsIterable& actions,
+  JobPriority priority = JobPriority::routine,
+  std::optional<PriorityScheduler::time_point> deadline = std::nullopt)
+{
+  using Action =
+    typename std::iterator_traits<decltype(actions.begin())>::value_type::
+    element_type;
+  return detail::make_merged_observable_on<typename Action::Result>(
+    actions, detail::get_planning_scheduler().get_scheduler(priority, deadline));
+}
+
 struct subscription_guard
 {
   subscription_guard(rxcpp::subscription s = rxcpp::subscription())
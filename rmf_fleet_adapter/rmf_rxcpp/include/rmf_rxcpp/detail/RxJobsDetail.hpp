@@ -18,6 +18,8 @@
 #ifndef RMF_RXCPP__RXJOBSDETAIL_HPP
 #define RMF_RXCPP__RXJOBSDETAIL_HPP
 
+#include <rmf_rxcpp/JobObserver.hpp>
+#include <rmf_rxcpp/PriorityScheduler.hpp>
 #include <rxcpp/rx.hpp>
 
 namespace rmf_rxcpp {
@@ -35,10 +37,19 @@ void schedule_job(
   typename std::enable_if_t<IsAsyncAction<Action, Subscriber>::value>* = 0)
 {
   w.schedule(
-    [a, s, w](const auto&)
+    [a, s, w, queued = JobObserver::clock_type::now()](const auto&)
     {
+      const auto category = job_category<std::remove_cv_t<Action>>();
+      const auto start = JobObserver::clock_type::now();
+      if (category)
+        category->queued(start - queued);
+
       if (const auto action = a.lock())
+      {
         (*action)(s, w);
+        if (category)
+          category->executed(JobObserver::clock_type::now() - start);
+      }
     });
 }
 
@@ -50,10 +61,19 @@ void schedule_job(
   typename std::enable_if_t<!IsAsyncAction<Action, Subscriber>::value>* = 0)
 {
   w.schedule(
-    [a, s](const auto&)
+    [a, s, queued = JobObserver::clock_type::now()](const auto&)
     {
+      const auto category = job_category<std::remove_cv_t<Action>>();
+      const auto start = JobObserver::clock_type::now();
+      if (category)
+        category->queued(start - queued);
+
       if (const auto action = a.lock())
+      {
         (*action)(s);
+        if (category)
+          category->executed(JobObserver::clock_type::now() - start);
+      }
     });
 }
 
@@ -63,6 +83,16 @@ inline auto get_event_loop()
   return event_loop;
 }
 
+/// A separate thread pool reserved for path planning jobs, so that expensive
+/// planner steps do not queue up behind (or in front of) every other job in
+/// the process. Planning jobs on this pool are run according to their
+/// priority class instead of first-come first-serve.
+inline PriorityScheduler& get_planning_scheduler()
+{
+  static PriorityScheduler scheduler;
+  return scheduler;
+}
+
 /**
  * Creates an observable from a job, the observable runs the job in an event loop until it has
  * completed or cancelled. Each progress update on a job is queued at the back of the event loop
@@ -84,6 +114,21 @@ auto make_observable(const std::shared_ptr<Action>& action)
     });
 }
 
+/// Same as make_observable, but the job is run on the given event loop instead
+/// of the default one.
+template<typename T, typename Action>
+auto make_observable_on(
+  const std::shared_ptr<Action>& action,
+  const rxcpp::schedulers::scheduler& event_loop)
+{
+  return rxcpp::observable<>::create<T>(
+    [a = std::weak_ptr<Action>(action), event_loop](const auto& s)
+    {
+      auto worker = event_loop.create_worker();
+      detail::schedule_job(a, s, worker);
+    });
+}
+
 /// Alternative to make_observable that is unconcerned about memory leaks
 template<typename T, typename Action>
 auto make_leaky_observable(const std::shared_ptr<Action>& action)
@@ -110,6 +155,25 @@ auto make_merged_observable(const ActionsIterable& actions)
       }).merge(rxcpp::serialize_event_loop());
 }
 
+/// Same as make_merged_observable, but every job is run on the given scheduler
+/// instead of the default event loop.
+template<typename T, typename ActionsIterable>
+auto make_merged_observable_on(
+  const ActionsIterable& actions,
+  const rxcpp::schedulers::scheduler& scheduler)
+{
+  using Observable =
+    decltype(detail::make_observable_on<T>(*actions.begin(), scheduler));
+
+  return rxcpp::observable<>::create<Observable>(
+    [&actions, scheduler](const auto& s)
+    {
+      for (const auto& a : actions)
+        s.on_next(detail::make_observable_on<T>(a, scheduler));
+      s.on_completed();
+    }).merge(rxcpp::serialize_event_loop());
+}
+
 } // namespace detail
 } // namespace rmf_rxcpp
 
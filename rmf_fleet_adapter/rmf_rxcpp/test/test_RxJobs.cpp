@@ -19,6 +19,15 @@
 
 #include <rmf_rxcpp/RxJobs.hpp>
 
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 struct AsyncCounterAction
 {
   int counter = 0;
@@ -74,3 +83,188 @@ TEST_CASE("make group jobs", "[Jobs]")
     REQUIRE(a->call_count == 1);
   }
 }
+
+TEST_CASE("planning job", "[Jobs]")
+{
+  auto action = std::make_shared<AsyncCounterAction>();
+  auto j = rmf_rxcpp::make_planning_job<int>(action);
+  j.as_blocking().subscribe();
+  REQUIRE(action->counter == 10);
+}
+
+TEST_CASE("priority scheduler", "[Jobs]")
+{
+  using namespace std::chrono_literals;
+
+  // A single thread makes the dispatch order deterministic
+  rmf_rxcpp::PriorityScheduler scheduler(1);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::string> order;
+  bool blocker_released = false;
+
+  auto blocker = scheduler.get_scheduler(rmf_rxcpp::JobPriority::routine)
+    .create_worker();
+  blocker.schedule([&](const auto&)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return blocker_released; });
+    });
+
+  const auto record = [&](const std::string& name)
+    {
+      return [&, name](const auto&)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          order.push_back(name);
+          cv.notify_all();
+        };
+    };
+
+  const auto now = std::chrono::steady_clock::now();
+  auto background = scheduler.get_scheduler(
+    rmf_rxcpp::JobPriority::background).create_worker();
+  auto late = scheduler.get_scheduler(
+    rmf_rxcpp::JobPriority::negotiation, now + 10s).create_worker();
+  auto early = scheduler.get_scheduler(
+    rmf_rxcpp::JobPriority::negotiation, now + 1s).create_worker();
+  auto emergency = scheduler.get_scheduler(
+    rmf_rxcpp::JobPriority::emergency).create_worker();
+
+  background.schedule(record("background"));
+  late.schedule(record("late"));
+  early.schedule(record("early"));
+  emergency.schedule(record("emergency"));
+
+  // Give the scheduler time to queue everything up behind the blocker
+  std::this_thread::sleep_for(10ms);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    blocker_released = true;
+  }
+  cv.notify_all();
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE(cv.wait_for(lock, 5s, [&]() { return order.size() == 4; }));
+  }
+
+  CHECK(order == std::vector<std::string>{
+      "emergency", "early", "late", "background"});
+}
+
+TEST_CASE("prioritized planning job", "[Jobs]")
+{
+  auto action = std::make_shared<AsyncCounterAction>();
+  auto j = rmf_rxcpp::make_planning_job<int>(
+    action, rmf_rxcpp::JobPriority::emergency);
+  j.as_blocking().subscribe();
+  REQUIRE(action->counter == 10);
+}
+
+TEST_CASE("make group planning jobs", "[Jobs]")
+{
+  std::vector<std::shared_ptr<DummyAction>> actions{
+    std::make_shared<DummyAction>(),
+    std::make_shared<DummyAction>()
+  };
+  auto j = rmf_rxcpp::make_planning_job_from_action_list(
+    actions, rmf_rxcpp::JobPriority::negotiation);
+  j.as_blocking().subscribe();
+  for (const auto& a : actions)
+  {
+    REQUIRE(a->call_count == 1);
+  }
+}
+
+struct CategorizedAction
+{
+  static constexpr const char* job_category = "test_categorized";
+
+  template<typename Subscriber>
+  void operator()(const Subscriber& s)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    s.on_next(0);
+    s.on_completed();
+  }
+};
+
+struct CountingObserver : public rmf_rxcpp::JobObserver
+{
+  struct Counts : public rmf_rxcpp::JobObserver::Category
+  {
+    std::atomic<std::size_t> queued_count{0};
+    std::atomic<std::size_t> executed_count{0};
+    std::atomic<int64_t> min_execution_ns{std::numeric_limits<int64_t>::max()};
+
+    void queued(clock_type::duration) final
+    {
+      ++queued_count;
+    }
+
+    void executed(clock_type::duration time) final
+    {
+      ++executed_count;
+      const int64_t ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+      int64_t current = min_execution_ns.load();
+      while (ns < current
+        && !min_execution_ns.compare_exchange_weak(current, ns))
+      {
+        // Keep trying
+      }
+    }
+  };
+
+  Counts& category(const std::string& name) final
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return categories[name];
+  }
+
+  std::mutex mutex;
+  std::map<std::string, Counts> categories;
+};
+
+TEST_CASE("job observer", "[Jobs]")
+{
+  static CountingObserver observer;
+  REQUIRE(rmf_rxcpp::set_job_observer(observer));
+
+  // Only the first observer is used
+  CountingObserver other;
+  CHECK_FALSE(rmf_rxcpp::set_job_observer(other));
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    auto action = std::make_shared<CategorizedAction>();
+    rmf_rxcpp::make_job<int>(action).as_blocking().subscribe();
+  }
+
+  // The execution time of a job is reported after the job returns, which can
+  // be just after its subscriber hears that it completed.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  auto& counts = observer.category("test_categorized");
+  CHECK(counts.queued_count == 3);
+  CHECK(counts.executed_count == 3);
+  CHECK(counts.min_execution_ns >= 1000000);
+  CHECK(other.categories.empty());
+
+  // Planning jobs also report to the category of their priority class
+  auto planning = std::make_shared<AsyncCounterAction>();
+  rmf_rxcpp::make_planning_job<int>(
+    planning, rmf_rxcpp::JobPriority::emergency).as_blocking().subscribe();
+  REQUIRE(planning->counter == 10);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  auto& emergency = observer.category(
+    rmf_rxcpp::job_category_name(rmf_rxcpp::JobPriority::emergency));
+  CHECK(emergency.queued_count >= 10);
+  CHECK(emergency.executed_count >= 10);
+  CHECK(observer.category(
+      rmf_rxcpp::job_category_name(rmf_rxcpp::JobPriority::background))
+    .queued_count == 0);
+}
@@ -1337,6 +1337,18 @@ std::shared_ptr<Connections> make_fleet(
         *node, "delay_threshold", 10.0));
   }
 
+  if (node->declare_parameter<bool>("warm_planner_caches", false))
+  {
+    const std::string cache_file =
+      node->declare_parameter<std::string>("planner_cache_file", "");
+
+    std::optional<std::string> cache_file_opt = std::nullopt;
+    if (!cache_file.empty())
+      cache_file_opt = cache_file;
+
+    connections->fleet->warm_planner_caches({}, cache_file_opt);
+  }
+
   connections->path_request_pub = node->create_publisher<
     rmf_fleet_msgs::msg::PathRequest>(
     rmf_fleet_adapter::PathRequestTopicName, rclcpp::SystemDefaultsQoS());
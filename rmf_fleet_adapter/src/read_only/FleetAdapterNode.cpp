@@ -24,6 +24,7 @@
 #include <rmf_traffic_ros2/StandardNames.hpp>
 #include <rmf_traffic_ros2/Time.hpp>
 #include <rmf_traffic_ros2/Trajectory.hpp>
+#include <rmf_traffic_ros2/schedule/RouteBounds.hpp>
 
 #include <rmf_fleet_adapter/StandardNames.hpp>
 
@@ -117,6 +118,14 @@ FleetAdapterNode::ScheduleEntry::ScheduleEntry(
 
           const auto proposals = table->base_proposals();
           const auto& profile = this->schedule->description().profile();
+
+          // Bound our routes once so that most of the proposed routes can be
+          // ruled out without a full conflict check.
+          std::vector<rmf_traffic_ros2::schedule::RouteBounds> bounds;
+          bounds.reserve(itinerary.size());
+          for (const auto& route : itinerary)
+            bounds.emplace_back(profile, route);
+
           for (const auto& p : proposals)
           {
             const auto other_participant =
@@ -135,9 +144,13 @@ FleetAdapterNode::ScheduleEntry::ScheduleEntry(
             const auto& other_profile = other_participant->profile();
             for (const auto& other_route : p.itinerary)
             {
-              for (const auto& route : itinerary)
+              const rmf_traffic_ros2::schedule::RouteBounds other_bounds(
+                other_profile, other_route);
+
+              for (std::size_t i = 0; i < itinerary.size(); ++i)
               {
-                if (route.map() != other_route.map())
+                const auto& route = itinerary[i];
+                if (!bounds[i].might_conflict(other_bounds))
                   continue;
 
                 if (rmf_traffic::DetectConflict::between(
@@ -203,18 +216,56 @@ void FleetAdapterNode::fleet_state_update(FleetState::UniquePtr state)
   }
 }
 
+//==============================================================================
+namespace {
+std::vector<std::size_t> find_arrivals(
+  const rmf_traffic::Trajectory& trajectory,
+  const std::vector<rmf_fleet_msgs::msg::Location>& path)
+{
+  // The route begins at the robot's current location, and the interpolation
+  // may add waypoints between the path locations to turn in place, so we scan
+  // forward for the first waypoint that lands on each location. A location
+  // that does not get its own waypoint shares the previous arrival.
+  std::vector<std::size_t> arrivals;
+  arrivals.reserve(path.size());
+  std::size_t cursor = 0;
+  for (const auto& location : path)
+  {
+    const Eigen::Vector2d p{location.x, location.y};
+    for (std::size_t i = cursor; i < trajectory.size(); ++i)
+    {
+      // TODO(MXG): Make this threshold configurable
+      if ((trajectory[i].position().block<2, 1>(0, 0) - p).norm() < 1e-3)
+      {
+        cursor = i;
+        break;
+      }
+    }
+
+    arrivals.push_back(cursor);
+  }
+
+  return arrivals;
+}
+} // anonymous namespace
+
 //==============================================================================
 void FleetAdapterNode::push_route(
   const RobotState& state,
   const ScheduleEntries::iterator& it)
 {
-  it->second->path.clear();
+  auto& entry = *it->second;
+  entry.path.clear();
   for (const auto& location : state.path)
-    it->second->path.push_back(location);
+    entry.path.push_back(location);
+
+  entry.cumulative_delay = std::chrono::seconds(0);
+  entry.route = make_route(state, _traits, entry.sitting);
+  entry.schedule->push_routes({*entry.route});
 
-  it->second->cumulative_delay = std::chrono::seconds(0);
-  it->second->route = make_route(state, _traits, it->second->sitting);
-  it->second->schedule->push_routes({*it->second->route});
+  entry.plan_id = entry.schedule->participant().current_plan_id();
+  entry.arrivals = find_arrivals(entry.route->trajectory(), entry.path);
+  entry.reached = 0;
 }
 
 //==============================================================================
@@ -271,12 +322,22 @@ bool FleetAdapterNode::handle_delay(
       return false;
   }
 
-  entry.path.clear();
-  for (const auto& location : state.path)
-    entry.path.push_back(location);
+  // The remembered path is the one that the scheduled route was made from, so
+  // the robot has made it past every location that is no longer in its path.
+  const std::size_t passed = entry.path.size() - state.path.size();
+  const auto current_time = rmf_traffic_ros2::convert(state.location.t);
 
-  bool sitting = false;
-  auto new_trajectory = make_trajectory(state, _traits, sitting);
+  // Only the leg that the robot is currently on needs to be interpolated. The
+  // rest of the route would come out the same as what is already scheduled.
+  rmf_traffic::Trajectory leg;
+  if (!state.path.empty())
+  {
+    leg = make_trajectory(
+      current_time, {state.location, state.path.front()}, _traits);
+  }
+
+  // The robot is sitting if it has nowhere left to go
+  const bool sitting = leg.size() < 2 && state.path.size() <= 1;
 
   if (entry.sitting && sitting)
   {
@@ -300,7 +361,6 @@ bool FleetAdapterNode::handle_delay(
 
     // Every 3 seconds we'll extend the finish time for the trajectory
     // TODO(MXG): Make these parameters configurable
-    const auto current_time = rmf_traffic_ros2::convert(state.location.t);
     const auto next_finish_time = current_time + std::chrono::seconds(10);
     const auto delay = next_finish_time -
       *entry.route->trajectory().finish_time();
@@ -316,84 +376,51 @@ bool FleetAdapterNode::handle_delay(
 
     return true;
   }
-  else if (sitting)
+  else if (sitting || entry.sitting)
   {
-    // The new robot state indicates the robot should be sitting, but it is not
-    // already considered to be sitting. Therefore we will kick it back to
-    // push_trajectory() to put a new sitting trajectory on the schedule.
+    // The robot has either stopped or started moving since its route was
+    // pushed, so its route needs to be replaced.
     return false;
   }
 
-  const auto time_difference =
-    *new_trajectory.finish_time() - *entry.route->trajectory().finish_time();
+  auto& trajectory = entry.route->trajectory();
 
-//  std::cout << "Calculating delay: ["
-//            << rmf_traffic::time::to_seconds(time_difference) << "]" << std::endl;
+  if (passed > entry.reached)
+  {
+    entry.schedule->participant().reached(
+      entry.plan_id, 0, entry.arrivals[passed-1]);
+    entry.reached = passed;
+  }
+
+  // Compare when the robot should now arrive at the next location of its path
+  // against when the schedule expects it to arrive there. Every later arrival
+  // will be off by the same amount.
+  const auto expected_arrival = leg.size() < 2 ?
+    current_time : *leg.finish_time();
+  const auto scheduled_arrival = trajectory[entry.arrivals[passed]].time();
+  const auto time_difference = expected_arrival - scheduled_arrival;
 
   if (std::abs(time_difference.count()) < _delay_threshold.count())
   {
-    // The difference between the current finishing time estimate and the
-    // previous finishing time estimate is less than the threshold for reporting
-    // a delay. This implies that the difference in the estimate may be an
-    // artifact of the estimating and not indicative of a real delay.
+    // The difference between the current arrival time estimate and the
+    // scheduled arrival time is less than the threshold for reporting a delay.
+    // This implies that the difference in the estimate may be an artifact of
+    // the estimating and not indicative of a real delay.
     //
     // We will keep the current trajectory as it is in the schedule to avoid
     // needless schedule noise.
     return true;
   }
 
-  entry.cumulative_delay += time_difference;
-  if (entry.cumulative_delay >= MaxCumulativeDelay)
+  // A delay pushes back the whole route. If that would push its start past
+  // the current time then the schedule would lose track of where the robot is
+  // right now, so we replace the route instead.
+  if (current_time < *trajectory.start_time() + time_difference)
     return false;
 
-  // There was a considerable difference between the scheduled finishing time
-  // estimate and the latest finishing time estimate, so we will notify the
-  // schedule of a delay.
-  const auto from_time =
-    rmf_traffic_ros2::convert(state.location.t) - time_difference;
-
-  const auto t_it = entry.route->trajectory().find(from_time);
-  if (t_it == entry.route->trajectory().end())
-  {
-    const auto t_start = *entry.route->trajectory().start_time();
-    if (from_time <= t_start)
-    {
-      // This is okay. It just means we will push back the entire trajectory
-      // in the schedule.
-      entry.route->trajectory().front().adjust_times(time_difference);
-    }
-    else
-    {
-      // I can't think of a situation where this could happen, so let's report
-      // it as an error and debug it later.
-      const auto t_start =
-        entry.route->trajectory().start_time()->time_since_epoch().count();
-      const auto t_finish =
-        entry.route->trajectory().finish_time()->time_since_epoch().count();
-
-      RCLCPP_ERROR(
-        get_logger(),
-        "BUG: Robot [%s] has a delay which starts from [%s], but "
-        "we cannot identify where its schedule should be pushed back ["
-        "%s --> %s]. This should not happen; please report this.",
-        state.name.c_str(),
-        std::to_string(from_time.time_since_epoch().count()).c_str(),
-        std::to_string(t_start).c_str(),
-        std::to_string(t_finish).c_str());
-
-      // We'll return false so that the old trajectory can be replaced with the
-      // new one, and hopefully everything keeps working okay.
-      return false;
-    }
-  }
-  else
-  {
-    if (time_difference.count() < 0)
-      entry.route->trajectory().begin()->adjust_times(time_difference);
-    else
-      t_it->adjust_times(time_difference);
-  }
-
+  // There was a considerable difference between the scheduled arrival time
+  // and the latest estimate, so we will notify the schedule of a delay.
+  trajectory.front().adjust_times(time_difference);
   entry.schedule->push_delay(time_difference);
 
   // Return true to indicate that the delay has been handled.
@@ -77,6 +77,14 @@ private:
     rmf_traffic::Duration cumulative_delay = rmf_traffic::Duration(0);
     bool sitting = false;
 
+    // The plan that the route was submitted under, and the index of the route
+    // waypoint where the robot arrives at each location along its path
+    rmf_traffic::PlanId plan_id = 0;
+    std::vector<std::size_t> arrivals;
+
+    // The number of path locations that have been reported as reached
+    std::size_t reached = 0;
+
     ScheduleEntry(
       FleetAdapterNode* node,
       std::string name,
@@ -101,6 +109,12 @@ private:
     const RobotState& state,
     const ScheduleEntries::iterator& it);
 
+  /// Keep the schedule up to date with the robot's progress along the route
+  /// that it already has on the schedule, using only delay and reached
+  /// updates.
+  ///
+  /// \return false if the robot's progress cannot be described that way, and
+  /// a whole new route needs to be pushed.
   bool handle_delay(
     const RobotState& state,
     const ScheduleEntries::iterator& it);
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__JOBMETRICS_HPP
+#define SRC__RMF_FLEET_ADAPTER__JOBMETRICS_HPP
+
+#include <rmf_rxcpp/JobObserver.hpp>
+#include <rmf_traffic_ros2/Metrics.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+
+//==============================================================================
+/// Histograms of the queueing delay and execution time of the fleet adapter's
+/// jobs, sorted into named categories.
+class JobMetrics : public rmf_rxcpp::JobObserver
+{
+public:
+
+  using Histogram = rmf_traffic_ros2::Histogram;
+  using Summary = Histogram::Summary;
+  using Timer = Histogram::Timer;
+
+  //============================================================================
+  /// The metrics of one category of jobs
+  struct Category : public rmf_rxcpp::JobObserver::Category
+  {
+    /// Time between a job being scheduled and a thread starting it
+    Histogram queue_delay;
+
+    /// Time that a thread spent running the job
+    Histogram execution_time;
+
+    /// Jobs of this category that currently exist. This is only tracked for
+    /// categories that use JobMetrics::Alive.
+    std::atomic<int64_t> alive{0};
+    std::atomic_bool tracks_alive{false};
+
+    void queued(clock_type::duration delay) final
+    {
+      queue_delay.record(delay);
+    }
+
+    void executed(clock_type::duration time) final
+    {
+      execution_time.record(time);
+    }
+  };
+
+  /// A summary of one category for one window
+  struct CategorySummary
+  {
+    std::string name;
+    Summary queue_delay;
+    Summary execution_time;
+    std::optional<int64_t> alive;
+  };
+
+  //============================================================================
+  /// Counts as one alive job of a category for as long as it exists.
+  class Alive
+  {
+  public:
+    explicit Alive(Category& category)
+    : _category(&category)
+    {
+      _category->tracks_alive.store(true, std::memory_order_relaxed);
+      _category->alive.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~Alive()
+    {
+      _category->alive.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    Alive(const Alive&) = delete;
+    Alive& operator=(const Alive&) = delete;
+
+  private:
+    Category* _category;
+  };
+
+  /// Get the metrics of a category, creating it if it does not exist yet. The
+  /// reference remains valid for the lifetime of this JobMetrics, so hot paths
+  /// should look up their category once and hold onto it.
+  Category& category(const std::string& name) final
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& entry = _categories[name];
+    if (!entry)
+      entry = std::make_unique<Category>();
+
+    return *entry;
+  }
+
+  /// Summarize every category since the last call and start a new window.
+  std::vector<CategorySummary> take()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<CategorySummary> summaries;
+    summaries.reserve(_categories.size());
+    for (const auto& [name, category] : _categories)
+    {
+      CategorySummary summary;
+      summary.name = name;
+      summary.queue_delay = category->queue_delay.take();
+      summary.execution_time = category->execution_time.take();
+      if (category->tracks_alive.load(std::memory_order_relaxed))
+        summary.alive = category->alive.load(std::memory_order_relaxed);
+
+      summaries.emplace_back(std::move(summary));
+    }
+
+    return summaries;
+  }
+
+private:
+  std::mutex _mutex;
+  std::map<std::string, std::unique_ptr<Category>> _categories;
+};
+
+//==============================================================================
+/// The job metrics that are shared by the whole process. The first call makes
+/// them the observer of every rmf_rxcpp job.
+inline JobMetrics& get_job_metrics()
+{
+  static JobMetrics metrics;
+  static const bool observing = rmf_rxcpp::set_job_observer(metrics);
+  (void)(observing);
+  return metrics;
+}
+
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__JOBMETRICS_HPP
@@ -45,6 +45,8 @@ void Negotiator::respond(
     return;
   }
 
+  service->track_robot(_context->name());
+  service->use_cache(_cache);
   auto negotiate_sub =
     rmf_rxcpp::make_job<services::Negotiate::Result>(service)
     .observe_on(rxcpp::identity_same_worker(_context->worker()))
@@ -69,8 +71,9 @@ void Negotiator::respond(
 
   using namespace std::chrono_literals;
   const auto wait_duration = 2s + table_viewer->sequence().back().version * 10s;
-  auto negotiation_timer = _context->node()->try_create_wall_timer(
+  auto negotiation_timer = _context->node()->schedule_timer(
     wait_duration,
+    _context->worker(),
     [s = service->weak_from_this()]
     {
       if (const auto service = s.lock())
@@ -56,7 +56,7 @@ private:
   struct NegotiationManagers
   {
     rmf_rxcpp::subscription_guard subscription;
-    rclcpp::TimerBase::SharedPtr timer;
+    agv::TimerWheel::TimerPtr timer;
   };
   using NegotiateServiceMap =
     std::unordered_map<NegotiatePtr, NegotiationManagers>;
@@ -65,6 +65,10 @@ private:
   agv::RobotContextPtr _context;
   std::shared_ptr<void> _license;
   Respond _respond;
+
+  // Lets the services for different tables reuse each other's plans
+  std::shared_ptr<services::NegotiationCache> _cache =
+    std::make_shared<services::NegotiationCache>();
 };
 
 } // namespace rmf_fleet_adapter
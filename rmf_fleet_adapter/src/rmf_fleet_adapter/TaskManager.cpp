@@ -27,6 +27,7 @@
 
 #include <rmf_traffic/agv/Planner.hpp>
 
+#include "JobMetrics.hpp"
 #include "agv/internal_FleetUpdateHandle.hpp"
 #include "tasks/Clean.hpp"
 #include "tasks/ChargeBattery.hpp"
@@ -37,36 +38,39 @@
 #include "events/EmergencyPullover.hpp"
 
 #include <rmf_api_msgs/schemas/task_state_update.hpp>
-#include <rmf_api_msgs/schemas/task_state.hpp>
 #include <rmf_api_msgs/schemas/task_log_update.hpp>
-#include <rmf_api_msgs/schemas/task_log.hpp>
-#include <rmf_api_msgs/schemas/log_entry.hpp>
 #include <rmf_api_msgs/schemas/simple_response.hpp>
 #include <rmf_api_msgs/schemas/token_response.hpp>
 #include <rmf_api_msgs/schemas/cancel_task_request.hpp>
-#include <rmf_api_msgs/schemas/cancel_task_response.hpp>
 #include <rmf_api_msgs/schemas/kill_task_request.hpp>
-#include <rmf_api_msgs/schemas/kill_task_response.hpp>
 #include <rmf_api_msgs/schemas/interrupt_task_request.hpp>
-#include <rmf_api_msgs/schemas/interrupt_task_response.hpp>
 #include <rmf_api_msgs/schemas/resume_task_request.hpp>
-#include <rmf_api_msgs/schemas/resume_task_response.hpp>
 #include <rmf_api_msgs/schemas/rewind_task_request.hpp>
-#include <rmf_api_msgs/schemas/rewind_task_response.hpp>
 #include <rmf_api_msgs/schemas/robot_task_request.hpp>
-#include <rmf_api_msgs/schemas/dispatch_task_response.hpp>
-#include <rmf_api_msgs/schemas/task_state.hpp>
-#include <rmf_api_msgs/schemas/error.hpp>
 #include <rmf_api_msgs/schemas/robot_task_response.hpp>
 #include <rmf_api_msgs/schemas/skip_phase_request.hpp>
-#include <rmf_api_msgs/schemas/skip_phase_response.hpp>
-#include <rmf_api_msgs/schemas/task_request.hpp>
 #include <rmf_api_msgs/schemas/undo_skip_phase_request.hpp>
-#include <rmf_api_msgs/schemas/undo_skip_phase_response.hpp>
-#include <rmf_api_msgs/schemas/error.hpp>
 
 namespace rmf_fleet_adapter {
 
+namespace {
+//==============================================================================
+JobMetrics::Category& json_validation_metrics()
+{
+  static auto& category =
+    get_job_metrics().category("task_manager/json_validation");
+  return category;
+}
+
+//==============================================================================
+JobMetrics::Category& publish_metrics()
+{
+  static auto& category =
+    get_job_metrics().category("task_manager/publish");
+  return category;
+}
+} // anonymous namespace
+
 //==============================================================================
 TaskManagerPtr TaskManager::make(
   agv::RobotContextPtr context,
@@ -159,8 +163,9 @@ TaskManagerPtr TaskManager::make(
       }
     });
 
-  mgr->_task_timer = mgr->context()->node()->try_create_wall_timer(
+  mgr->_task_timer = mgr->context()->node()->schedule_timer(
     std::chrono::seconds(1),
+    mgr->_context->worker(),
     [w = mgr->weak_from_this()]()
     {
       if (auto mgr = w.lock())
@@ -169,8 +174,9 @@ TaskManagerPtr TaskManager::make(
       }
     });
 
-  mgr->_retreat_timer = mgr->context()->node()->try_create_wall_timer(
+  mgr->_retreat_timer = mgr->context()->node()->schedule_timer(
     std::chrono::seconds(10),
+    mgr->_context->worker(),
     [w = mgr->weak_from_this()]()
     {
       if (auto mgr = w.lock())
@@ -191,61 +197,30 @@ TaskManagerPtr TaskManager::make(
       mgr->_context->task_planner()->configuration().parameters());
   }
 
-  mgr->_update_timer = mgr->_context->node()->try_create_wall_timer(
+  mgr->_update_timer = mgr->_context->node()->schedule_timer(
     std::chrono::milliseconds(100),
+    mgr->_context->worker(),
     [w = mgr->weak_from_this()]()
     {
       if (const auto self = w.lock())
         self->_consider_publishing_updates();
     });
 
-  mgr->_task_request_api_sub = mgr->_context->node()->task_api_request()
-    .observe_on(rxcpp::identity_same_worker(mgr->_context->worker()))
-    .subscribe(
+  // The node parses each API request once and only hands us the ones that
+  // are about this robot or the tasks that we have claimed.
+  mgr->_task_api_recipient = mgr->_context->node()->task_api_router()
+    ->add_recipient(
+    mgr->_context->group(),
+    mgr->_context->name(),
+    mgr->_context->worker(),
     [w = mgr->weak_from_this()](
-      const rmf_task_msgs::msg::ApiRequest::SharedPtr& request)
+      const nlohmann::json& request,
+      const std::string& request_id)
     {
       if (const auto self = w.lock())
-        self->_handle_request(request->json_msg, request->request_id);
+        self->_handle_request(request, request_id);
     });
 
-  const std::vector<nlohmann::json> schemas = {
-    rmf_api_msgs::schemas::task_state,
-    rmf_api_msgs::schemas::task_log,
-    rmf_api_msgs::schemas::log_entry,
-    rmf_api_msgs::schemas::task_state_update,
-    rmf_api_msgs::schemas::task_log_update,
-    rmf_api_msgs::schemas::simple_response,
-    rmf_api_msgs::schemas::token_response,
-    rmf_api_msgs::schemas::cancel_task_request,
-    rmf_api_msgs::schemas::cancel_task_response,
-    rmf_api_msgs::schemas::kill_task_request,
-    rmf_api_msgs::schemas::kill_task_response,
-    rmf_api_msgs::schemas::interrupt_task_request,
-    rmf_api_msgs::schemas::interrupt_task_response,
-    rmf_api_msgs::schemas::resume_task_request,
-    rmf_api_msgs::schemas::resume_task_response,
-    rmf_api_msgs::schemas::rewind_task_request,
-    rmf_api_msgs::schemas::rewind_task_response,
-    rmf_api_msgs::schemas::robot_task_request,
-    rmf_api_msgs::schemas::dispatch_task_response,
-    rmf_api_msgs::schemas::task_state,
-    rmf_api_msgs::schemas::error,
-    rmf_api_msgs::schemas::robot_task_response,
-    rmf_api_msgs::schemas::skip_phase_request,
-    rmf_api_msgs::schemas::skip_phase_response,
-    rmf_api_msgs::schemas::task_request,
-    rmf_api_msgs::schemas::undo_skip_phase_request,
-    rmf_api_msgs::schemas::undo_skip_phase_response,
-    rmf_api_msgs::schemas::error
-  };
-
-  for (const auto& schema : schemas)
-  {
-    const auto json_uri = nlohmann::json_uri{schema["$id"]};
-    mgr->_schema_dictionary.insert({json_uri.url(), schema});
-  }
-
   mgr->_context->_set_task_manager(mgr);
 
   return mgr;
@@ -547,7 +522,8 @@ void TaskManager::ActiveTask::publish_task_state(TaskManager& mgr)
 
   static const auto task_update_validator =
     mgr._make_validator(rmf_api_msgs::schemas::task_state_update);
-  mgr._validate_and_publish_websocket(task_state_update, task_update_validator);
+  mgr._validate_and_publish_websocket(
+    task_state_update, *task_update_validator);
 
   auto task_log_update = nlohmann::json();
   task_log_update["type"] = "task_log_update";
@@ -555,7 +531,7 @@ void TaskManager::ActiveTask::publish_task_state(TaskManager& mgr)
 
   static const auto log_update_validator =
     mgr._make_validator(rmf_api_msgs::schemas::task_log_update);
-  mgr._validate_and_publish_websocket(task_log_update, log_update_validator);
+  mgr._validate_and_publish_websocket(task_log_update, *log_update_validator);
 }
 
 //==============================================================================
@@ -809,6 +785,7 @@ bool TaskManager::cancel_task_if_present(const std::string& task_id)
     if (it->request()->booking()->id() == task_id)
     {
       _queue.erase(it);
+      _task_api_recipient->release(task_id);
       return true;
     }
   }
@@ -906,7 +883,28 @@ void TaskManager::set_queue(
     {
       return;
     }
+    const auto previous_queue = std::move(_queue);
     _queue = assignments;
+
+    // Claim the new tasks before releasing the old ones so that requests
+    // about tasks that stay in the queue are always routed to us.
+    for (const auto& a : _queue)
+      _task_api_recipient->claim(a.request()->booking()->id());
+
+    for (const auto& a : previous_queue)
+    {
+      const auto& id = a.request()->booking()->id();
+      const auto still_queued = std::any_of(
+        _queue.begin(), _queue.end(),
+        [&id](const Assignment& b)
+        {
+          return b.request()->booking()->id() == id;
+        });
+
+      if (!still_queued)
+        _task_api_recipient->release(id);
+    }
+
     _publish_task_queue();
   }
 
@@ -947,14 +945,16 @@ TaskManager::RobotModeMsg TaskManager::robot_mode() const
 //==============================================================================
 std::vector<nlohmann::json> TaskManager::task_log_updates() const
 {
+  static const auto validator =
+    _make_validator(rmf_api_msgs::schemas::task_log_update);
+
   std::vector<nlohmann::json> logs;
   for (const auto& it : _task_logs)
   {
     nlohmann::json update_msg = _task_log_update_msg;
     update_msg["data"] = it.second;
     std::string error = "";
-    if (_validate_json(
-        update_msg, rmf_api_msgs::schemas::task_log_update, error))
+    if (_validate_json(update_msg, *validator, error))
     {
       logs.push_back(update_msg);
     }
@@ -1073,6 +1073,7 @@ nlohmann::json TaskManager::submit_direct_request(
     std::lock_guard<std::mutex> lock(_mutex);
     _direct_queue.insert(assignment);
   }
+  _task_api_recipient->claim(new_request->booking()->id());
 
   RCLCPP_INFO(
     _context->node()->get_logger(),
@@ -1292,6 +1293,7 @@ void TaskManager::_begin_next_task()
         "fleet adapter is incorrectly configured.",
         info.category.c_str(),
         assignment.request()->booking()->id().c_str());
+      _task_api_recipient->release(id);
 
       _context->worker().schedule(
         [w = weak_from_this()](const auto&)
@@ -1592,6 +1594,7 @@ void TaskManager::retreat_to_charger()
       std::lock_guard<std::mutex> lock(_mutex);
       _direct_queue.insert(assignment);
     }
+    _task_api_recipient->claim(charging_request->booking()->id());
 
     RCLCPP_INFO(
       _context->node()->get_logger(),
@@ -1662,22 +1665,6 @@ void TaskManager::_populate_task_summary(
   msg.state = task_summary_state;
 }
 
-//==============================================================================
-void TaskManager::_schema_loader(
-  const nlohmann::json_uri& id, nlohmann::json& value) const
-{
-  const auto it = _schema_dictionary.find(id.url());
-  if (it == _schema_dictionary.end())
-  {
-    RCLCPP_ERROR(
-      _context->node()->get_logger(),
-      "[TaskManager] url: %s not found in schema dictionary", id.url().c_str());
-    return;
-  }
-
-  value = it->second;
-}
-
 //==============================================================================
 void TaskManager::_validate_and_publish_websocket(
   const nlohmann::json& msg,
@@ -1706,6 +1693,8 @@ void TaskManager::_validate_and_publish_websocket(
       _context->name().c_str());
     return;
   }
+
+  const JobMetrics::Timer timer(publish_metrics().execution_time);
   client->publish(msg);
 }
 
@@ -1726,6 +1715,7 @@ void TaskManager::_validate_and_publish_api_response(
     return;
   }
 
+  const JobMetrics::Timer timer(publish_metrics().execution_time);
   _context->node()->task_api_response()->publish(
     rmf_task_msgs::build<rmf_task_msgs::msg::ApiResponse>()
     .type(rmf_task_msgs::msg::ApiResponse::TYPE_RESPONDING)
@@ -1801,7 +1791,7 @@ rmf_task::State TaskManager::_publish_pending_task(
   static const auto validator =
     _make_validator(rmf_api_msgs::schemas::task_state_update);
 
-  _validate_and_publish_websocket(task_state_update, validator);
+  _validate_and_publish_websocket(task_state_update, *validator);
 
   return pending.finish_state();
 }
@@ -1852,7 +1842,7 @@ void TaskManager::_publish_canceled_pending_task(
   static const auto validator =
     _make_validator(rmf_api_msgs::schemas::task_state_update);
 
-  _validate_and_publish_websocket(task_state_update, validator);
+  _validate_and_publish_websocket(task_state_update, *validator);
 }
 
 //==============================================================================
@@ -1866,6 +1856,7 @@ bool TaskManager::_cancel_task_from_dispatch_queue(
     {
       _publish_canceled_pending_task(*it, labels);
       _queue.erase(it);
+      _task_api_recipient->release(task_id);
       return true;
     }
   }
@@ -1883,6 +1874,7 @@ bool TaskManager::_cancel_task_from_direct_queue(
     {
       _publish_canceled_pending_task(it->assignment, labels);
       _direct_queue.erase(it);
+      _task_api_recipient->release(task_id);
       return true;
     }
   }
@@ -1895,6 +1887,8 @@ bool TaskManager::_validate_json(
   const nlohmann::json_schema::json_validator& validator,
   std::string& error) const
 {
+  const JobMetrics::Timer timer(
+    json_validation_metrics().execution_time);
   try
   {
     validator.validate(json);
@@ -1932,7 +1926,7 @@ void TaskManager::_send_simple_success_response(const std::string& request_id)
     _make_validator(rmf_api_msgs::schemas::simple_response);
 
   _validate_and_publish_api_response(
-    response, simple_response_validator, request_id);
+    response, *simple_response_validator, request_id);
 }
 
 //==============================================================================
@@ -1948,23 +1942,14 @@ void TaskManager::_send_token_success_response(
     _make_validator(rmf_api_msgs::schemas::token_response);
 
   _validate_and_publish_api_response(
-    response, token_response_validator, request_id);
+    response, *token_response_validator, request_id);
 }
 
 //==============================================================================
-nlohmann::json_schema::json_validator TaskManager::_make_validator(
-  const nlohmann::json& schema) const
+auto TaskManager::_make_validator(const nlohmann::json& schema)
+-> rmf_task_ros2::SchemaRegistry::ConstValidatorPtr
 {
-  return nlohmann::json_schema::json_validator(
-    schema,
-    [w = weak_from_this()](const nlohmann::json_uri& id,
-    nlohmann::json& value)
-    {
-      const auto self = w.lock();
-      if (!self)
-        return;
-      self->_schema_loader(id, value);
-    });
+  return rmf_task_ros2::SchemaRegistry::global()->validator(schema);
 }
 
 //==============================================================================
@@ -1979,7 +1964,7 @@ void TaskManager::_send_simple_error_response(
 
   _validate_and_publish_api_response(
     _make_error_response(code, std::move(category), std::move(detail)),
-    error_validator,
+    *error_validator,
     request_id);
 }
 
@@ -2090,6 +2075,7 @@ std::function<void()> TaskManager::_task_finished(std::string id)
       // Publish the final state of the task before destructing it
       self->_publish_task_state();
       self->_active_task = ActiveTask();
+      self->_task_api_recipient->release(id);
 
       self->_context->worker().schedule(
         [w = self->weak_from_this()](const auto&)
@@ -2102,23 +2088,9 @@ std::function<void()> TaskManager::_task_finished(std::string id)
 
 //==============================================================================
 void TaskManager::_handle_request(
-  const std::string& request_msg,
+  const nlohmann::json& request_json,
   const std::string& request_id)
 {
-  nlohmann::json request_json;
-  try
-  {
-    request_json = nlohmann::json::parse(request_msg);
-  }
-  catch (const std::exception& e)
-  {
-    RCLCPP_ERROR(
-      _context->node()->get_logger(),
-      "Error parsing json_msg: %s",
-      e.what());
-    return;
-  }
-
   const auto type_it = request_json.find("type");
   if (type_it == request_json.end())
     return;
@@ -2168,7 +2140,7 @@ void TaskManager::_handle_direct_request(
   static const auto response_validator =
     _make_validator(rmf_api_msgs::schemas::robot_task_response);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& robot = request_json["robot"].get<std::string>();
@@ -2181,7 +2153,7 @@ void TaskManager::_handle_direct_request(
 
   const nlohmann::json& request = request_json["request"];
   const auto response = submit_direct_request(request, request_id);
-  _validate_and_publish_api_response(response, response_validator, request_id);
+  _validate_and_publish_api_response(response, *response_validator, request_id);
 }
 
 //==============================================================================
@@ -2192,7 +2164,7 @@ void TaskManager::_handle_cancel_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::cancel_task_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["task_id"].get<std::string>();
@@ -2208,7 +2180,7 @@ void TaskManager::_handle_kill_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::kill_task_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["task_id"].get<std::string>();
@@ -2224,7 +2196,7 @@ void TaskManager::_handle_interrupt_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::interrupt_task_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["task_id"].get<std::string>();
@@ -2249,7 +2221,7 @@ void TaskManager::_handle_resume_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::resume_task_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["for_task"].get<std::string>();
@@ -2289,7 +2261,7 @@ void TaskManager::_handle_rewind_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::rewind_task_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["task_id"].get<std::string>();
@@ -2312,7 +2284,7 @@ void TaskManager::_handle_skip_phase_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::skip_phase_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["task_id"].get<std::string>();
@@ -2339,7 +2311,7 @@ void TaskManager::_handle_undo_skip_phase_request(
   static const auto request_validator =
     _make_validator(rmf_api_msgs::schemas::undo_skip_phase_request);
 
-  if (!_validate_request_message(request_json, request_validator, request_id))
+  if (!_validate_request_message(request_json, *request_validator, request_id))
     return;
 
   const auto& task_id = request_json["for_task"];
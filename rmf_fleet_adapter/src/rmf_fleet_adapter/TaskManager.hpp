@@ -22,6 +22,8 @@
 #include "agv/RobotContext.hpp"
 #include <rmf_websocket/BroadcastClient.hpp>
 
+#include <rmf_task_ros2/SchemaRegistry.hpp>
+
 #include <rmf_traffic/agv/Planner.hpp>
 
 #include <rmf_task/TaskPlanner.hpp>
@@ -333,9 +335,9 @@ private:
   // manager so that modifications of shared data only happen on designated
   // rxcpp worker
   mutable std::mutex _mutex;
-  rclcpp::TimerBase::SharedPtr _task_timer;
-  rclcpp::TimerBase::SharedPtr _retreat_timer;
-  rclcpp::TimerBase::SharedPtr _update_timer;
+  agv::TimerWheel::TimerPtr _task_timer;
+  agv::TimerWheel::TimerPtr _retreat_timer;
+  agv::TimerWheel::TimerPtr _update_timer;
   bool _task_state_update_available = true;
   std::chrono::steady_clock::time_point _last_update_time;
 
@@ -347,11 +349,8 @@ private:
   // retreat. TODO(YV): Expose the TaskPlanner's TravelEstimator.
   std::shared_ptr<rmf_task::TravelEstimator> _travel_estimator;
 
-  // Map schema url to schema for validator.
-  // TODO: Get this and loader from FleetUpdateHandle
-  std::unordered_map<std::string, nlohmann::json> _schema_dictionary = {};
-
-  rmf_rxcpp::subscription_guard _task_request_api_sub;
+  // Task API requests about this robot and the tasks in its queues
+  agv::TaskApiRouter::RecipientPtr _task_api_recipient;
 
   // Constant jsons with validated schemas for internal use
   // TODO(YV): Replace these with codegen tools
@@ -439,10 +438,6 @@ private:
     const std::string& task_id,
     const std::vector<std::string>& labels);
 
-  /// Schema loader for validating jsons
-  void _schema_loader(
-    const nlohmann::json_uri& id, nlohmann::json& value) const;
-
   /// Returns true if json is valid.
   // TODO: Move this into a utils?
   bool _validate_json(
@@ -466,9 +461,10 @@ private:
     std::string token,
     const std::string& request_id);
 
-  /// Make a validator for the given schema
-  nlohmann::json_schema::json_validator _make_validator(
-    const nlohmann::json& schema) const;
+  /// Get the validator for the given schema from the registry that is shared
+  /// by the whole process
+  static rmf_task_ros2::SchemaRegistry::ConstValidatorPtr _make_validator(
+    const nlohmann::json& schema);
 
   void _send_simple_error_response(
     const std::string& request_id,
@@ -522,7 +518,7 @@ private:
     TaskSummaryMsg& msg);
 
   void _handle_request(
-    const std::string& request_msg,
+    const nlohmann::json& request_json,
     const std::string& request_id);
 
   void _handle_direct_request(
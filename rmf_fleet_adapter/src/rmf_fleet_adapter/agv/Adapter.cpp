@@ -27,6 +27,7 @@
 #include <rmf_traffic_ros2/blockade/Writer.hpp>
 
 #include "internal_EasyTrafficLight.hpp"
+#include "internal_EasyTrafficLightGroup.hpp"
 
 #include "../load_param.hpp"
 
@@ -332,6 +333,138 @@ void Adapter::add_easy_traffic_light(
     });
 }
 
+//==============================================================================
+void Adapter::add_easy_traffic_light_group(
+  std::function<void(EasyTrafficLightGroupPtr)> handle_callback,
+  const std::string& fleet_name,
+  const std::vector<std::string>& robot_names,
+  rmf_traffic::agv::VehicleTraits traits,
+  EasyTrafficLightGroup::CommandCallback command_callback,
+  EasyTrafficLightGroup::DeadlockCallback deadlock_callback)
+{
+  if (!handle_callback)
+  {
+    RCLCPP_ERROR(
+      _pimpl->node->get_logger(),
+      "Adapter::add_easy_traffic_light_group(~) was not provided a callback "
+      "to receive the EasyTrafficLightGroup for the robots owned by [%s]. "
+      "This means the traffic light controllers will not be able to work "
+      "since you cannot provide information about where the robots are going. "
+      "We will not create the requested traffic light controllers.",
+      fleet_name.c_str());
+    return;
+  }
+
+  if (!command_callback)
+  {
+    RCLCPP_ERROR(
+      _pimpl->node->get_logger(),
+      "Adapter::add_easy_traffic_light_group(~) was not provided a "
+      "command_callback value for the robots owned by [%s]. This means the "
+      "easy traffic light controllers will not be able to work correctly "
+      "since we cannot command on-demand pauses or resumes. We will not create "
+      "the requested easy traffic light controllers.",
+      fleet_name.c_str());
+    return;
+  }
+
+  if (robot_names.empty())
+  {
+    RCLCPP_ERROR(
+      _pimpl->node->get_logger(),
+      "Adapter::add_easy_traffic_light_group(~) was not provided any robot "
+      "names for the fleet [%s]. We will not create an empty group.",
+      fleet_name.c_str());
+    return;
+  }
+
+  // The participants get registered independently, so we collect them here
+  // until all of them are ready, and then make the whole group at once.
+  struct Registration
+  {
+    std::mutex mutex;
+    std::vector<std::optional<rmf_traffic::schedule::Participant>> itineraries;
+    std::size_t remaining;
+    std::function<void(std::vector<rmf_traffic::schedule::Participant>)> ready;
+  };
+
+  const auto profile = traits.profile();
+  auto registration = std::make_shared<Registration>();
+  registration->itineraries.resize(robot_names.size());
+  registration->remaining = robot_names.size();
+  registration->ready =
+    [mutex = &_pimpl->_traffic_light_init_mutex,
+    traits = std::move(traits),
+    command_callback = std::move(command_callback),
+    deadlock_callback = std::move(deadlock_callback),
+    handle_callback = std::move(handle_callback),
+    blockade_writer = _pimpl->blockade_writer,
+    schedule = _pimpl->mirror_manager.view(),
+    worker = _pimpl->worker,
+    negotiation = _pimpl->negotiation,
+    node = _pimpl->node](
+    std::vector<rmf_traffic::schedule::Participant> itineraries)
+    {
+      std::unique_lock<std::mutex> lock(*mutex, std::defer_lock);
+      while (!lock.try_lock())
+      {
+        // Intentionally busy wait
+      }
+
+      RCLCPP_INFO(
+        node->get_logger(),
+        "Added a group of [%lu] traffic light controllers for [%s]",
+        itineraries.size(),
+        itineraries.front().description().owner().c_str());
+
+      auto group = EasyTrafficLightGroup::Implementation::make(
+        command_callback,
+        deadlock_callback,
+        schedule,
+        worker,
+        node,
+        traits,
+        std::move(itineraries),
+        blockade_writer,
+        negotiation.get());
+
+      worker.schedule(
+        [handle_callback, group = std::move(group)](const auto&)
+        {
+          handle_callback(group);
+        });
+    };
+
+  for (std::size_t i = 0; i < robot_names.size(); ++i)
+  {
+    rmf_traffic::schedule::ParticipantDescription description(
+      robot_names[i],
+      fleet_name,
+      rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+      profile);
+
+    _pimpl->schedule_writer->async_make_participant(
+      std::move(description),
+      [registration, i](
+        rmf_traffic::schedule::Participant participant)
+      {
+        std::vector<rmf_traffic::schedule::Participant> itineraries;
+        {
+          std::lock_guard<std::mutex> lock(registration->mutex);
+          registration->itineraries[i] = std::move(participant);
+          if (--registration->remaining > 0)
+            return;
+
+          itineraries.reserve(registration->itineraries.size());
+          for (auto& itinerary : registration->itineraries)
+            itineraries.push_back(std::move(*itinerary));
+        }
+
+        registration->ready(std::move(itineraries));
+      });
+  }
+}
+
 //==============================================================================
 std::shared_ptr<rclcpp::Node> Adapter::node()
 {
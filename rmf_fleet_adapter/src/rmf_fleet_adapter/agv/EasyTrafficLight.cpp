@@ -88,6 +88,26 @@ EasyTrafficLight::Implementation::Shared::lock()
   return lock_;
 }
 
+//==============================================================================
+EasyTrafficLight::Implementation::Shared::LazySnapshot::LazySnapshot(
+  std::shared_ptr<const rmf_traffic::schedule::Mirror> schedule,
+  SnapshotPtr snapshot)
+: _schedule(std::move(schedule)),
+  _snapshot(std::move(snapshot))
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto EasyTrafficLight::Implementation::Shared::LazySnapshot::get()
+-> SnapshotPtr
+{
+  if (!_snapshot)
+    _snapshot = _schedule->snapshot();
+
+  return _snapshot;
+}
+
 //==============================================================================
 EasyTrafficLight::Implementation::Shared::Shared(Hooks hooks)
 : state{},
@@ -259,7 +279,8 @@ auto EasyTrafficLight::Implementation::State::location() const
 
 //==============================================================================
 void EasyTrafficLight::Implementation::Shared::follow_new_path(
-  const std::vector<Waypoint>& new_path)
+  const std::vector<Waypoint>& new_path,
+  SnapshotPtr snapshot)
 {
   ++path_version;
   state.clear();
@@ -348,13 +369,24 @@ void EasyTrafficLight::Implementation::Shared::follow_new_path(
   const auto now = rmf_traffic_ros2::convert(hooks.node->now());
   rmf_traffic::agv::Plan::Start start{now, 0, new_path.front().position()[2]};
   state.last_known_location = start;
-  make_plan(path_version, std::move(start));
+  make_plan(path_version, std::move(start), std::move(snapshot));
+}
+
+//==============================================================================
+void EasyTrafficLight::Implementation::Shared::make_plan(
+  const std::size_t request_path_version,
+  rmf_traffic::agv::Plan::Start start,
+  SnapshotPtr snapshot)
+{
+  LazySnapshot lazy(hooks.schedule, std::move(snapshot));
+  make_plan(request_path_version, std::move(start), lazy);
 }
 
 //==============================================================================
 void EasyTrafficLight::Implementation::Shared::make_plan(
   const std::size_t request_path_version,
-  rmf_traffic::agv::Plan::Start start)
+  rmf_traffic::agv::Plan::Start start,
+  LazySnapshot& snapshot)
 {
   if (path_version != request_path_version)
   {
@@ -378,7 +410,7 @@ void EasyTrafficLight::Implementation::Shared::make_plan(
 
   state.find_path_service = std::make_shared<services::FindPath>(
     state.planner, rmf_traffic::agv::Plan::StartSet{std::move(start)},
-    std::move(goal), hooks.schedule->snapshot(), state.itinerary->id(),
+    std::move(goal), snapshot.get(), state.itinerary->id(),
     hooks.profile, std::nullopt);
 
   state.find_path_subscription =
@@ -671,7 +703,8 @@ bool EasyTrafficLight::Implementation::Shared::update_location(
 //==============================================================================
 bool EasyTrafficLight::Implementation::Shared::consider_proposal(
   const std::size_t checkpoint,
-  std::optional<Eigen::Vector3d> location)
+  std::optional<Eigen::Vector3d> location,
+  LazySnapshot& snapshot)
 {
   if (!state.proposal.has_value())
     return state.current_plan.has_value();
@@ -684,7 +717,7 @@ bool EasyTrafficLight::Implementation::Shared::consider_proposal(
     if (!state.current_plan.has_value())
     {
       update_immediate_stop(checkpoint, location);
-      make_plan(path_version, state.last_known_location.value());
+      make_plan(path_version, state.last_known_location.value(), snapshot);
       return false;
     }
 
@@ -701,7 +734,7 @@ bool EasyTrafficLight::Implementation::Shared::consider_proposal(
     {
       state.current_plan = std::nullopt;
       update_immediate_stop(checkpoint, location);
-      make_plan(path_version, state.last_known_location.value());
+      make_plan(path_version, state.last_known_location.value(), snapshot);
       return false;
     }
   }
@@ -728,12 +761,13 @@ bool EasyTrafficLight::Implementation::Shared::consider_proposal(
 }
 
 //==============================================================================
-bool EasyTrafficLight::Implementation::Shared::finish_immediate_stop()
+bool EasyTrafficLight::Implementation::Shared::finish_immediate_stop(
+  LazySnapshot& snapshot)
 {
   if (state.current_plan->immediate_stop_dependencies.deprecated(
       hooks.node->rmf_now()))
   {
-    make_plan(path_version, state.last_known_location.value());
+    make_plan(path_version, state.last_known_location.value(), snapshot);
     return false;
   }
 
@@ -742,7 +776,8 @@ bool EasyTrafficLight::Implementation::Shared::finish_immediate_stop()
 
 //==============================================================================
 bool EasyTrafficLight::Implementation::Shared::check_if_ready(
-  std::size_t to_move_past_checkpoint)
+  std::size_t to_move_past_checkpoint,
+  LazySnapshot& snapshot)
 {
   if (to_move_past_checkpoint < state.range.end)
     return true;
@@ -752,7 +787,7 @@ bool EasyTrafficLight::Implementation::Shared::check_if_ready(
 
   if (dependency.deprecated(hooks.node->rmf_now()))
   {
-    make_plan(path_version, state.last_known_location.value());
+    make_plan(path_version, state.last_known_location.value(), snapshot);
     return false;
   }
 
@@ -774,19 +809,28 @@ auto EasyTrafficLight::Implementation::Shared::moving_from(
   Eigen::Vector3d location) -> MovingInstruction
 {
   const auto l = lock();
+  LazySnapshot snapshot(hooks.schedule);
+  return moving_from(checkpoint, location, snapshot);
+}
 
+//==============================================================================
+auto EasyTrafficLight::Implementation::Shared::moving_from(
+  std::size_t checkpoint,
+  Eigen::Vector3d location,
+  LazySnapshot& snapshot) -> MovingInstruction
+{
   if (!update_location(checkpoint, location))
     return MovingInstruction::MovingError;
 
-  if (!consider_proposal(checkpoint, location))
+  if (!consider_proposal(checkpoint, location, snapshot))
     return MovingInstruction::PauseImmediately;
 
   update_delay(checkpoint, location);
 
-  if (!finish_immediate_stop())
+  if (!finish_immediate_stop(snapshot))
     return MovingInstruction::PauseImmediately;
 
-  if (!check_if_ready(checkpoint + 1))
+  if (!check_if_ready(checkpoint + 1, snapshot))
     return MovingInstruction::WaitAtNextCheckpoint;
 
   return MovingInstruction::ContinueAtNextCheckpoint;
@@ -797,19 +841,27 @@ auto EasyTrafficLight::Implementation::Shared::waiting_at(
   std::size_t checkpoint) -> WaitingInstruction
 {
   const auto l = lock();
+  LazySnapshot snapshot(hooks.schedule);
+  return waiting_at(checkpoint, snapshot);
+}
 
+//==============================================================================
+auto EasyTrafficLight::Implementation::Shared::waiting_at(
+  std::size_t checkpoint,
+  LazySnapshot& snapshot) -> WaitingInstruction
+{
   if (!update_location(checkpoint, std::nullopt))
     return WaitingInstruction::WaitingError;
 
-  if (!consider_proposal(checkpoint, std::nullopt))
+  if (!consider_proposal(checkpoint, std::nullopt, snapshot))
     return WaitingInstruction::Wait;
 
   update_delay(checkpoint, std::nullopt);
 
-  if (!finish_immediate_stop())
+  if (!finish_immediate_stop(snapshot))
     return WaitingInstruction::Wait;
 
-  if (!check_if_ready(checkpoint))
+  if (!check_if_ready(checkpoint, snapshot))
     return WaitingInstruction::Wait;
 
   return WaitingInstruction::Resume;
@@ -821,16 +873,25 @@ auto EasyTrafficLight::Implementation::Shared::waiting_after(
   Eigen::Vector3d location) -> WaitingInstruction
 {
   const auto l = lock();
+  LazySnapshot snapshot(hooks.schedule);
+  return waiting_after(checkpoint, location, snapshot);
+}
 
+//==============================================================================
+auto EasyTrafficLight::Implementation::Shared::waiting_after(
+  std::size_t checkpoint,
+  Eigen::Vector3d location,
+  LazySnapshot& snapshot) -> WaitingInstruction
+{
   if (!update_location(checkpoint, location))
     return WaitingInstruction::WaitingError;
 
-  if (!consider_proposal(checkpoint, location))
+  if (!consider_proposal(checkpoint, location, snapshot))
     return WaitingInstruction::Wait;
 
   update_delay(checkpoint, location);
 
-  if (!finish_immediate_stop())
+  if (!finish_immediate_stop(snapshot))
     return WaitingInstruction::Wait;
 
   // We don't need to check if the next waypoint is ready.
@@ -990,6 +1051,7 @@ void EasyTrafficLight::Implementation::Shared::respond(
     state.itinerary->assign_plan_id(), state.planner,
     {*state.last_known_location}, std::move(goal), {},
     viewer, responder, std::move(approval_cb), evaluator);
+  negotiate->track_robot(name);
 
   auto negotiate_sub =
     rmf_rxcpp::make_job<services::Negotiate::Result>(negotiate)
@@ -1011,8 +1073,9 @@ void EasyTrafficLight::Implementation::Shared::respond(
   using namespace std::chrono_literals;
   const auto wait_duration = 2s + viewer->sequence().back().version * 10s;
 
-  auto negotiate_timer = hooks.node->try_create_wall_timer(
+  auto negotiate_timer = hooks.node->schedule_timer(
     wait_duration,
+    hooks.worker,
     [s = negotiate->weak_from_this()]()
     {
       if (const auto service = s.lock())
@@ -1151,8 +1214,9 @@ EasyTrafficLightPtr EasyTrafficLight::Implementation::make(
     });
 
   handle->_pimpl->shared->hooks.fleet_update_timer =
-    handle->_pimpl->shared->hooks.node->try_create_wall_timer(
+    handle->_pimpl->shared->hooks.node->schedule_timer(
     std::chrono::seconds(1),
+    handle->_pimpl->shared->hooks.worker,
     [w = handle->_pimpl->shared->weak_from_this()]()
     {
       if (const auto self = w.lock())
@@ -1280,8 +1344,9 @@ EasyTrafficLight& EasyTrafficLight::fleet_state_publish_period(
   if (value.has_value())
   {
     _pimpl->shared->hooks.fleet_update_timer =
-      _pimpl->shared->hooks.node->try_create_wall_timer(
-      *value, [w = _pimpl->shared->weak_from_this()]()
+      _pimpl->shared->hooks.node->schedule_timer(
+      *value, _pimpl->shared->hooks.worker,
+      [w = _pimpl->shared->weak_from_this()]()
       {
         if (const auto self = w.lock())
           self->publish_fleet_state();
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "internal_EasyTrafficLightGroup.hpp"
+
+#include <algorithm>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+EasyTrafficLightGroup::Implementation::Commands::Commands(
+  CommandCallback callback,
+  rxcpp::schedulers::worker worker)
+: _callback(std::move(callback)),
+  _worker(std::move(worker))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void EasyTrafficLightGroup::Implementation::Commands::push(
+  const std::size_t robot,
+  const Command command)
+{
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    schedule_flush = _pending.empty();
+    _pending.push_back({robot, command});
+  }
+
+  // Commands are usually issued by jobs that are running on the worker, so
+  // the flush will not happen until the worker is done with the job and every
+  // other command that was issued along with it has been collected.
+  if (schedule_flush)
+  {
+    _worker.schedule(
+      [w = weak_from_this()](const auto&)
+      {
+        if (const auto self = w.lock())
+          self->flush();
+      });
+  }
+}
+
+//==============================================================================
+void EasyTrafficLightGroup::Implementation::Commands::flush()
+{
+  std::vector<RobotCommand> commands;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    commands.swap(_pending);
+  }
+
+  if (!commands.empty() && _callback)
+    _callback(std::move(commands));
+}
+
+//==============================================================================
+EasyTrafficLight::Implementation::Shared&
+EasyTrafficLightGroup::Implementation::shared(const std::size_t robot)
+{
+  return *EasyTrafficLight::Implementation::get(*lights.at(robot)).shared;
+}
+
+//==============================================================================
+auto EasyTrafficLightGroup::Implementation::lock(
+  std::vector<std::size_t> robots) -> std::vector<RobotLock>
+{
+  std::sort(robots.begin(), robots.end());
+  robots.erase(std::unique(robots.begin(), robots.end()), robots.end());
+
+  // Make sure every robot is valid before any of them get locked
+  for (const auto r : robots)
+    lights.at(r);
+
+  std::vector<RobotLock> locks;
+  locks.reserve(robots.size());
+  for (const auto r : robots)
+    locks.push_back(shared(r).lock());
+
+  return locks;
+}
+
+//==============================================================================
+EasyTrafficLightGroupPtr EasyTrafficLightGroup::Implementation::make(
+  CommandCallback command_callback_,
+  DeadlockCallback deadlock_callback_,
+  std::shared_ptr<const rmf_traffic::schedule::Mirror> schedule_,
+  rxcpp::schedulers::worker worker_,
+  std::shared_ptr<Node> node_,
+  rmf_traffic::agv::VehicleTraits traits_,
+  std::vector<rmf_traffic::schedule::Participant> itineraries_,
+  std::shared_ptr<rmf_traffic_ros2::blockade::Writer> blockade_writer_,
+  rmf_traffic_ros2::schedule::Negotiation* negotiation_)
+{
+  std::shared_ptr<EasyTrafficLightGroup> group(new EasyTrafficLightGroup);
+  group->_pimpl = rmf_utils::make_unique_impl<Implementation>();
+  auto& impl = *group->_pimpl;
+
+  impl.commands =
+    std::make_shared<Commands>(std::move(command_callback_), worker_);
+  impl.schedule = schedule_;
+  impl.worker = worker_;
+
+  impl.lights.reserve(itineraries_.size());
+  for (std::size_t i = 0; i < itineraries_.size(); ++i)
+  {
+    std::function<void(std::vector<EasyTrafficLight::Blocker>)> blocker_cb;
+    if (deadlock_callback_)
+    {
+      blocker_cb = [deadlock_callback_, i](auto blockers)
+        {
+          deadlock_callback_(i, std::move(blockers));
+        };
+    }
+
+    impl.lights.push_back(
+      EasyTrafficLight::Implementation::make(
+        [w = impl.commands->weak_from_this(), i]()
+        {
+          if (const auto commands = w.lock())
+            commands->push(i, Command::Pause);
+        },
+        [w = impl.commands->weak_from_this(), i]()
+        {
+          if (const auto commands = w.lock())
+            commands->push(i, Command::Resume);
+        },
+        std::move(blocker_cb),
+        schedule_,
+        worker_,
+        node_,
+        traits_,
+        std::move(itineraries_[i]),
+        blockade_writer_,
+        negotiation_));
+  }
+
+  return group;
+}
+
+//==============================================================================
+EasyTrafficLightGroup& EasyTrafficLightGroup::follow_new_paths(
+  std::vector<NewPath> paths)
+{
+  std::vector<std::weak_ptr<EasyTrafficLight::Implementation::Shared>> robots;
+  robots.reserve(paths.size());
+  bool need_snapshot = false;
+  for (const auto& p : paths)
+  {
+    robots.push_back(_pimpl->shared(p.robot).weak_from_this());
+    need_snapshot |= p.path.size() > 1;
+  }
+
+  _pimpl->worker.schedule(
+    [robots = std::move(robots), paths = std::move(paths),
+    schedule = _pimpl->schedule, need_snapshot](const auto&)
+    {
+      // Every plan of this batch is found against the same snapshot, so the
+      // schedule only needs to be copied once.
+      const auto snapshot = need_snapshot ? schedule->snapshot() : nullptr;
+      for (std::size_t i = 0; i < paths.size(); ++i)
+      {
+        if (const auto self = robots[i].lock())
+          self->follow_new_path(paths[i].path, snapshot);
+      }
+    });
+
+  return *this;
+}
+
+//==============================================================================
+EasyTrafficLightGroup& EasyTrafficLightGroup::update_idle_locations(
+  std::vector<IdleLocation> locations)
+{
+  std::vector<std::weak_ptr<EasyTrafficLight::Implementation::Shared>> robots;
+  robots.reserve(locations.size());
+  for (const auto& l : locations)
+    robots.push_back(_pimpl->shared(l.robot).weak_from_this());
+
+  _pimpl->worker.schedule(
+    [robots = std::move(robots), locations = std::move(locations)](
+      const auto&)
+    {
+      for (std::size_t i = 0; i < locations.size(); ++i)
+      {
+        if (const auto self = robots[i].lock())
+        {
+          const auto& l = locations[i];
+          self->update_idle_location(l.map_name, l.position);
+        }
+      }
+    });
+
+  return *this;
+}
+
+//==============================================================================
+auto EasyTrafficLightGroup::moving_from(const std::vector<Moving>& updates)
+-> std::vector<MovingInstruction>
+{
+  std::vector<std::size_t> robots;
+  robots.reserve(updates.size());
+  for (const auto& u : updates)
+    robots.push_back(u.robot);
+
+  // The whole batch is applied under one set of locks, and any replanning that
+  // it triggers uses one snapshot of the schedule.
+  const auto locks = _pimpl->lock(std::move(robots));
+  EasyTrafficLight::Implementation::Shared::LazySnapshot snapshot(
+    _pimpl->schedule);
+
+  std::vector<MovingInstruction> instructions;
+  instructions.reserve(updates.size());
+  for (const auto& u : updates)
+  {
+    instructions.push_back(
+      _pimpl->shared(u.robot).moving_from(u.checkpoint, u.location, snapshot));
+  }
+
+  return instructions;
+}
+
+//==============================================================================
+auto EasyTrafficLightGroup::waiting(const std::vector<Waiting>& updates)
+-> std::vector<WaitingInstruction>
+{
+  std::vector<std::size_t> robots;
+  robots.reserve(updates.size());
+  for (const auto& u : updates)
+    robots.push_back(u.robot);
+
+  const auto locks = _pimpl->lock(std::move(robots));
+  EasyTrafficLight::Implementation::Shared::LazySnapshot snapshot(
+    _pimpl->schedule);
+
+  std::vector<WaitingInstruction> instructions;
+  instructions.reserve(updates.size());
+  for (const auto& u : updates)
+  {
+    auto& shared = _pimpl->shared(u.robot);
+    if (u.location.has_value())
+    {
+      instructions.push_back(
+        shared.waiting_after(u.checkpoint, *u.location, snapshot));
+    }
+    else
+    {
+      instructions.push_back(shared.waiting_at(u.checkpoint, snapshot));
+    }
+  }
+
+  return instructions;
+}
+
+//==============================================================================
+const EasyTrafficLightPtr& EasyTrafficLightGroup::light(
+  const std::size_t robot) const
+{
+  return _pimpl->lights.at(robot);
+}
+
+//==============================================================================
+std::size_t EasyTrafficLightGroup::size() const
+{
+  return _pimpl->lights.size();
+}
+
+//==============================================================================
+EasyTrafficLightGroup::EasyTrafficLightGroup()
+{
+  // Do nothing
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
@@ -45,6 +45,9 @@
 
 #include <rmf_task_sequence/phases/SimplePhase.hpp>
 
+#include <rmf_rxcpp/RxJobs.hpp>
+
+#include <algorithm>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
@@ -171,7 +174,7 @@ void FleetUpdateHandle::Implementation::dock_summary_cb(
 
 //==============================================================================
 std::string FleetUpdateHandle::Implementation::make_error_str(
-  uint64_t code, std::string category, std::string detail) const
+  uint64_t code, std::string category, std::string detail)
 {
   nlohmann::json error;
   error["code"] = code;
@@ -325,11 +328,11 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
 
   const auto request_msg = nlohmann::json::parse(bid_notice.request);
   static const auto request_validator =
-    nlohmann::json_schema::json_validator(rmf_api_msgs::schemas::task_request);
+    make_validator(rmf_api_msgs::schemas::task_request);
 
   try
   {
-    request_validator.validate(request_msg);
+    request_validator->validate(request_msg);
   }
   catch (const std::exception& e)
   {
@@ -357,12 +360,59 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
       });
   }
 
-  // TODO(MXG): Make the task planning asynchronous. The worker should schedule
-  // a job to perform the planning which should then spawn a job to save the
-  // plan result and respond. I started to refactor allocate_tasks(~) to make it
-  // async, but I will save the remaining effort for later, when there is more
-  // time to spare.
-  auto allocation_result = allocate_tasks(new_request, &errors);
+  // Plan in the background so the fleet worker stays free, then come back to
+  // the worker to save the plan result and respond. The background job only
+  // uses a copy of what it needs from the fleet, because the fleet may change
+  // on the worker while it is planning.
+  auto background = rmf_rxcpp::detail::get_planning_scheduler()
+    .get_scheduler(rmf_rxcpp::JobPriority::routine).create_worker();
+
+  background.schedule(
+    [
+      w = weak_self,
+      worker = worker,
+      task_id,
+      new_request,
+      input = prepare_allocation(aggregate_expectations()),
+      generation = assignment_generation,
+      errors = std::move(errors),
+      respond = std::move(respond)
+    ](const auto&) mutable
+    {
+      if (w.expired())
+        return;
+
+      auto allocation_result =
+        plan_allocation(std::move(input), new_request, &errors);
+
+      worker.schedule(
+        [
+          w,
+          task_id = std::move(task_id),
+          generation,
+          allocation_result = std::move(allocation_result),
+          errors = std::move(errors),
+          respond = std::move(respond)
+        ](const auto&) mutable
+        {
+          if (const auto self = w.lock())
+          {
+            self->_pimpl->respond_to_bid(
+              task_id, generation, std::move(allocation_result),
+              std::move(errors), respond);
+          }
+        });
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::respond_to_bid(
+  const std::string& task_id,
+  const std::size_t generation,
+  std::optional<Assignments> allocation_result,
+  std::vector<std::string> errors,
+  const rmf_task_ros2::bidding::AsyncBidder::Respond& respond)
+{
   if (!allocation_result.has_value())
     return respond({std::nullopt, std::move(errors)});
 
@@ -435,6 +485,10 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
     return respond({std::nullopt, std::move(errors)});
   }
 
+  // Store assignments in internal map before responding, because the award
+  // might arrive as soon as the response goes out
+  bid_notice_assignments.insert({task_id, {assignments, generation}});
+
   // Publish BidProposal
   respond(
     {
@@ -452,9 +506,6 @@ void FleetUpdateHandle::Implementation::bid_notice_cb(
     node->get_logger(),
     "Submitted BidProposal to accommodate task [%s] by robot [%s] with new cost [%f]",
     task_id.c_str(), robot_name->c_str(), cost);
-
-  // Store assignments in internal map
-  bid_notice_assignments.insert({task_id, assignments});
 }
 
 //==============================================================================
@@ -527,7 +578,8 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
       task_id.c_str(),
       name.c_str());
 
-    auto assignments = std::move(task_it->second);
+    auto assignments = std::move(task_it->second.assignments);
+    const auto bid_generation = task_it->second.generation;
     bid_notice_assignments.erase(task_it);
 
     if (assignments.size() != task_managers.size())
@@ -547,81 +599,59 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
       return;
     }
 
-    // Here we make sure none of the tasks in the assignments has already begun
-    // execution. If so, we replan assignments until a valid set is obtained
-    // and only then update the task manager queues
-    bool valid_assignments = is_valid_assignments(assignments);
-    if (!valid_assignments)
+    rmf_task::ConstRequestPtr request;
+    for (const auto& a : assignments)
     {
-      rmf_task::ConstRequestPtr request;
-      for (const auto& a : assignments)
+      for (const auto& r : a)
       {
-        for (const auto& r : a)
+        if (r.request()->booking()->id() == task_id)
         {
-          if (r.request()->booking()->id() == task_id)
-          {
-            request = r.request();
-            break;
-          }
-        }
-
-        if (request)
+          request = r.request();
           break;
+        }
       }
 
-      if (!request)
-      {
-        std::string error_str =
-          "Could not find task_id [" + task_id + "] in the set of assignments "
-          "associated with it. This is a critical bug and should be reported "
-          "to the RMF developers";
-
-        RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
-        dispatch_ack.errors.push_back(
-          make_error_str(13, "Internal bug", std::move(error_str)));
-        dispatch_ack_pub->publish(dispatch_ack);
-        return;
-      }
-
-      // TODO: This replanning is blocking the main thread. Instead, the
-      // replanning should run on a separate worker and then deliver the
-      // result back to the main worker.
-      const auto replan_results = allocate_tasks(request, &dispatch_ack.errors);
-      if (!replan_results)
-      {
-        std::string error_str =
-          "Unable to replan assignments when accommodating task_id [" + task_id
-          + "]. This request will be ignored.";
+      if (request)
+        break;
+    }
 
-        RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
-        dispatch_ack.errors.push_back(
-          make_error_str(9, "Not feasible", std::move(error_str)));
-        dispatch_ack_pub->publish(dispatch_ack);
-        return;
-      }
+    if (!request)
+    {
+      std::string error_str =
+        "Could not find task_id [" + task_id + "] in the set of assignments "
+        "associated with it. This is a critical bug and should be reported "
+        "to the RMF developers";
 
-      assignments = replan_results.value();
-      // We do not need to re-check if assignments are valid as this function
-      // is being called by the ROS2 executor and is running on the main
-      // rxcpp worker. Hence, no new tasks would have started during this
-      // replanning.
+      RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
+      dispatch_ack.errors.push_back(
+        make_error_str(13, "Internal bug", std::move(error_str)));
+      dispatch_ack_pub->publish(dispatch_ack);
+      return;
     }
 
-    std::size_t index = 0;
-    for (auto& t : task_managers)
+    if (bid_generation != assignment_generation || pending_reallocations > 0)
     {
-      t.second->set_queue(assignments[index]);
-      ++index;
+      // The queues have been replaced since this bid was planned, or will be
+      // once a reallocation finishes, so applying these assignments would
+      // drop the tasks of the other awards. Plan the whole fleet again instead.
+      return reallocate_award(
+        task_id, std::move(request), std::move(assignments),
+        std::move(dispatch_ack), max_award_repair_attempts);
     }
 
-    current_assignment_cost = task_planner->compute_cost(assignments);
-    dispatch_ack.success = true;
-    dispatch_ack_pub->publish(dispatch_ack);
+    // Here we make sure none of the tasks in the assignments has already begun
+    // execution. If so, we replan assignments until a valid set is obtained
+    // and only then update the task manager queues. Planning again can take
+    // longer than the bid itself for fleets with long queues, so it happens
+    // in the background.
+    if (!is_valid_assignments(assignments))
+    {
+      return reallocate_award(
+        task_id, std::move(request), std::move(assignments),
+        std::move(dispatch_ack));
+    }
 
-    RCLCPP_INFO(
-      node->get_logger(),
-      "Assignments updated for robots in fleet [%s] to accommodate task_id [%s]",
-      name.c_str(), task_id.c_str());
+    apply_award(task_id, assignments, std::move(dispatch_ack));
   }
   else if (msg->type == DispatchCmdMsg::TYPE_REMOVE)
   {
@@ -681,6 +711,7 @@ void FleetUpdateHandle::Implementation::dispatch_command_cb(
             ++index;
           }
 
+          ++assignment_generation;
           current_assignment_cost = task_planner->compute_cost(assignments);
 
           RCLCPP_INFO(
@@ -730,6 +761,242 @@ auto FleetUpdateHandle::Implementation::is_valid_assignments(
   return true;
 }
 
+//==============================================================================
+auto FleetUpdateHandle::Implementation::prepare_reallocation(
+  const Assignments& assignments) const -> Reallocation
+{
+  std::unordered_set<std::string> executed_tasks;
+  for (const auto& [context, mgr] : task_managers)
+  {
+    const auto& tasks = mgr->get_executed_tasks();
+    executed_tasks.insert(tasks.begin(), tasks.end());
+  }
+
+  Reallocation reallocation;
+  std::size_t index = 0;
+  for (const auto& [context, mgr] : task_managers)
+  {
+    const auto& queue = assignments[index];
+    const bool changed = std::any_of(
+      queue.begin(), queue.end(), [&](const auto& a)
+      {
+        return executed_tasks.count(a.request()->booking()->id()) > 0;
+      });
+
+    if (changed)
+    {
+      reallocation.robots.push_back(index);
+      reallocation.states.push_back(mgr->expected_finish_state());
+      for (const auto& a : queue)
+      {
+        const auto& booking = *a.request()->booking();
+        // Automatic tasks like charging will be added again by the planner if
+        // they are still needed.
+        if (booking.automatic() || executed_tasks.count(booking.id()))
+          continue;
+
+        reallocation.requests.push_back(a.request());
+      }
+    }
+
+    ++index;
+  }
+
+  return reallocation;
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::reallocate_award(
+  std::string task_id,
+  rmf_task::ConstRequestPtr request,
+  Assignments assignments,
+  DispatchAck dispatch_ack,
+  std::size_t attempt)
+{
+  if (attempt >= max_award_attempts)
+  {
+    std::string error_str =
+      "Unable to replan assignments when accommodating task_id [" + task_id
+      + "]. This request will be ignored.";
+
+    RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
+    dispatch_ack.errors.push_back(
+      make_error_str(9, "Not feasible", std::move(error_str)));
+    dispatch_ack_pub->publish(dispatch_ack);
+    return;
+  }
+
+  const bool repair = attempt < max_award_repair_attempts;
+  Reallocation reallocation;
+  Expectations expectations;
+  if (repair)
+  {
+    reallocation = prepare_reallocation(assignments);
+    expectations.states = std::move(reallocation.states);
+    expectations.pending_requests = std::move(reallocation.requests);
+  }
+  else
+  {
+    expectations = aggregate_expectations();
+  }
+
+  const std::string scope = repair ?
+    "[" + std::to_string(reallocation.robots.size())
+    + "] robot(s) whose queues changed" : "the whole fleet";
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "The assignments that fleet [%s] bid with for task_id [%s] are out of "
+    "date. Replanning assignments for %s in the background.",
+    name.c_str(), task_id.c_str(), scope.c_str());
+
+  const auto generation = assignment_generation;
+  ++pending_reallocations;
+  auto background = rmf_rxcpp::detail::get_planning_scheduler()
+    .get_scheduler(rmf_rxcpp::JobPriority::routine).create_worker();
+
+  background.schedule(
+    [
+      w = weak_self,
+      worker = worker,
+      task_id = std::move(task_id),
+      request = std::move(request),
+      assignments = std::move(assignments),
+      dispatch_ack = std::move(dispatch_ack),
+      robots = std::move(reallocation.robots),
+      // The background job only uses copies, because the fleet state may
+      // change on the worker while it is planning.
+      input = prepare_allocation(std::move(expectations)),
+      generation,
+      attempt,
+      repair
+    ](const auto&) mutable
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      std::vector<std::string> errors;
+      bool success = true;
+      if (!repair)
+      {
+        auto result = plan_allocation(std::move(input), request, &errors);
+        if (result.has_value())
+          assignments = std::move(*result);
+        else
+          success = false;
+      }
+      else if (!input.expectations.pending_requests.empty())
+      {
+        const auto result = input.task_planner->plan(
+          input.time,
+          input.expectations.states,
+          input.expectations.pending_requests);
+
+        const auto* repaired =
+          std::get_if<rmf_task::TaskPlanner::Assignments>(&result);
+
+        if (repaired && repaired->size() == robots.size())
+        {
+          for (std::size_t i = 0; i < robots.size(); ++i)
+            assignments[robots[i]] = (*repaired)[i];
+        }
+        else
+        {
+          success = false;
+        }
+      }
+      else
+      {
+        for (const auto r : robots)
+          assignments[r].clear();
+      }
+
+      worker.schedule(
+        [
+          w,
+          task_id = std::move(task_id),
+          request = std::move(request),
+          assignments = std::move(assignments),
+          dispatch_ack = std::move(dispatch_ack),
+          errors = std::move(errors),
+          generation,
+          attempt,
+          repair,
+          success
+        ](const auto&) mutable
+        {
+          const auto self = w.lock();
+          if (!self)
+            return;
+
+          auto& impl = *self->_pimpl;
+          --impl.pending_reallocations;
+          if (!repair)
+          {
+            dispatch_ack.errors.insert(
+              dispatch_ack.errors.end(), errors.begin(), errors.end());
+          }
+
+          if (!success)
+          {
+            // Skip straight to planning for the whole fleet
+            return impl.reallocate_award(
+              std::move(task_id), std::move(request), std::move(assignments),
+              std::move(dispatch_ack),
+              std::max(attempt + 1, max_award_repair_attempts));
+          }
+
+          const bool stale = generation != impl.assignment_generation
+          || assignments.size() != impl.task_managers.size();
+
+          if (stale)
+          {
+            // Another award or cancellation replaced the queues in the
+            // meantime, so these assignments do not account for it.
+            return impl.reallocate_award(
+              std::move(task_id), std::move(request), std::move(assignments),
+              std::move(dispatch_ack),
+              std::max(attempt + 1, max_award_repair_attempts));
+          }
+
+          if (!impl.is_valid_assignments(assignments))
+          {
+            // More tasks began while we were planning
+            return impl.reallocate_award(
+              std::move(task_id), std::move(request), std::move(assignments),
+              std::move(dispatch_ack), attempt + 1);
+          }
+
+          impl.apply_award(task_id, assignments, std::move(dispatch_ack));
+        });
+    });
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::apply_award(
+  const std::string& task_id,
+  const Assignments& assignments,
+  DispatchAck dispatch_ack)
+{
+  std::size_t index = 0;
+  for (auto& t : task_managers)
+  {
+    t.second->set_queue(assignments[index]);
+    ++index;
+  }
+
+  ++assignment_generation;
+  current_assignment_cost = task_planner->compute_cost(assignments);
+  dispatch_ack.success = true;
+  dispatch_ack_pub->publish(dispatch_ack);
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Assignments updated for robots in fleet [%s] to accommodate task_id [%s]",
+    name.c_str(), task_id.c_str());
+}
+
 //==============================================================================
 std::optional<std::size_t> FleetUpdateHandle::Implementation::
 get_nearest_charger(
@@ -814,6 +1081,20 @@ std::optional<rmf_fleet_msgs::msg::RobotState> convert_state(
     // information.
     .path({});
 }
+
+//==============================================================================
+nlohmann::json job_metrics_to_json(const JobMetrics::Summary& s)
+{
+  nlohmann::json json;
+  json["count"] = s.count;
+  json["mean_ns"] = s.mean();
+  json["min_ns"] = s.min;
+  json["max_ns"] = s.max;
+  json["p50_ns"] = s.percentile(0.5);
+  json["p90_ns"] = s.percentile(0.9);
+  json["p99_ns"] = s.percentile(0.99);
+  return json;
+}
 } // anonymous namespace
 
 //==============================================================================
@@ -841,6 +1122,7 @@ void FleetUpdateHandle::Implementation::update_fleet() const
 {
   update_fleet_state();
   update_fleet_logs();
+  update_fleet_metrics();
 }
 
 //==============================================================================
@@ -895,7 +1177,7 @@ void FleetUpdateHandle::Implementation::update_fleet_state() const
       static const auto validator =
         make_validator(rmf_api_msgs::schemas::fleet_state_update);
 
-      validator.validate(fleet_state_update_msg);
+      validator->validate(fleet_state_update_msg);
 
       std::unique_lock<std::mutex> lock(*update_callback_mutex);
       if (update_callback)
@@ -913,6 +1195,47 @@ void FleetUpdateHandle::Implementation::update_fleet_state() const
   }
 }
 
+//==============================================================================
+void FleetUpdateHandle::Implementation::update_fleet_metrics() const
+{
+  if (!broadcast_client)
+    return;
+
+  const auto window = node->job_metrics();
+  if (!window || window == last_job_metrics)
+  {
+    // No new window of metrics to report
+    return;
+  }
+  last_job_metrics = window;
+
+  // There is no schema for this message in rmf_api_msgs, so it is sent as-is
+  // for monitoring tools to pick up.
+  nlohmann::json fleet_metrics_update_msg;
+  fleet_metrics_update_msg["type"] = "fleet_metrics_update";
+  auto& data = fleet_metrics_update_msg["data"];
+  data["name"] = name;
+  data["unix_millis_start_time"] =
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+    window->start.time_since_epoch()).count();
+  data["unix_millis_finish_time"] =
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+    window->stop.time_since_epoch()).count();
+
+  auto& categories = data["categories"];
+  categories = std::unordered_map<std::string, nlohmann::json>();
+  for (const auto& category : window->categories)
+  {
+    auto& json = categories[category.name];
+    json["queue_delay"] = job_metrics_to_json(category.queue_delay);
+    json["execution_time"] = job_metrics_to_json(category.execution_time);
+    if (category.alive.has_value())
+      json["alive"] = *category.alive;
+  }
+
+  broadcast_client->publish(fleet_metrics_update_msg);
+}
+
 //==============================================================================
 void FleetUpdateHandle::Implementation::update_fleet_logs() const
 {
@@ -949,7 +1272,7 @@ void FleetUpdateHandle::Implementation::update_fleet_logs() const
       static const auto validator =
         make_validator(rmf_api_msgs::schemas::fleet_log_update);
 
-      validator.validate(fleet_log_update_msg);
+      validator->validate(fleet_log_update_msg);
 
       std::unique_lock<std::mutex> lock(*update_callback_mutex);
       if (update_callback)
@@ -968,27 +1291,10 @@ void FleetUpdateHandle::Implementation::update_fleet_logs() const
 }
 
 //==============================================================================
-nlohmann::json_schema::json_validator
-FleetUpdateHandle::Implementation::make_validator(
-  const nlohmann::json& schema) const
+rmf_task_ros2::SchemaRegistry::ConstValidatorPtr
+FleetUpdateHandle::Implementation::make_validator(const nlohmann::json& schema)
 {
-  const auto loader =
-    [n = node, s = schema_dictionary](const nlohmann::json_uri& id,
-      nlohmann::json& value)
-    {
-      const auto it = s.find(id.url());
-      if (it == s.end())
-      {
-        RCLCPP_ERROR(
-          n->get_logger(),
-          "url: %s not found in schema dictionary", id.url().c_str());
-        return;
-      }
-
-      value = it->second;
-    };
-
-  return nlohmann::json_schema::json_validator(schema, loader);
+  return rmf_task_ros2::SchemaRegistry::global()->validator(schema);
 }
 
 namespace {
@@ -1156,8 +1462,33 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
 {
   // Collate robot states, constraints and combine new requestptr with
   // requestptr of non-charging tasks in task manager queues
-  auto expect = expectations.has_value() ? expectations.value() :
-    aggregate_expectations();
+  return plan_allocation(
+    prepare_allocation(
+      expectations.has_value() ?
+      std::move(*expectations) : aggregate_expectations()),
+    std::move(new_request),
+    errors);
+}
+
+//==============================================================================
+auto FleetUpdateHandle::Implementation::prepare_allocation(
+  Expectations expectations) const -> AllocationInput
+{
+  return AllocationInput{
+    task_planner,
+    rmf_traffic_ros2::convert(node->now()),
+    std::move(expectations),
+    node->get_logger()
+  };
+}
+
+//==============================================================================
+auto FleetUpdateHandle::Implementation::plan_allocation(
+  AllocationInput input,
+  rmf_task::ConstRequestPtr new_request,
+  std::vector<std::string>* errors) -> std::optional<Assignments>
+{
+  auto& expect = input.expectations;
   std::string id = "";
 
   if (new_request)
@@ -1167,14 +1498,14 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
   }
 
   RCLCPP_INFO(
-    node->get_logger(),
+    input.logger,
     "Planning for [%ld] robot(s) and [%ld] request(s)",
     expect.states.size(),
     expect.pending_requests.size());
 
   // Generate new task assignments
-  const auto result = task_planner->plan(
-    rmf_traffic_ros2::convert(node->now()),
+  const auto result = input.task_planner->plan(
+    input.time,
     expect.states,
     expect.pending_requests);
 
@@ -1193,7 +1524,7 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
         + "] due to insufficient initial battery charge for all robots in this "
         "fleet.";
 
-      RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
+      RCLCPP_ERROR(input.logger, "%s", error_str.c_str());
       if (errors)
       {
         errors->push_back(
@@ -1209,7 +1540,7 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
         + "] due to insufficient battery capacity to accommodate one or more "
         "requests by any of the robots in this fleet.";
 
-      RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
+      RCLCPP_ERROR(input.logger, "%s", error_str.c_str());
       if (errors)
       {
         errors->push_back(
@@ -1222,7 +1553,7 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
       std::string error_str =
         "[TaskPlanner] Failed to compute assignments for task_id [" + id + "]";
 
-      RCLCPP_ERROR(node->get_logger(), "%s", error_str.c_str());
+      RCLCPP_ERROR(input.logger, "%s", error_str.c_str());
       if (errors)
       {
         errors->push_back(
@@ -1238,7 +1569,7 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
   if (assignments.empty())
   {
     RCLCPP_ERROR(
-      node->get_logger(),
+      input.logger,
       "[TaskPlanner] Failed to compute assignments for task_id [%s]",
       id.c_str());
 
@@ -1248,6 +1579,135 @@ auto FleetUpdateHandle::Implementation::allocate_tasks(
   return assignments;
 }
 
+//==============================================================================
+std::shared_ptr<RobotContext>
+FleetUpdateHandle::Implementation::make_robot_context(
+  std::shared_ptr<RobotCommandHandle> command,
+  rmf_traffic::agv::Plan::StartSet start,
+  rmf_traffic::schedule::Participant participant)
+{
+  const auto charger_wp = get_nearest_charger(start[0]);
+
+  if (!charger_wp.has_value())
+  {
+    // *INDENT-OFF*
+    throw std::runtime_error(
+      "[FleetUpdateHandle::add_robot] Unable to find nearest charging "
+      "waypoint. Adding a robot to a fleet requires at least one charging"
+      "waypoint to be present in its navigation graph.");
+    // *INDENT-ON*
+  }
+
+  rmf_task::State state;
+  state.load_basic(start[0], charger_wp.value(), 1.0);
+
+  return std::make_shared<RobotContext>(
+    RobotContext
+    {
+      std::move(command),
+      std::move(start),
+      std::move(participant),
+      mirror,
+      planner,
+      activation.task,
+      task_parameters,
+      node,
+      worker,
+      default_maximum_delay,
+      state,
+      task_planner
+    }
+  );
+}
+
+//==============================================================================
+void FleetUpdateHandle::Implementation::add_robot_context(
+  std::shared_ptr<RobotContext> context,
+  std::function<void(std::shared_ptr<RobotUpdateHandle>)> handle_cb)
+{
+  // TODO(MXG): We need to perform this test because we do not currently
+  // support the distributed negotiation in unit test environments. We
+  // should create an abstract NegotiationRoom interface in rmf_traffic and
+  // use that instead.
+  if (negotiation)
+  {
+    using namespace std::chrono_literals;
+    auto last_interrupt_time =
+    std::make_shared<std::optional<rmf_traffic::Time>>(std::nullopt);
+    context->_negotiation_license =
+    negotiation
+    ->register_negotiator(
+      context->itinerary().id(),
+      std::make_unique<LiaisonNegotiator>(context),
+      [w = std::weak_ptr<RobotContext>(context), last_interrupt_time]()
+      {
+        if (const auto c = w.lock())
+        {
+          std::stringstream ss;
+          ss << "Failed negotiation for [" << c->requester_id()
+             << "] with these starts:";
+          for (const auto& l : c->location())
+          {
+            ss << "\n -- t:" << l.time().time_since_epoch().count()
+               << " | wp:" << l.waypoint() << " | ori:"
+               << l.orientation();
+            if (l.location().has_value())
+            {
+              const auto& p = *l.location();
+              ss << " | pos:(" << p.x() << ", " << p.y() << ")";
+            }
+          }
+          ss << "\n -- Fin --";
+          std::cout << ss.str() << std::endl;
+
+          auto& last_time = *last_interrupt_time;
+          const auto now = std::chrono::steady_clock::now();
+          if (last_time.has_value())
+          {
+            if (now < *last_time + 10s)
+              return;
+          }
+
+          last_time = now;
+          c->request_replan();
+        }
+      });
+  }
+
+  RCLCPP_INFO(
+    node->get_logger(),
+    "Added a robot named [%s] with participant ID [%ld]",
+    context->name().c_str(),
+    context->itinerary().id());
+
+  std::optional<std::weak_ptr<rmf_websocket::BroadcastClient>>
+  task_broadcast_client = std::nullopt;
+
+  if (broadcast_client)
+    task_broadcast_client = broadcast_client;
+
+  task_managers.insert({context,
+    TaskManager::make(
+      context,
+      task_broadcast_client,
+      weak_self)});
+
+  // -- Calling the handle_cb should always happen last --
+  if (handle_cb)
+  {
+    handle_cb(RobotUpdateHandle::Implementation::make(std::move(context)));
+  }
+  else
+  {
+    RCLCPP_WARN(
+      node->get_logger(),
+      "FleetUpdateHandle::add_robot(~) was not provided a callback to "
+      "receive the RobotUpdateHandle of the new robot. This means you will "
+      "not be able to update the state of the new robot. This is likely to "
+      "be a fleet adapter development error.");
+  }
+}
+
 //==============================================================================
 void FleetUpdateHandle::add_robot(
   std::shared_ptr<RobotCommandHandle> command,
@@ -1285,136 +1745,86 @@ void FleetUpdateHandle::add_robot(
       if (!fleet)
         return;
 
-      const auto charger_wp = fleet->_pimpl->get_nearest_charger(start[0]);
-
-      if (!charger_wp.has_value())
-      {
-        // *INDENT-OFF*
-        throw std::runtime_error(
-          "[FleetUpdateHandle::add_robot] Unable to find nearest charging "
-          "waypoint. Adding a robot to a fleet requires at least one charging"
-          "waypoint to be present in its navigation graph.");
-        // *INDENT-ON*
-      }
-
-      rmf_task::State state;
-      state.load_basic(start[0], charger_wp.value(), 1.0);
-
-      auto context = std::make_shared<RobotContext>(
-        RobotContext
-        {
-          std::move(command),
-          std::move(start),
-          std::move(participant),
-          fleet->_pimpl->mirror,
-          fleet->_pimpl->planner,
-          fleet->_pimpl->activation.task,
-          fleet->_pimpl->task_parameters,
-          fleet->_pimpl->node,
-          fleet->_pimpl->worker,
-          fleet->_pimpl->default_maximum_delay,
-          state,
-          fleet->_pimpl->task_planner
-        }
-      );
+      auto context = fleet->_pimpl->make_robot_context(
+        std::move(command), std::move(start), std::move(participant));
 
       // We schedule the following operations on the worker to make sure we do not
       // have a multiple read/write race condition on the FleetUpdateHandle.
       worker.schedule(
         [fleet_wptr = std::weak_ptr<FleetUpdateHandle>(fleet),
-        node_wptr = std::weak_ptr<Node>(fleet->_pimpl->node),
         context = std::move(context),
         handle_cb = std::move(handle_cb)](const auto&)
         {
-          auto fleet = fleet_wptr.lock();
-          if (!fleet)
-            return;
-
-          auto node = node_wptr.lock();
-          if (!node)
-            return;
-
-
-          // TODO(MXG): We need to perform this test because we do not currently
-          // support the distributed negotiation in unit test environments. We
-          // should create an abstract NegotiationRoom interface in rmf_traffic and
-          // use that instead.
-          if (fleet->_pimpl->negotiation)
+          if (const auto fleet = fleet_wptr.lock())
           {
-            using namespace std::chrono_literals;
-            auto last_interrupt_time =
-            std::make_shared<std::optional<rmf_traffic::Time>>(std::nullopt);
-            context->_negotiation_license =
-            fleet->_pimpl->negotiation
-            ->register_negotiator(
-              context->itinerary().id(),
-              std::make_unique<LiaisonNegotiator>(context),
-              [w = std::weak_ptr<RobotContext>(context), last_interrupt_time]()
-              {
-                if (const auto c = w.lock())
-                {
-                  std::stringstream ss;
-                  ss << "Failed negotiation for [" << c->requester_id()
-                     << "] with these starts:";
-                  for (const auto& l : c->location())
-                  {
-                    ss << "\n -- t:" << l.time().time_since_epoch().count()
-                       << " | wp:" << l.waypoint() << " | ori:"
-                       << l.orientation();
-                    if (l.location().has_value())
-                    {
-                      const auto& p = *l.location();
-                      ss << " | pos:(" << p.x() << ", " << p.y() << ")";
-                    }
-                  }
-                  ss << "\n -- Fin --";
-                  std::cout << ss.str() << std::endl;
-
-                  auto& last_time = *last_interrupt_time;
-                  const auto now = std::chrono::steady_clock::now();
-                  if (last_time.has_value())
-                  {
-                    if (now < *last_time + 10s)
-                      return;
-                  }
-
-                  last_time = now;
-                  c->request_replan();
-                }
-              });
+            fleet->_pimpl->add_robot_context(
+              std::move(context), std::move(handle_cb));
           }
+        });
+    });
+}
 
-          RCLCPP_INFO(
-            node->get_logger(),
-            "Added a robot named [%s] with participant ID [%ld]",
-            context->name().c_str(),
-            context->itinerary().id());
+//==============================================================================
+void FleetUpdateHandle::add_robots(std::vector<NewRobot> robots)
+{
+  std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions;
+  descriptions.reserve(robots.size());
+  for (const auto& robot : robots)
+  {
+    if (robot.start.empty())
+    {
+      // *INDENT-OFF*
+      throw std::runtime_error(
+        "[FleetUpdateHandle::add_robots] StartSet of [" + robot.name + "] is "
+        "empty. Adding a robot to a fleet requires at least one "
+        "rmf_traffic::agv::Plan::Start to be specified.");
+      // *INDENT-ON*
+    }
 
-          std::optional<std::weak_ptr<rmf_websocket::BroadcastClient>>
-          broadcast_client = std::nullopt;
+    descriptions.emplace_back(
+      robot.name,
+      _pimpl->name,
+      rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+      robot.profile);
+  }
 
-          if (fleet->_pimpl->broadcast_client)
-            broadcast_client = fleet->_pimpl->broadcast_client;
+  _pimpl->writer->async_make_participants(
+    std::move(descriptions),
+    [worker = _pimpl->worker,
+    robots = std::move(robots),
+    fleet_wptr = weak_from_this()](
+      std::vector<rmf_traffic::schedule::Participant> participants) mutable
+    {
+      auto fleet = fleet_wptr.lock();
+      if (!fleet)
+        return;
 
-          fleet->_pimpl->task_managers.insert({context,
-            TaskManager::make(
-              context,
-              broadcast_client,
-              std::weak_ptr<FleetUpdateHandle>(fleet))});
+      std::vector<std::shared_ptr<RobotContext>> contexts;
+      contexts.reserve(robots.size());
+      for (std::size_t i = 0; i < robots.size(); ++i)
+      {
+        auto& robot = robots[i];
+        contexts.push_back(
+          fleet->_pimpl->make_robot_context(
+            std::move(robot.command),
+            std::move(robot.start),
+            std::move(participants[i])));
+      }
 
-          // -- Calling the handle_cb should always happen last --
-          if (handle_cb)
-          {
-            handle_cb(RobotUpdateHandle::Implementation::make(std::move(context)));
-          }
-          else
+      // The whole fleet is added in one job on the worker
+      worker.schedule(
+        [fleet_wptr = std::weak_ptr<FleetUpdateHandle>(fleet),
+        contexts = std::move(contexts),
+        robots = std::move(robots)](const auto&) mutable
+        {
+          const auto fleet = fleet_wptr.lock();
+          if (!fleet)
+            return;
+
+          for (std::size_t i = 0; i < contexts.size(); ++i)
           {
-            RCLCPP_WARN(
-              node->get_logger(),
-              "FleetUpdateHandle::add_robot(~) was not provided a callback to "
-              "receive the RobotUpdateHandle of the new robot. This means you will "
-              "not be able to update the state of the new robot. This is likely to "
-              "be a fleet adapter development error.");
+            fleet->_pimpl->add_robot_context(
+              std::move(contexts[i]), std::move(robots[i].handle_cb));
           }
         });
     });
@@ -1551,6 +1961,7 @@ void FleetUpdateHandle::close_lanes(std::vector<std::size_t> lane_indices)
         new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
+      self->_pimpl->warm_planner_caches();
       self->_pimpl->publish_lane_states();
     });
 }
@@ -1598,6 +2009,7 @@ void FleetUpdateHandle::open_lanes(std::vector<std::size_t> lane_indices)
         new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
+      self->_pimpl->warm_planner_caches();
       self->_pimpl->publish_lane_states();
     });
 }
@@ -1679,6 +2091,7 @@ auto FleetUpdateHandle::limit_lane_speeds(
         new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
+      self->_pimpl->warm_planner_caches();
       self->_pimpl->publish_lane_states();
     });
 }
@@ -1715,6 +2128,7 @@ void FleetUpdateHandle::remove_speed_limits(std::vector<std::size_t> requests)
         new_config, rmf_traffic::agv::Planner::Options(nullptr));
 
       self->_pimpl->task_parameters->planner(*self->_pimpl->planner);
+      self->_pimpl->warm_planner_caches();
       self->_pimpl->publish_lane_states();
     });
 }
@@ -1738,6 +2152,13 @@ void FleetUpdateHandle::Implementation::publish_lane_states() const
   }
   lane_states_pub->publish(std::move(msg));
 }
+//==============================================================================
+void FleetUpdateHandle::Implementation::warm_planner_caches() const
+{
+  if (planner_cache_warmer)
+    planner_cache_warmer->warm(*planner);
+}
+
 //==============================================================================
 FleetUpdateHandle& FleetUpdateHandle::accept_task_requests(
   AcceptTaskRequest check)
@@ -1979,6 +2400,33 @@ FleetUpdateHandle& FleetUpdateHandle::fleet_state_update_period(
   return *this;
 }
 
+//==============================================================================
+FleetUpdateHandle& FleetUpdateHandle::warm_planner_caches(
+  std::vector<std::size_t> goals,
+  std::optional<std::string> cache_file)
+{
+  _pimpl->worker.schedule(
+    [
+      w = weak_from_this(),
+      goals = std::move(goals),
+      cache_file = std::move(cache_file)
+    ](const auto&)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      self->_pimpl->planner_cache_warmer = PlannerCacheWarmer::make(
+        std::move(goals),
+        std::move(cache_file),
+        self->_pimpl->node->get_logger());
+
+      self->_pimpl->warm_planner_caches();
+    });
+
+  return *this;
+}
+
 //==============================================================================
 FleetUpdateHandle& FleetUpdateHandle::set_update_listener(
   std::function<void(const nlohmann::json&)> listener)
@@ -2041,6 +2489,8 @@ bool FleetUpdateHandle::set_task_planner_params(
 
         for (const auto& t : self->_pimpl->task_managers)
           t.first->task_planner(self->_pimpl->task_planner);
+
+        self->_pimpl->warm_planner_caches();
       });
 
     return true;
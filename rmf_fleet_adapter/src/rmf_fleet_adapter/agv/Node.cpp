@@ -20,6 +20,7 @@
 #include <rmf_fleet_adapter/StandardNames.hpp>
 #include <rmf_traffic_ros2/StandardNames.hpp>
 
+#include <rmf_traffic_ros2/Metrics.hpp>
 #include <rmf_traffic_ros2/Time.hpp>
 
 namespace rmf_fleet_adapter {
@@ -32,7 +33,7 @@ std::shared_ptr<Node> Node::make(
   const rclcpp::NodeOptions& options)
 {
   auto node = std::shared_ptr<Node>(
-    new Node(std::move(worker), node_name, options));
+    new Node(worker, node_name, options));
 
   auto default_qos = rclcpp::SystemDefaultsQoS();
   default_qos.keep_last(100);
@@ -106,6 +107,80 @@ std::shared_ptr<Node> Node::make(
     node->create_publisher<ApiResponse>(
     TaskApiResponses, transient_local_qos);
 
+  // Parse each request right away on the executor instead of having every
+  // robot parse it on its own, then pass it along to the robot it concerns.
+  node->_task_api_router = TaskApiRouter::make();
+  node->_task_api_router_sub = node->_task_api_request_obs->observe()
+    .subscribe(
+    [w = std::weak_ptr<Node>(node)](const ApiRequest::SharedPtr& request)
+    {
+      const auto self = w.lock();
+      if (!self)
+        return;
+
+      try
+      {
+        self->_task_api_router->route(request->json_msg, request->request_id);
+      }
+      catch (const std::exception& e)
+      {
+        RCLCPP_ERROR(
+          self->get_logger(),
+          "Error parsing json_msg: %s",
+          e.what());
+      }
+    });
+
+  // The timers of events and phases are mostly retries and resends on the
+  // order of a second, so this resolution is plenty.
+  // The wall timer that drives the wheel only runs while the wheel has timers
+  // in it.
+  node->_timer_wheel = TimerWheel::make(std::chrono::milliseconds(20));
+  node->_timer_wheel->on_active(
+    [w = std::weak_ptr<Node>(node)]()
+    {
+      if (const auto self = w.lock())
+        self->_start_timer_wheel_driver();
+    });
+
+  // Period, in seconds, for publishing the queueing delay and execution time
+  // of jobs. Zero turns off publishing.
+  const double job_metrics_period =
+    node->declare_parameter<double>("job_metrics_period", 10.0);
+  if (job_metrics_period > 0.0)
+  {
+    // Start observing every job before any of them get scheduled
+    get_job_metrics();
+
+    node->_job_metrics_pub = node->create_publisher<MetricsMessage>(
+      JobMetricsTopicName, rclcpp::SystemDefaultsQoS().reliable());
+
+    node->_job_metrics_window_start = node->rmf_now();
+    node->_job_metrics_timer = node->create_wall_timer(
+      std::chrono::duration<double>(job_metrics_period),
+      [w = std::weak_ptr<Node>(node)]()
+      {
+        if (const auto self = w.lock())
+          self->_publish_job_metrics();
+      });
+
+    // Most of the work of the fleet adapter is done by this worker, so we
+    // regularly measure how long a trivial job waits to get a turn on it.
+    node->_worker_probe_timer = node->create_wall_timer(
+      std::chrono::seconds(1),
+      [worker]()
+      {
+        using Clock = JobMetrics::clock_type;
+        static auto& category =
+          get_job_metrics().category("node_worker");
+        worker.schedule(
+          [queued = Clock::now()](const auto&)
+          {
+            category.queue_delay.record(Clock::now() - queued);
+          });
+      });
+  }
+
   return node;
 }
 
@@ -134,6 +209,108 @@ rmf_traffic::Time Node::rmf_now() const
   return rmf_traffic_ros2::convert(now());
 }
 
+//==============================================================================
+TimerWheel::TimerPtr Node::schedule_timer(
+  TimerWheel::Clock::duration period,
+  rxcpp::schedulers::worker worker,
+  TimerWheel::Callback callback)
+{
+  return _timer_wheel->schedule(
+    period, std::move(worker), std::move(callback));
+}
+
+//==============================================================================
+const std::shared_ptr<TaskApiRouter>& Node::task_api_router() const
+{
+  return _task_api_router;
+}
+
+//==============================================================================
+const std::shared_ptr<TimerWheel>& Node::timer_wheel() const
+{
+  return _timer_wheel;
+}
+
+//==============================================================================
+void Node::_start_timer_wheel_driver()
+{
+  std::lock_guard<std::mutex> lock(_timer_wheel_driver_mutex);
+  if (_timer_wheel_driver)
+    return;
+
+  _timer_wheel_driver = create_wall_timer(
+    _timer_wheel->resolution(),
+    [w = weak_from_this()]()
+    {
+      const auto self = std::static_pointer_cast<Node>(w.lock());
+      if (!self)
+        return;
+
+      self->_timer_wheel->advance();
+
+      // The size is checked while holding the driver mutex so that a timer
+      // which gets added right now will find the driver gone and start it
+      // again.
+      std::lock_guard<std::mutex> lock(self->_timer_wheel_driver_mutex);
+      if (self->_timer_wheel->size() == 0)
+        self->_timer_wheel_driver.reset();
+    });
+}
+
+//==============================================================================
+auto Node::job_metrics() const -> std::shared_ptr<const JobMetricsWindow>
+{
+  std::lock_guard<std::mutex> lock(_job_metrics_mutex);
+  return _job_metrics;
+}
+
+//==============================================================================
+void Node::_publish_job_metrics()
+{
+  auto window = std::make_shared<JobMetricsWindow>();
+  window->start = _job_metrics_window_start;
+  window->stop = rmf_now();
+  window->categories = get_job_metrics().take();
+  _job_metrics_window_start = window->stop;
+
+  const auto source = get_fully_qualified_name();
+  const auto start = rmf_traffic_ros2::convert(window->start);
+  const auto stop = rmf_traffic_ros2::convert(window->stop);
+  for (const auto& category : window->categories)
+  {
+    if (category.queue_delay.count > 0)
+    {
+      _job_metrics_pub->publish(
+        rmf_traffic_ros2::make_metrics_message(
+          source, category.name + "/queue_delay", "ns",
+          start, stop, category.queue_delay));
+    }
+
+    if (category.execution_time.count > 0)
+    {
+      _job_metrics_pub->publish(
+        rmf_traffic_ros2::make_metrics_message(
+          source, category.name + "/execution_time", "ns",
+          start, stop, category.execution_time));
+    }
+
+    if (category.alive.has_value())
+    {
+      JobMetrics::Summary alive;
+      alive.count = 1;
+      alive.sum = std::max<int64_t>(0, *category.alive);
+      alive.min = alive.sum;
+      alive.max = alive.sum;
+      _job_metrics_pub->publish(
+        rmf_traffic_ros2::make_metrics_message(
+          source, category.name + "/alive", "jobs", start, stop, alive));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(_job_metrics_mutex);
+  _job_metrics = std::move(window);
+}
+
 //==============================================================================
 auto Node::door_state() const -> const DoorStateObs&
 {
@@ -18,6 +18,10 @@
 #ifndef SRC__RMF_FLEET_ADAPTER__AGV__NODE_HPP
 #define SRC__RMF_FLEET_ADAPTER__AGV__NODE_HPP
 
+#include "TaskApiRouter.hpp"
+#include "TimerWheel.hpp"
+#include "../JobMetrics.hpp"
+
 #include <rmf_rxcpp/Transport.hpp>
 
 #include <rmf_dispenser_msgs/msg/dispenser_request.hpp>
@@ -33,6 +37,7 @@
 #include <rmf_lift_msgs/msg/lift_state.hpp>
 #include <rmf_task_msgs/msg/task_summary.hpp>
 #include <std_msgs/msg/bool.hpp>
+#include <statistics_msgs/msg/metrics_message.hpp>
 
 #include <rmf_fleet_msgs/msg/fleet_state.hpp>
 
@@ -41,6 +46,8 @@
 
 #include <rmf_traffic/Time.hpp>
 
+#include <mutex>
+
 namespace rmf_fleet_adapter {
 namespace agv {
 
@@ -118,6 +125,10 @@ public:
   using ApiRequestObs = rxcpp::observable<ApiRequest::SharedPtr>;
   const ApiRequestObs& task_api_request() const;
 
+  /// Every request on task_api_request() gets parsed once by this router and
+  /// handed to the recipients that it concerns.
+  const std::shared_ptr<TaskApiRouter>& task_api_router() const;
+
   using ApiResponse = rmf_task_msgs::msg::ApiResponse;
   using ApiResponsePub = rclcpp::Publisher<ApiResponse>::SharedPtr;
   const ApiResponsePub& task_api_response() const;
@@ -156,6 +167,30 @@ public:
     }
   }
 
+  /// Schedule a periodic timer whose callback will be run by the given worker.
+  /// All timers scheduled this way share one timer wheel, so the executor only
+  /// needs to wait on a single wall timer no matter how many robots there are.
+  /// The timer is cancelled when the returned handle is destroyed.
+  TimerWheel::TimerPtr schedule_timer(
+    TimerWheel::Clock::duration period,
+    rxcpp::schedulers::worker worker,
+    TimerWheel::Callback callback);
+
+  /// The timer wheel that schedule_timer() uses.
+  const std::shared_ptr<TimerWheel>& timer_wheel() const;
+
+  /// One window of the job metrics of this process
+  struct JobMetricsWindow
+  {
+    rmf_traffic::Time start;
+    rmf_traffic::Time stop;
+    std::vector<JobMetrics::CategorySummary> categories;
+  };
+
+  /// The most recent window of job metrics that was published on
+  /// JobMetricsTopicName, or nullptr if none has been published yet.
+  std::shared_ptr<const JobMetricsWindow> job_metrics() const;
+
 private:
 
   Node(
@@ -178,7 +213,22 @@ private:
   Bridge<IngestorState> _ingestor_state_obs;
   FleetStatePub _fleet_state_pub;
   Bridge<ApiRequest> _task_api_request_obs;
+  std::shared_ptr<TaskApiRouter> _task_api_router;
+  rxcpp::subscription _task_api_router_sub;
   ApiResponsePub _task_api_response_pub;
+  std::shared_ptr<TimerWheel> _timer_wheel;
+  void _start_timer_wheel_driver();
+  std::mutex _timer_wheel_driver_mutex;
+  rclcpp::TimerBase::SharedPtr _timer_wheel_driver;
+
+  void _publish_job_metrics();
+  using MetricsMessage = statistics_msgs::msg::MetricsMessage;
+  rclcpp::Publisher<MetricsMessage>::SharedPtr _job_metrics_pub;
+  rclcpp::TimerBase::SharedPtr _job_metrics_timer;
+  rclcpp::TimerBase::SharedPtr _worker_probe_timer;
+  rmf_traffic::Time _job_metrics_window_start;
+  mutable std::mutex _job_metrics_mutex;
+  std::shared_ptr<const JobMetricsWindow> _job_metrics;
 };
 
 } // namespace agv
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "PlannerCacheWarmer.hpp"
+
+#include <rmf_rxcpp/RxJobs.hpp>
+
+#include <rclcpp/logging.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+namespace {
+//==============================================================================
+template<typename T>
+void hash_combine(std::size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+} // anonymous namespace
+
+//==============================================================================
+std::shared_ptr<PlannerCacheWarmer> PlannerCacheWarmer::make(
+  std::vector<std::size_t> extra_goals,
+  std::optional<std::string> cache_file,
+  rclcpp::Logger logger)
+{
+  return std::shared_ptr<PlannerCacheWarmer>(
+    new PlannerCacheWarmer(
+      std::move(extra_goals), std::move(cache_file), std::move(logger)));
+}
+
+//==============================================================================
+PlannerCacheWarmer::PlannerCacheWarmer(
+  std::vector<std::size_t> extra_goals,
+  std::optional<std::string> cache_file,
+  rclcpp::Logger logger)
+: _extra_goals(std::move(extra_goals)),
+  _cache_file(std::move(cache_file)),
+  _logger(std::move(logger)),
+  _worker(
+    rmf_rxcpp::detail::get_planning_scheduler()
+    .get_scheduler(rmf_rxcpp::JobPriority::background).create_worker())
+{
+  // Do nothing
+}
+
+//==============================================================================
+void PlannerCacheWarmer::warm(PlannerPtr planner)
+{
+  if (!planner)
+    return;
+
+  const auto& graph = planner->get_configuration().graph();
+  const auto print = fingerprint(planner->get_configuration());
+
+  std::set<std::size_t> goal_set;
+  for (const auto wp : goals_of_interest(graph))
+    goal_set.insert(wp);
+
+  for (const auto wp : _extra_goals)
+  {
+    if (wp < graph.num_waypoints())
+      goal_set.insert(wp);
+  }
+
+  for (const auto wp : _load(print))
+  {
+    if (wp < graph.num_waypoints())
+      goal_set.insert(wp);
+  }
+
+  auto run = std::make_shared<Run>();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    run->generation = ++_generation;
+  }
+
+  run->planner = std::move(planner);
+  run->fingerprint = print;
+  run->goals.assign(goal_set.begin(), goal_set.end());
+  run->started = std::chrono::steady_clock::now();
+
+  // Every goal of interest doubles as a start for every other goal. Setting up
+  // a plan from all of them at once expands the shortest path tree of each
+  // goal across the parts of the graph that robots actually travel between.
+  const auto now = std::chrono::steady_clock::now();
+  for (const auto wp : run->goals)
+    run->starts.emplace_back(now, wp, 0.0);
+
+  _worker.schedule(
+    [w = weak_from_this(), run](const auto&)
+    {
+      if (const auto self = w.lock())
+        self->_step(run);
+    });
+}
+
+//==============================================================================
+std::string PlannerCacheWarmer::fingerprint(
+  const rmf_traffic::agv::Planner::Configuration& config)
+{
+  std::size_t seed = 0;
+
+  const auto& graph = config.graph();
+  hash_combine(seed, graph.num_waypoints());
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& wp = graph.get_waypoint(i);
+    hash_combine(seed, wp.get_map_name());
+    hash_combine(seed, wp.get_location().x());
+    hash_combine(seed, wp.get_location().y());
+  }
+
+  hash_combine(seed, graph.num_lanes());
+  const auto& closures = config.lane_closures();
+  for (std::size_t i = 0; i < graph.num_lanes(); ++i)
+  {
+    const auto& lane = graph.get_lane(i);
+    hash_combine(seed, lane.entry().waypoint_index());
+    hash_combine(seed, lane.exit().waypoint_index());
+    hash_combine(seed, closures.is_closed(i));
+  }
+
+  const auto& traits = config.vehicle_traits();
+  hash_combine(seed, traits.linear().get_nominal_velocity());
+  hash_combine(seed, traits.linear().get_nominal_acceleration());
+  hash_combine(seed, traits.rotational().get_nominal_velocity());
+  hash_combine(seed, traits.rotational().get_nominal_acceleration());
+  if (const auto& footprint = traits.profile().footprint())
+    hash_combine(seed, footprint->get_characteristic_length());
+
+  std::stringstream ss;
+  ss << std::hex << std::setw(16) << std::setfill('0') << seed;
+  return ss.str();
+}
+
+//==============================================================================
+std::vector<std::size_t> PlannerCacheWarmer::goals_of_interest(
+  const rmf_traffic::agv::Graph& graph)
+{
+  std::set<std::size_t> goals;
+  for (std::size_t i = 0; i < graph.num_waypoints(); ++i)
+  {
+    const auto& wp = graph.get_waypoint(i);
+    if (wp.is_charger() || wp.is_parking_spot() || wp.is_holding_point())
+      goals.insert(i);
+  }
+
+  // Pickup, dropoff and dock destinations are always named waypoints
+  for (const auto& [name, index] : graph.keys())
+    goals.insert(index);
+
+  return std::vector<std::size_t>(goals.begin(), goals.end());
+}
+
+//==============================================================================
+void PlannerCacheWarmer::_step(std::shared_ptr<Run> run)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (run->generation != _generation)
+    {
+      // A newer planner has replaced this one, so there is no point in warming
+      // it any further.
+      return;
+    }
+  }
+
+  if (run->next >= run->goals.size())
+    return _finish(*run);
+
+  const auto goal = run->goals[run->next++];
+  const auto setup = run->planner->setup(
+    run->starts, rmf_traffic::agv::Plan::Goal(goal));
+
+  if (!setup.ideal_cost().has_value())
+    ++run->disconnected;
+
+  // Warm one goal at a time so that any planning job of the robots can step in
+  // ahead of the next goal.
+  _worker.schedule(
+    [w = weak_from_this(), run](const auto&)
+    {
+      if (const auto self = w.lock())
+        self->_step(run);
+    });
+}
+
+//==============================================================================
+void PlannerCacheWarmer::_finish(const Run& run)
+{
+  const double seconds = rmf_traffic::time::to_seconds(
+    std::chrono::steady_clock::now() - run.started);
+
+  RCLCPP_INFO(
+    _logger,
+    "Finished warming planner caches for [%lu] goals in [%.3f] seconds. "
+    "[%lu] goals could not be reached from any other goal.",
+    run.goals.size(), seconds, run.disconnected);
+
+  _save(run);
+}
+
+//==============================================================================
+std::vector<std::size_t> PlannerCacheWarmer::_load(
+  const std::string& print) const
+{
+  if (!_cache_file.has_value())
+    return {};
+
+  try
+  {
+    const YAML::Node root = YAML::LoadFile(*_cache_file);
+    if (root["fingerprint"].as<std::string>() != print)
+    {
+      RCLCPP_INFO(
+        _logger,
+        "Ignoring planner cache manifest [%s] because the navigation graph or "
+        "vehicle traits have changed since it was saved.",
+        _cache_file->c_str());
+      return {};
+    }
+
+    return root["goals"].as<std::vector<std::size_t>>();
+  }
+  catch (const YAML::BadFile&)
+  {
+    // The manifest has not been saved yet
+  }
+  catch (const std::exception& e)
+  {
+    RCLCPP_WARN(
+      _logger,
+      "Failed to load planner cache manifest [%s]: %s",
+      _cache_file->c_str(), e.what());
+  }
+
+  return {};
+}
+
+//==============================================================================
+void PlannerCacheWarmer::_save(const Run& run) const
+{
+  if (!_cache_file.has_value())
+    return;
+
+  YAML::Node root;
+  root["fingerprint"] = run.fingerprint;
+  root["goals"] = run.goals;
+
+  std::ofstream output(*_cache_file);
+  if (!output)
+  {
+    RCLCPP_WARN(
+      _logger,
+      "Unable to write planner cache manifest to [%s]",
+      _cache_file->c_str());
+    return;
+  }
+
+  output << root;
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__PLANNERCACHEWARMER_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__PLANNERCACHEWARMER_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+
+#include <rclcpp/logger.hpp>
+
+#include <rxcpp/rx.hpp>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+/// Populates the heuristic and shortest path caches of a traffic planner in the
+/// background so that the first plans after a (re)start do not pay the full
+/// cost of a cold cache.
+///
+/// The caches themselves live inside rmf_traffic and cannot be exported, so
+/// what gets persisted is the warm-up manifest: the set of goals that were
+/// warmed, keyed by a fingerprint of the navigation graph, lane closures and
+/// vehicle traits. When the fingerprint of a new planner matches the saved
+/// manifest, every goal from the manifest gets warmed straight away.
+class PlannerCacheWarmer
+  : public std::enable_shared_from_this<PlannerCacheWarmer>
+{
+public:
+
+  using PlannerPtr = std::shared_ptr<const rmf_traffic::agv::Planner>;
+
+  static std::shared_ptr<PlannerCacheWarmer> make(
+    std::vector<std::size_t> extra_goals,
+    std::optional<std::string> cache_file,
+    rclcpp::Logger logger);
+
+  /// Begin warming the caches of the given planner. Any warm-up that is still
+  /// in progress for a previous planner will be abandoned.
+  void warm(PlannerPtr planner);
+
+  /// Compute a fingerprint for the graph, lane closures and vehicle traits of
+  /// a planner configuration.
+  static std::string fingerprint(
+    const rmf_traffic::agv::Planner::Configuration& config);
+
+  /// Get the default set of goals that are worth warming for a graph:
+  /// chargers, parking spots, holding points and named waypoints.
+  static std::vector<std::size_t> goals_of_interest(
+    const rmf_traffic::agv::Graph& graph);
+
+private:
+  PlannerCacheWarmer(
+    std::vector<std::size_t> extra_goals,
+    std::optional<std::string> cache_file,
+    rclcpp::Logger logger);
+
+  struct Run
+  {
+    std::size_t generation;
+    PlannerPtr planner;
+    std::string fingerprint;
+    rmf_traffic::agv::Plan::StartSet starts;
+    std::vector<std::size_t> goals;
+    std::size_t next = 0;
+    std::size_t disconnected = 0;
+    rmf_traffic::Time started;
+  };
+
+  void _step(std::shared_ptr<Run> run);
+
+  void _finish(const Run& run);
+
+  std::vector<std::size_t> _load(const std::string& fingerprint) const;
+
+  void _save(const Run& run) const;
+
+  std::vector<std::size_t> _extra_goals;
+  std::optional<std::string> _cache_file;
+  rclcpp::Logger _logger;
+  rxcpp::schedulers::worker _worker;
+
+  mutable std::mutex _mutex;
+  std::size_t _generation = 0;
+};
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__PLANNERCACHEWARMER_HPP
@@ -22,6 +22,8 @@
 
 #include <rmf_traffic_ros2/Time.hpp>
 
+#include <rmf_task_ros2/SchemaRegistry.hpp>
+
 #include <iostream>
 
 namespace rmf_fleet_adapter {
@@ -232,39 +234,15 @@ void RobotUpdateHandle::override_status(std::optional<std::string> status)
 
     if (status.has_value())
     {
-      // Here we capture [this] to avoid potential costly copy of
-      // schema_dictionary when more enties are inserted in the future.
-      // It is permissible here since the lambda will only be used within the
-      // scope of this function.
-      const auto loader =
-        [context, this](
-        const nlohmann::json_uri& id,
-        nlohmann::json& value)
-        {
-          const auto it = _pimpl->schema_dictionary.find(id.url());
-          if (it == _pimpl->schema_dictionary.end())
-          {
-            RCLCPP_ERROR(
-              context->node()->get_logger(),
-              "url: %s not found in schema dictionary. "
-              "Status for robot [%s] will not be overwritten.",
-              id.url().c_str(),
-              context->name().c_str());
-            return;
-          }
-
-          value = it->second;
-        };
-
       try
       {
         static const auto validator =
-          nlohmann::json_schema::json_validator(
-          rmf_api_msgs::schemas::robot_state, loader);
+          rmf_task_ros2::SchemaRegistry::global()->validator(
+          rmf_api_msgs::schemas::robot_state);
 
         nlohmann::json dummy_msg;
         dummy_msg["status"] = status.value();
-        validator.validate(dummy_msg);
+        validator->validate(dummy_msg);
 
       }
       catch (const std::exception& e)
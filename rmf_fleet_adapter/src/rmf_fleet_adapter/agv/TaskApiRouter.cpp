@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TaskApiRouter.hpp"
+
+#include <rmf_task_ros2/SchemaRegistry.hpp>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+struct TaskApiRouter::Recipient::Entry
+{
+  std::string fleet;
+  std::string robot;
+  rxcpp::schedulers::worker worker;
+  Callback callback;
+
+  // Requests that were handed to the worker before the recipient was removed
+  // get skipped.
+  std::atomic_bool removed = false;
+};
+
+namespace {
+//==============================================================================
+/// The field that names the task of each type of request that is about a
+/// single task, or nullptr if the type of request is not about a single task.
+const char* task_field(const std::string& type)
+{
+  static const std::unordered_map<std::string, const char*> fields = {
+    {"cancel_task_request", "task_id"},
+    {"kill_task_request", "task_id"},
+    {"interrupt_task_request", "task_id"},
+    {"resume_task_request", "for_task"},
+    {"rewind_task_request", "task_id"},
+    {"skip_phase_request", "task_id"},
+    {"undo_phase_skip_request", "for_task"}
+  };
+
+  const auto it = fields.find(type);
+  if (it == fields.end())
+    return nullptr;
+
+  return it->second;
+}
+
+//==============================================================================
+const std::string* find_string(
+  const nlohmann::json& json,
+  const char* field)
+{
+  const auto it = json.find(field);
+  if (it == json.end() || !it->is_string())
+    return nullptr;
+
+  return &it->get_ref<const std::string&>();
+}
+} // anonymous namespace
+
+//==============================================================================
+class TaskApiRouter::Implementation
+{
+public:
+
+  using EntryPtr = std::shared_ptr<Recipient::Entry>;
+  using RobotKey = std::pair<std::string, std::string>;
+
+  mutable std::mutex mutex;
+  std::unordered_set<EntryPtr> recipients;
+  std::map<RobotKey, EntryPtr> robots;
+  std::unordered_map<std::string, EntryPtr> tasks;
+
+  std::vector<EntryPtr> recipients_of(const nlohmann::json& request) const
+  {
+    const auto* type = find_string(request, "type");
+    if (!type)
+      return {};
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (*type == "robot_task_request")
+    {
+      const auto* fleet = find_string(request, "fleet");
+      const auto* robot = find_string(request, "robot");
+      if (!fleet || !robot)
+        return any();
+
+      const auto it = robots.find({*fleet, *robot});
+      if (it == robots.end())
+        return {};
+
+      return {it->second};
+    }
+
+    const char* field = task_field(*type);
+    if (!field)
+      return {};
+
+    const auto* task_id = find_string(request, field);
+    if (!task_id)
+      return any();
+
+    const auto it = tasks.find(*task_id);
+    if (it == tasks.end())
+      return {};
+
+    return {it->second};
+  }
+
+private:
+  std::vector<EntryPtr> any() const
+  {
+    if (recipients.empty())
+      return {};
+
+    return {*recipients.begin()};
+  }
+};
+
+//==============================================================================
+std::shared_ptr<TaskApiRouter> TaskApiRouter::make()
+{
+  return std::shared_ptr<TaskApiRouter>(new TaskApiRouter);
+}
+
+//==============================================================================
+TaskApiRouter::TaskApiRouter()
+: _pimpl(std::make_unique<Implementation>())
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto TaskApiRouter::add_recipient(
+  std::string fleet,
+  std::string robot,
+  rxcpp::schedulers::worker worker,
+  Callback callback) -> RecipientPtr
+{
+  auto entry = std::make_shared<Recipient::Entry>();
+  entry->fleet = std::move(fleet);
+  entry->robot = std::move(robot);
+  entry->worker = std::move(worker);
+  entry->callback = std::move(callback);
+
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->mutex);
+    _pimpl->recipients.insert(entry);
+    _pimpl->robots[{entry->fleet, entry->robot}] = entry;
+  }
+
+  return RecipientPtr(new Recipient(std::move(entry), weak_from_this()));
+}
+
+//==============================================================================
+std::size_t TaskApiRouter::route(
+  const std::string& json_msg,
+  const std::string& request_id)
+{
+  // Requests that no robot handles, like the ones for the dispatcher, are
+  // dropped without parsing the rest of the message.
+  if (const auto type = rmf_task_ros2::peek_message_type(json_msg))
+  {
+    if (*type != "robot_task_request" && !task_field(*type))
+      return 0;
+  }
+
+  return route(
+    std::make_shared<const nlohmann::json>(nlohmann::json::parse(json_msg)),
+    request_id);
+}
+
+//==============================================================================
+std::size_t TaskApiRouter::route(
+  std::shared_ptr<const nlohmann::json> request,
+  const std::string& request_id)
+{
+  const auto recipients = _pimpl->recipients_of(*request);
+  for (const auto& entry : recipients)
+  {
+    entry->worker.schedule(
+      [entry, request, request_id](const auto&)
+      {
+        if (entry->removed)
+          return;
+
+        entry->callback(*request, request_id);
+      });
+  }
+
+  return recipients.size();
+}
+
+//==============================================================================
+std::size_t TaskApiRouter::recipients() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->mutex);
+  return _pimpl->recipients.size();
+}
+
+//==============================================================================
+std::size_t TaskApiRouter::claimed_tasks() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->mutex);
+  return _pimpl->tasks.size();
+}
+
+//==============================================================================
+TaskApiRouter::Recipient::Recipient(
+  std::shared_ptr<Entry> entry,
+  std::weak_ptr<TaskApiRouter> router)
+: _entry(std::move(entry)),
+  _router(std::move(router))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void TaskApiRouter::Recipient::claim(const std::string& task_id)
+{
+  const auto router = _router.lock();
+  if (!router)
+    return;
+
+  auto& impl = *router->_pimpl;
+  std::lock_guard<std::mutex> lock(impl.mutex);
+  impl.tasks[task_id] = _entry;
+}
+
+//==============================================================================
+void TaskApiRouter::Recipient::release(const std::string& task_id)
+{
+  const auto router = _router.lock();
+  if (!router)
+    return;
+
+  auto& impl = *router->_pimpl;
+  std::lock_guard<std::mutex> lock(impl.mutex);
+  const auto it = impl.tasks.find(task_id);
+  if (it != impl.tasks.end() && it->second == _entry)
+    impl.tasks.erase(it);
+}
+
+//==============================================================================
+TaskApiRouter::Recipient::~Recipient()
+{
+  _entry->removed = true;
+
+  const auto router = _router.lock();
+  if (!router)
+    return;
+
+  auto& impl = *router->_pimpl;
+  std::lock_guard<std::mutex> lock(impl.mutex);
+  impl.recipients.erase(_entry);
+
+  const auto robot_it = impl.robots.find({_entry->fleet, _entry->robot});
+  if (robot_it != impl.robots.end() && robot_it->second == _entry)
+    impl.robots.erase(robot_it);
+
+  for (auto it = impl.tasks.begin(); it != impl.tasks.end(); )
+  {
+    if (it->second == _entry)
+      it = impl.tasks.erase(it);
+    else
+      ++it;
+  }
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
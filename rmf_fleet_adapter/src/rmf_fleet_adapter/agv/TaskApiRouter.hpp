@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__TASKAPIROUTER_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__TASKAPIROUTER_HPP
+
+#include <rxcpp/rx.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+/// Hands each task API request to the recipients that it concerns, so that a
+/// request only gets parsed once no matter how many robots are in the fleet
+/// adapter.
+///
+/// Requests about a task go to the recipient that has claimed that task.
+/// Robot task requests go to the recipient of the robot that they name.
+/// Requests that cannot be routed because they are missing those fields go to
+/// a single recipient, which is enough to report the validation error. Any
+/// other request is not meant for a recipient and gets dropped.
+class TaskApiRouter : public std::enable_shared_from_this<TaskApiRouter>
+{
+public:
+
+  using Callback = std::function<
+    void(const nlohmann::json& request, const std::string& request_id)>;
+
+  class Recipient;
+  using RecipientPtr = std::shared_ptr<Recipient>;
+
+  static std::shared_ptr<TaskApiRouter> make();
+
+  /// Add a recipient for the requests about one robot and about the tasks that
+  /// it claims. The callback gets scheduled on the worker, so it runs in the
+  /// same thread context as the rest of the object that owns the recipient.
+  /// The recipient is removed when the returned handle is destroyed.
+  RecipientPtr add_recipient(
+    std::string fleet,
+    std::string robot,
+    rxcpp::schedulers::worker worker,
+    Callback callback);
+
+  /// Parse a request and hand it to the recipients that it concerns. The type
+  /// of the request is checked first, so requests that no recipient would
+  /// ever get are dropped without being parsed.
+  ///
+  /// \throws nlohmann::json::parse_error if the message is not valid json.
+  ///
+  /// \return the number of recipients that the request was handed to.
+  std::size_t route(const std::string& json_msg, const std::string& request_id);
+
+  /// Hand a request that has already been parsed to the recipients that it
+  /// concerns.
+  ///
+  /// \return the number of recipients that the request was handed to.
+  std::size_t route(
+    std::shared_ptr<const nlohmann::json> request,
+    const std::string& request_id);
+
+  /// The number of recipients that have been added and not removed.
+  std::size_t recipients() const;
+
+  /// The number of tasks that are currently claimed by a recipient.
+  std::size_t claimed_tasks() const;
+
+  class Implementation;
+private:
+  TaskApiRouter();
+  std::unique_ptr<Implementation> _pimpl;
+};
+
+//==============================================================================
+/// A handle for a recipient of a TaskApiRouter. Destroying the handle removes
+/// the recipient and releases all of its tasks.
+class TaskApiRouter::Recipient
+{
+public:
+
+  /// Route the requests about this task to this recipient. If another
+  /// recipient had claimed the task, it will stop receiving its requests.
+  void claim(const std::string& task_id);
+
+  /// Stop routing the requests about this task to this recipient. Nothing
+  /// happens if another recipient has claimed the task since.
+  void release(const std::string& task_id);
+
+  ~Recipient();
+
+  struct Entry;
+private:
+  friend class TaskApiRouter;
+  Recipient(std::shared_ptr<Entry> entry, std::weak_ptr<TaskApiRouter> router);
+  std::shared_ptr<Entry> _entry;
+  std::weak_ptr<TaskApiRouter> _router;
+};
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__TASKAPIROUTER_HPP
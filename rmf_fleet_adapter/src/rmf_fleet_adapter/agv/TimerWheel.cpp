@@ -0,0 +1,395 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "TimerWheel.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+struct TimerWheel::Timer::Entry
+{
+  uint64_t period_ticks;
+  rxcpp::schedulers::worker worker;
+  Callback callback;
+
+  std::atomic_bool canceled = false;
+
+  // True while a trigger is waiting on the worker
+  std::atomic_bool pending = false;
+
+  // These fields are guarded by the mutex of the wheel
+  uint64_t due_tick = 0;
+  uint64_t placed_tick = 0;
+  uint64_t generation = 0;
+  bool in_wheel = false;
+};
+
+//==============================================================================
+class TimerWheel::Implementation
+{
+public:
+
+  // Each level of the wheel has 64 slots, and each slot of a level spans all
+  // 64 slots of the level below it. Four levels cover 2^24 ticks, which is
+  // several days at any sensible resolution. Timers beyond that are parked in
+  // the last slot and reinserted when it comes around.
+  static constexpr uint64_t SlotBits = 6;
+  static constexpr uint64_t SlotsPerLevel = uint64_t(1) << SlotBits;
+  static constexpr uint64_t SlotMask = SlotsPerLevel - 1;
+  static constexpr std::size_t NumLevels = 4;
+  static constexpr uint64_t MaxDelta = uint64_t(1) << (SlotBits * NumLevels);
+
+  using EntryPtr = std::shared_ptr<Timer::Entry>;
+
+  struct Item
+  {
+    EntryPtr entry;
+
+    // Resetting a timer to an earlier tick than where it is placed leaves a
+    // stale item behind. The generation lets us recognize and drop it.
+    uint64_t generation;
+  };
+
+  using Slot = std::vector<Item>;
+
+  Implementation(Clock::duration resolution_, Clock::time_point start_)
+  : resolution(resolution_),
+    start(start_)
+  {
+    // Do nothing
+  }
+
+  uint64_t ticks_of(Clock::duration d) const
+  {
+    const auto count = d.count();
+    const auto r = resolution.count();
+    if (count <= r)
+      return 1;
+
+    return static_cast<uint64_t>((count + r - 1) / r);
+  }
+
+  uint64_t tick_at(Clock::time_point t) const
+  {
+    if (t <= start)
+      return 0;
+
+    return static_cast<uint64_t>((t - start) / resolution);
+  }
+
+  /// The tick that new countdowns should start from. The caller must hold the
+  /// mutex.
+  uint64_t now_tick() const
+  {
+    return std::max(current_tick, tick_at(Clock::now()));
+  }
+
+  /// Put an entry into the slot of its due tick, but no earlier than the
+  /// given tick. The caller must hold the mutex.
+  void insert(const EntryPtr& entry, uint64_t earliest)
+  {
+    uint64_t due = std::max(entry->due_tick, earliest);
+    uint64_t delta = due - current_tick;
+    if (delta >= MaxDelta)
+    {
+      due = current_tick + MaxDelta - 1;
+      delta = MaxDelta - 1;
+    }
+
+    std::size_t level = 0;
+    while (level + 1 < NumLevels
+      && delta >= (uint64_t(1) << (SlotBits*(level+1))))
+    {
+      ++level;
+    }
+
+    entry->placed_tick = due;
+    const auto index = (due >> (SlotBits*level)) & SlotMask;
+    levels[level][index].push_back(Item{entry, entry->generation});
+  }
+
+  /// Put an entry into the wheel somewhere after the current tick. The caller
+  /// must hold the mutex.
+  void insert(const EntryPtr& entry)
+  {
+    insert(entry, current_tick + 1);
+  }
+
+  /// Count an entry that is being added to the wheel. This returns true if the
+  /// wheel was empty before. The caller must hold the mutex.
+  bool add(Timer::Entry& entry)
+  {
+    entry.in_wheel = true;
+    if (count++ > 0)
+      return false;
+
+    // Nothing has been advancing an empty wheel, so skip the ticks that it
+    // slept through instead of stepping through each of them later. There are
+    // no live items in any slot that this could skip over.
+    current_tick = now_tick();
+    return true;
+  }
+
+  /// Move every live item of a slot down to where it belongs now. The caller
+  /// must hold the mutex.
+  void cascade(std::size_t level)
+  {
+    const auto index = (current_tick >> (SlotBits*level)) & SlotMask;
+    Slot items;
+    std::swap(items, levels[level][index]);
+    for (auto& item : items)
+    {
+      if (item.generation != item.entry->generation)
+        continue;
+
+      if (item.entry->canceled)
+      {
+        drop(*item.entry);
+        continue;
+      }
+
+      // The cascade happens on the first tick of the slot, which might be the
+      // tick that this item is due at. The slot for the current tick of the
+      // lowest level gets visited right after the cascades, so the item can
+      // still trigger on time.
+      insert(item.entry, current_tick);
+    }
+  }
+
+  void drop(Timer::Entry& entry)
+  {
+    entry.in_wheel = false;
+    --count;
+  }
+
+  Clock::duration resolution;
+  Clock::time_point start;
+
+  mutable std::mutex mutex;
+  uint64_t current_tick = 0;
+  std::size_t count = 0;
+  Callback on_active;
+  std::array<std::array<Slot, SlotsPerLevel>, NumLevels> levels;
+};
+
+//==============================================================================
+std::shared_ptr<TimerWheel> TimerWheel::make(
+  Clock::duration resolution,
+  Clock::time_point start)
+{
+  return std::shared_ptr<TimerWheel>(new TimerWheel(resolution, start));
+}
+
+//==============================================================================
+TimerWheel::TimerWheel(Clock::duration resolution, Clock::time_point start)
+: _pimpl(std::make_unique<Implementation>(resolution, start))
+{
+  // Do nothing
+}
+
+//==============================================================================
+auto TimerWheel::schedule(
+  Clock::duration period,
+  rxcpp::schedulers::worker worker,
+  Callback callback) -> TimerPtr
+{
+  auto entry = std::make_shared<Timer::Entry>();
+  entry->period_ticks = _pimpl->ticks_of(period);
+  entry->worker = std::move(worker);
+  entry->callback = std::move(callback);
+
+  Callback on_active;
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->mutex);
+    if (_pimpl->add(*entry))
+      on_active = _pimpl->on_active;
+
+    entry->due_tick = _pimpl->now_tick() + entry->period_ticks;
+    _pimpl->insert(entry);
+  }
+
+  if (on_active)
+    on_active();
+
+  return TimerPtr(new Timer(std::move(entry), weak_from_this()));
+}
+
+//==============================================================================
+void TimerWheel::advance(Clock::time_point now)
+{
+  using Impl = Implementation;
+  std::vector<Impl::EntryPtr> triggered;
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->mutex);
+    const auto target = _pimpl->tick_at(now);
+    while (_pimpl->current_tick < target)
+    {
+      const auto tick = ++_pimpl->current_tick;
+
+      // When the lower levels wrap around, the next slot of each higher level
+      // gets distributed down. Higher levels go first so that their items can
+      // land in the slots that are cascaded after them.
+      std::size_t top = 0;
+      while (top + 1 < Impl::NumLevels
+        && (tick & ((uint64_t(1) << (Impl::SlotBits*(top+1))) - 1)) == 0)
+      {
+        ++top;
+      }
+
+      for (std::size_t level = top; level > 0; --level)
+        _pimpl->cascade(level);
+
+      Impl::Slot items;
+      std::swap(items, _pimpl->levels[0][tick & Impl::SlotMask]);
+      for (auto& item : items)
+      {
+        auto& entry = item.entry;
+        if (item.generation != entry->generation)
+          continue;
+
+        if (entry->canceled)
+        {
+          _pimpl->drop(*entry);
+          continue;
+        }
+
+        if (tick < entry->due_tick)
+        {
+          // This timer was reset after it was placed
+          _pimpl->insert(entry);
+          continue;
+        }
+
+        triggered.push_back(entry);
+        entry->due_tick += entry->period_ticks;
+        if (entry->due_tick <= tick)
+          entry->due_tick = tick + entry->period_ticks;
+
+        _pimpl->insert(entry);
+      }
+    }
+  }
+
+  // The callbacks are handed to the workers without holding the mutex in case
+  // a worker runs them immediately and they touch their own timer.
+  for (const auto& entry : triggered)
+  {
+    if (entry->pending.exchange(true))
+      continue;
+
+    entry->worker.schedule(
+      [entry](const auto&)
+      {
+        entry->pending = false;
+        if (!entry->canceled)
+          entry->callback();
+      });
+  }
+}
+
+//==============================================================================
+void TimerWheel::on_active(Callback callback)
+{
+  std::lock_guard<std::mutex> lock(_pimpl->mutex);
+  _pimpl->on_active = std::move(callback);
+}
+
+//==============================================================================
+auto TimerWheel::resolution() const -> Clock::duration
+{
+  return _pimpl->resolution;
+}
+
+//==============================================================================
+std::size_t TimerWheel::size() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->mutex);
+  return _pimpl->count;
+}
+
+//==============================================================================
+TimerWheel::Timer::Timer(
+  std::shared_ptr<Entry> entry,
+  std::weak_ptr<TimerWheel> wheel)
+: _entry(std::move(entry)),
+  _wheel(std::move(wheel))
+{
+  // Do nothing
+}
+
+//==============================================================================
+void TimerWheel::Timer::cancel()
+{
+  _entry->canceled = true;
+}
+
+//==============================================================================
+bool TimerWheel::Timer::is_canceled() const
+{
+  return _entry->canceled;
+}
+
+//==============================================================================
+void TimerWheel::Timer::reset()
+{
+  const auto wheel = _wheel.lock();
+  if (!wheel)
+    return;
+
+  auto& impl = *wheel->_pimpl;
+  Callback on_active;
+  {
+    std::lock_guard<std::mutex> lock(impl.mutex);
+    _entry->canceled = false;
+    if (!_entry->in_wheel)
+    {
+      if (impl.add(*_entry))
+        on_active = impl.on_active;
+
+      _entry->due_tick = impl.now_tick() + _entry->period_ticks;
+      ++_entry->generation;
+      impl.insert(_entry);
+    }
+    else
+    {
+      _entry->due_tick = impl.now_tick() + _entry->period_ticks;
+      if (_entry->due_tick < _entry->placed_tick)
+      {
+        ++_entry->generation;
+        impl.insert(_entry);
+      }
+    }
+  }
+
+  if (on_active)
+    on_active();
+}
+
+//==============================================================================
+TimerWheel::Timer::~Timer()
+{
+  cancel();
+}
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__TIMERWHEEL_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__TIMERWHEEL_HPP
+
+#include <rxcpp/rx.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+/// A hierarchical timer wheel that lets any number of periodic timers share a
+/// single clock source. Each timer has a worker that its callback gets
+/// scheduled on, so callbacks run in the same thread context as the rest of
+/// the object that owns the timer.
+///
+/// Scheduling, resetting and cancelling a timer are all constant time. The
+/// wheel itself needs to be advanced by calling advance(), typically from a
+/// single wall timer that runs at the resolution of the wheel. That wall timer
+/// only needs to run while size() is above zero, and on_active() can be used
+/// to find out when it needs to start again.
+class TimerWheel : public std::enable_shared_from_this<TimerWheel>
+{
+public:
+
+  using Clock = std::chrono::steady_clock;
+  using Callback = std::function<void()>;
+
+  class Timer;
+  using TimerPtr = std::shared_ptr<Timer>;
+
+  /// Make a timer wheel
+  ///
+  /// \param[in] resolution
+  ///   The duration of one tick of the wheel. Timers will fire on the first
+  ///   tick after they are due.
+  ///
+  /// \param[in] start
+  ///   The time of the first tick of the wheel.
+  static std::shared_ptr<TimerWheel> make(
+    Clock::duration resolution,
+    Clock::time_point start = Clock::now());
+
+  /// Schedule a timer that triggers every period until it is cancelled or the
+  /// returned handle is destroyed. Similar to an rclcpp timer, the first
+  /// trigger happens one period after the timer is scheduled.
+  ///
+  /// If the previous trigger of a timer has not been run by its worker yet,
+  /// the next trigger will be skipped instead of piling up on the worker.
+  TimerPtr schedule(
+    Clock::duration period,
+    rxcpp::schedulers::worker worker,
+    Callback callback);
+
+  /// Advance the wheel up to the given time, triggering every timer that has
+  /// become due.
+  void advance(Clock::time_point now = Clock::now());
+
+  /// Set a callback that gets triggered whenever a timer is added to a wheel
+  /// that had no timers in it. The callback is run by whichever thread added
+  /// the timer, after the wheel has been unlocked.
+  void on_active(Callback callback);
+
+  /// The duration of one tick of the wheel.
+  Clock::duration resolution() const;
+
+  /// The number of timers that are currently in the wheel. Cancelled timers
+  /// are only removed when the wheel reaches their slot, so they might still
+  /// be counted for a while.
+  std::size_t size() const;
+
+  class Implementation;
+private:
+  TimerWheel(Clock::duration resolution, Clock::time_point start);
+  std::unique_ptr<Implementation> _pimpl;
+};
+
+//==============================================================================
+/// A handle for a timer in a TimerWheel. Destroying the handle cancels the
+/// timer.
+class TimerWheel::Timer
+{
+public:
+
+  /// Stop triggering this timer. A trigger that has already been handed to the
+  /// worker will be skipped.
+  void cancel();
+
+  /// True if cancel() has been called and the timer has not been reset since.
+  bool is_canceled() const;
+
+  /// Restart the countdown of this timer so that the next trigger happens one
+  /// full period from now. This also reactivates a cancelled timer.
+  void reset();
+
+  ~Timer();
+
+  struct Entry;
+private:
+  friend class TimerWheel;
+  Timer(std::shared_ptr<Entry> entry, std::weak_ptr<TimerWheel> wheel);
+  std::shared_ptr<Entry> _entry;
+  std::weak_ptr<TimerWheel> _wheel;
+};
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__TIMERWHEEL_HPP
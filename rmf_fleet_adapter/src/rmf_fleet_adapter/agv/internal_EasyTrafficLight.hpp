@@ -53,7 +53,7 @@ public:
   struct NegotiateManagers
   {
     rmf_rxcpp::subscription_guard subscription;
-    rclcpp::TimerBase::SharedPtr timer;
+    TimerWheel::TimerPtr timer;
   };
   using NegotiatePtr = std::shared_ptr<services::Negotiate>;
   using NegotiateServiceMap =
@@ -140,7 +140,7 @@ public:
     rmf_traffic::agv::VehicleTraits traits;
     std::shared_ptr<const rmf_traffic::Profile> profile;
     rclcpp::Publisher<FleetState>::SharedPtr fleet_state_pub;
-    rclcpp::TimerBase::SharedPtr fleet_update_timer;
+    TimerWheel::TimerPtr fleet_update_timer;
   };
 
   struct Shared : public std::enable_shared_from_this<Shared>
@@ -163,11 +163,40 @@ public:
 
     Shared(Hooks hooks);
 
-    void follow_new_path(const std::vector<Waypoint>& new_path);
+    using SnapshotPtr =
+      std::shared_ptr<const rmf_traffic::schedule::Snapshot>;
+
+    /// Takes a snapshot of the schedule the first time that a plan needs one,
+    /// so that a batch of updates never takes more than one.
+    class LazySnapshot
+    {
+    public:
+      LazySnapshot(
+        std::shared_ptr<const rmf_traffic::schedule::Mirror> schedule,
+        SnapshotPtr snapshot = nullptr);
+
+      SnapshotPtr get();
+
+    private:
+      std::shared_ptr<const rmf_traffic::schedule::Mirror> _schedule;
+      SnapshotPtr _snapshot;
+    };
+
+    /// If a snapshot is given, the plan will be found against it instead of
+    /// against a new snapshot of the schedule.
+    void follow_new_path(
+      const std::vector<Waypoint>& new_path,
+      SnapshotPtr snapshot = nullptr);
 
     void make_plan(
       std::size_t request_path_version,
-      rmf_traffic::agv::Plan::Start start);
+      rmf_traffic::agv::Plan::Start start,
+      SnapshotPtr snapshot = nullptr);
+
+    void make_plan(
+      std::size_t request_path_version,
+      rmf_traffic::agv::Plan::Start start,
+      LazySnapshot& snapshot);
 
     std::optional<rmf_traffic::schedule::ItineraryVersion> receive_plan(
       std::size_t request_path_version,
@@ -190,11 +219,14 @@ public:
 
     bool consider_proposal(
       std::size_t checkpoint,
-      std::optional<Eigen::Vector3d> location);
+      std::optional<Eigen::Vector3d> location,
+      LazySnapshot& snapshot);
 
-    bool finish_immediate_stop();
+    bool finish_immediate_stop(LazySnapshot& snapshot);
 
-    bool check_if_ready(std::size_t to_move_past_checkpoint);
+    bool check_if_ready(
+      std::size_t to_move_past_checkpoint,
+      LazySnapshot& snapshot);
 
     MovingInstruction moving_from(
       std::size_t checkpoint,
@@ -206,6 +238,23 @@ public:
       std::size_t checkpoint,
       Eigen::Vector3d location);
 
+    // These overloads are for batches of updates. The caller must already
+    // hold the lock, and any plans that are needed are found against the
+    // given snapshot.
+    MovingInstruction moving_from(
+      std::size_t checkpoint,
+      Eigen::Vector3d location,
+      LazySnapshot& snapshot);
+
+    WaitingInstruction waiting_at(
+      std::size_t checkpoint,
+      LazySnapshot& snapshot);
+
+    WaitingInstruction waiting_after(
+      std::size_t checkpoint,
+      Eigen::Vector3d location,
+      LazySnapshot& snapshot);
+
     void update_idle_location(
       std::string map_name,
       Eigen::Vector3d position);
@@ -237,6 +286,11 @@ public:
 
   std::shared_ptr<Shared> shared;
 
+  static Implementation& get(EasyTrafficLight& handle)
+  {
+    return *handle._pimpl;
+  }
+
   static EasyTrafficLightPtr make(
     std::function<void()> pause_,
     std::function<void()> resume_,
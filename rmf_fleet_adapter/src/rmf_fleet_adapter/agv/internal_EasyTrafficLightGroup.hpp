@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__AGV__INTERNAL_EASYTRAFFICLIGHTGROUP_HPP
+#define SRC__RMF_FLEET_ADAPTER__AGV__INTERNAL_EASYTRAFFICLIGHTGROUP_HPP
+
+#include <rmf_fleet_adapter/agv/EasyTrafficLightGroup.hpp>
+
+#include "internal_EasyTrafficLight.hpp"
+
+#include <mutex>
+
+namespace rmf_fleet_adapter {
+namespace agv {
+
+//==============================================================================
+class EasyTrafficLightGroup::Implementation
+{
+public:
+
+  /// Collects the commands that the traffic lights of the group issue, and
+  /// hands them to the command callback together once the worker is free.
+  class Commands : public std::enable_shared_from_this<Commands>
+  {
+  public:
+
+    Commands(CommandCallback callback, rxcpp::schedulers::worker worker);
+
+    void push(std::size_t robot, Command command);
+
+  private:
+    void flush();
+
+    CommandCallback _callback;
+    rxcpp::schedulers::worker _worker;
+    std::mutex _mutex;
+    std::vector<RobotCommand> _pending;
+  };
+
+  std::vector<EasyTrafficLightPtr> lights;
+  std::shared_ptr<Commands> commands;
+  std::shared_ptr<const rmf_traffic::schedule::Mirror> schedule;
+  rxcpp::schedulers::worker worker;
+
+  EasyTrafficLight::Implementation::Shared& shared(std::size_t robot);
+
+  using RobotLock = std::unique_lock<std::recursive_mutex>;
+
+  /// Lock every robot that is named in a batch of updates. The robots are
+  /// always locked in order of their index, so two batches can never wait on
+  /// each other.
+  ///
+  /// \throws std::out_of_range if any robot index is not in the group, in
+  /// which case no robot is left locked.
+  std::vector<RobotLock> lock(std::vector<std::size_t> robots);
+
+  static EasyTrafficLightGroupPtr make(
+    CommandCallback command_callback_,
+    DeadlockCallback deadlock_callback_,
+    std::shared_ptr<const rmf_traffic::schedule::Mirror> schedule_,
+    rxcpp::schedulers::worker worker_,
+    std::shared_ptr<Node> node_,
+    rmf_traffic::agv::VehicleTraits traits_,
+    std::vector<rmf_traffic::schedule::Participant> itineraries_,
+    std::shared_ptr<rmf_traffic_ros2::blockade::Writer> blockade_writer_,
+    rmf_traffic_ros2::schedule::Negotiation* negotiation_);
+};
+
+} // namespace agv
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__AGV__INTERNAL_EASYTRAFFICLIGHTGROUP_HPP
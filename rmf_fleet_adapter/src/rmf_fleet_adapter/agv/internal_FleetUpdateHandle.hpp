@@ -20,6 +20,7 @@
 
 #include <rmf_task_msgs/msg/loop.hpp>
 
+#include <rmf_task_ros2/SchemaRegistry.hpp>
 #include <rmf_task_ros2/bidding/AsyncBidder.hpp>
 
 #include <rmf_task_msgs/msg/dispatch_command.hpp>
@@ -44,6 +45,7 @@
 #include <rmf_fleet_adapter/StandardNames.hpp>
 
 #include "Node.hpp"
+#include "PlannerCacheWarmer.hpp"
 #include "RobotContext.hpp"
 #include "../TaskManager.hpp"
 #include "../DeserializeJSON.hpp"
@@ -61,12 +63,7 @@
 #include <nlohmann/json.hpp>
 #include <nlohmann/json-schema.hpp>
 #include <rmf_api_msgs/schemas/fleet_state_update.hpp>
-#include <rmf_api_msgs/schemas/fleet_state.hpp>
-#include <rmf_api_msgs/schemas/robot_state.hpp>
-#include <rmf_api_msgs/schemas/location_2D.hpp>
 #include <rmf_api_msgs/schemas/fleet_log_update.hpp>
-#include <rmf_api_msgs/schemas/fleet_log.hpp>
-#include <rmf_api_msgs/schemas/log_entry.hpp>
 
 #include <rmf_fleet_adapter/schemas/event_description__perform_action.hpp>
 
@@ -171,11 +168,17 @@ class ParticipantFactory
 public:
 
   using ReadyCallback = std::function<void(rmf_traffic::schedule::Participant)>;
+  using ReadyCallbacks =
+    std::function<void(std::vector<rmf_traffic::schedule::Participant>)>;
 
   virtual void async_make_participant(
     rmf_traffic::schedule::ParticipantDescription description,
     ReadyCallback ready_callback) = 0;
 
+  virtual void async_make_participants(
+    std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions,
+    ReadyCallbacks ready_callback) = 0;
+
   virtual ~ParticipantFactory() = default;
 };
 
@@ -203,6 +206,24 @@ public:
     );
   }
 
+  void async_make_participants(
+    std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions,
+    ReadyCallbacks ready_callback) final
+  {
+    std::vector<rmf_traffic::schedule::Participant> participants;
+    participants.reserve(descriptions.size());
+    for (auto& description : descriptions)
+    {
+      participants.push_back(
+        rmf_traffic::schedule::make_participant(
+          std::move(description),
+          _writer,
+          nullptr));
+    }
+
+    ready_callback(std::move(participants));
+  }
+
 private:
   std::shared_ptr<rmf_traffic::schedule::Writer> _writer;
 };
@@ -228,6 +249,15 @@ public:
       std::move(ready_callback));
   }
 
+  void async_make_participants(
+    std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions,
+    ReadyCallbacks ready_callback) final
+  {
+    _writer->async_make_participants(
+      std::move(descriptions),
+      std::move(ready_callback));
+  }
+
 private:
   rmf_traffic_ros2::schedule::WriterPtr _writer;
 };
@@ -260,6 +290,9 @@ public:
   std::shared_ptr<rmf_task::Parameters> task_parameters = nullptr;
   std::shared_ptr<rmf_task::TaskPlanner> task_planner = nullptr;
 
+  // Warms the traffic planner caches whenever the planner gets rebuilt
+  std::shared_ptr<PlannerCacheWarmer> planner_cache_warmer = nullptr;
+
   rmf_utils::optional<rmf_traffic::Duration> default_maximum_delay =
     std::chrono::nanoseconds(std::chrono::seconds(10));
 
@@ -268,8 +301,6 @@ public:
     std::shared_ptr<TaskManager>> task_managers = {};
 
   std::shared_ptr<rmf_websocket::BroadcastClient> broadcast_client = nullptr;
-  // Map uri to schema for validator loader function
-  std::unordered_map<std::string, nlohmann::json> schema_dictionary = {};
 
   rclcpp::Publisher<rmf_fleet_msgs::msg::FleetState>::SharedPtr
     fleet_state_pub = nullptr;
@@ -298,8 +329,21 @@ public:
   std::shared_ptr<rmf_task_ros2::bidding::AsyncBidder> bidder = nullptr;
 
   double current_assignment_cost = 0.0;
+  // Incremented whenever the queues of the task managers get replaced so that
+  // background reallocations can tell if their inputs have gone stale.
+  std::size_t assignment_generation = 0;
+  // Background reallocations of awarded tasks that have not finished yet
+  std::size_t pending_reallocations = 0;
+
+  struct BidAssignments
+  {
+    Assignments assignments;
+    // The assignment_generation that the assignments were planned from
+    std::size_t generation;
+  };
+
   // Map to store task id with assignments for BidNotice
-  std::unordered_map<std::string, Assignments> bid_notice_assignments = {};
+  std::unordered_map<std::string, BidAssignments> bid_notice_assignments = {};
 
   using BidNoticeMsg = rmf_task_msgs::msg::BidNotice;
 
@@ -320,6 +364,9 @@ public:
 
   mutable rmf_task::Log::Reader log_reader = {};
 
+  // The window of job metrics that was most recently sent to the server
+  mutable std::shared_ptr<const Node::JobMetricsWindow> last_job_metrics;
+
   using LaneStates = rmf_fleet_msgs::msg::LaneStates;
   rclcpp::Publisher<LaneStates>::SharedPtr lane_states_pub = nullptr;
   std::unordered_map<std::size_t, double> speed_limited_lanes = {};
@@ -383,15 +430,22 @@ public:
       handle->_pimpl->node->create_publisher<DispatchAck>(
       DispatchAckTopicName, reliable_transient_qos);
 
-    // Make a dispatch bidder
+    // Make a dispatch bidder. Bids are planned one at a time in the
+    // background, so notices whose auction closes while they wait for their
+    // turn get dropped by the bidder.
     handle->_pimpl->bidder = rmf_task_ros2::bidding::AsyncBidder::make(
       handle->_pimpl->node,
-      [w = handle->weak_from_this()](
+      [w = handle->weak_from_this(), worker = handle->_pimpl->worker](
         const auto& msg, auto respond)
       {
-        if (const auto self = w.lock())
-          self->_pimpl->bid_notice_cb(msg, std::move(respond));
+        worker.schedule(
+          [w, msg, respond = std::move(respond)](const auto&)
+          {
+            if (const auto self = w.lock())
+              self->_pimpl->bid_notice_cb(msg, respond);
+          });
       });
+    handle->_pimpl->bidder->set_concurrency_limit(1);
 
     // Publisher for navigation graph
     handle->_pimpl->nav_graph_pub =
@@ -425,22 +479,6 @@ public:
         handle->_pimpl->charging_waypoints.insert(i);
     }
 
-    // Initialize schema dictionary
-    const std::vector<nlohmann::json> schemas = {
-      rmf_api_msgs::schemas::fleet_state_update,
-      rmf_api_msgs::schemas::fleet_state,
-      rmf_api_msgs::schemas::robot_state,
-      rmf_api_msgs::schemas::location_2D,
-      rmf_api_msgs::schemas::fleet_log,
-      rmf_api_msgs::schemas::log_entry
-    };
-
-    for (const auto& schema : schemas)
-    {
-      const auto json_uri = nlohmann::json_uri{schema["$id"]};
-      handle->_pimpl->schema_dictionary.insert({json_uri.url(), schema});
-    }
-
     // Start the BroadcastClient
     if (handle->_pimpl->server_uri.has_value())
     {
@@ -543,15 +581,37 @@ public:
 
   void dock_summary_cb(const DockSummary::SharedPtr& msg);
 
+  /// Check a bid notice and start planning for it in the background. The
+  /// response is given later on the fleet worker by respond_to_bid(~).
   void bid_notice_cb(
     const BidNoticeMsg& msg,
     rmf_task_ros2::bidding::AsyncBidder::Respond respond);
 
+  /// Submit the bid for a task once its assignments have been planned, and
+  /// remember the assignments in case the task gets awarded to this fleet.
+  void respond_to_bid(
+    const std::string& task_id,
+    std::size_t generation,
+    std::optional<Assignments> allocation_result,
+    std::vector<std::string> errors,
+    const rmf_task_ros2::bidding::AsyncBidder::Respond& respond);
+
   void dispatch_command_cb(const DispatchCmdMsg::SharedPtr msg);
 
   std::optional<std::size_t> get_nearest_charger(
     const rmf_traffic::agv::Planner::Start& start);
 
+  /// Create the context of a robot whose participant has been registered.
+  std::shared_ptr<RobotContext> make_robot_context(
+    std::shared_ptr<RobotCommandHandle> command,
+    rmf_traffic::agv::Plan::StartSet start,
+    rmf_traffic::schedule::Participant participant);
+
+  /// Start managing a robot of this fleet. This must be called on the worker.
+  void add_robot_context(
+    std::shared_ptr<RobotContext> context,
+    std::function<void(std::shared_ptr<RobotUpdateHandle>)> handle_cb);
+
   struct Expectations
   {
     std::vector<rmf_task::State> states;
@@ -568,10 +628,82 @@ public:
     std::vector<std::string>* errors = nullptr,
     std::optional<Expectations> expectations = std::nullopt) const;
 
+  /// A copy of everything that planning task assignments needs from the fleet,
+  /// so that the planning can happen off the fleet worker.
+  struct AllocationInput
+  {
+    std::shared_ptr<rmf_task::TaskPlanner> task_planner;
+    rmf_traffic::Time time;
+    Expectations expectations;
+    rclcpp::Logger logger;
+  };
+
+  /// Copy the inputs for planning task assignments. This must be called on the
+  /// fleet worker.
+  AllocationInput prepare_allocation(Expectations expectations) const;
+
+  /// Plan task assignments using nothing but the given input. This may be
+  /// called from any thread.
+  static std::optional<Assignments> plan_allocation(
+    AllocationInput input,
+    rmf_task::ConstRequestPtr new_request = nullptr,
+    std::vector<std::string>* errors = nullptr);
+
   /// Helper function to check if assignments are valid. An assignment set is
   /// invalid if one of the assignments has already begun execution.
   bool is_valid_assignments(Assignments& assignments) const;
 
+  /// The part of a set of assignments that needs to be planned again because
+  /// some of the robots have begun executing tasks since the assignments were
+  /// computed.
+  struct Reallocation
+  {
+    /// Indices of the robots whose queues need to be planned again
+    std::vector<std::size_t> robots;
+
+    /// The current expected finish state of each robot in robots
+    std::vector<rmf_task::State> states;
+
+    /// Every request in the queues of those robots that has not begun yet
+    std::vector<rmf_task::ConstRequestPtr> requests;
+  };
+
+  /// Find the robots whose queues in the assignments contain a task that has
+  /// already begun execution.
+  Reallocation prepare_reallocation(const Assignments& assignments) const;
+
+  /// Bring the assignments of an awarded task up to date on a background
+  /// worker, then apply them and acknowledge the award on the fleet worker.
+  ///
+  /// The first attempts only plan again for the robots whose queues have
+  /// changed since the bid, and leave every other queue as it was when the
+  /// bid was made. If that fails, or if the queues get replaced while the
+  /// planning is underway, the whole fleet gets planned again.
+  ///
+  /// Pass max_award_repair_attempts as the attempt to skip straight to
+  /// planning for the whole fleet.
+  void reallocate_award(
+    std::string task_id,
+    rmf_task::ConstRequestPtr request,
+    Assignments assignments,
+    DispatchAck dispatch_ack,
+    std::size_t attempt = 0);
+
+  /// The number of attempts at repairing only the changed queues of an award
+  /// before falling back to planning for the whole fleet
+  static constexpr std::size_t max_award_repair_attempts = 2;
+
+  /// The total number of attempts at bringing the assignments of an award up
+  /// to date
+  static constexpr std::size_t max_award_attempts = 4;
+
+  /// Give the assignments of an awarded task to the task managers and
+  /// acknowledge the award.
+  void apply_award(
+    const std::string& task_id,
+    const Assignments& assignments,
+    DispatchAck dispatch_ack);
+
   static Implementation& get(FleetUpdateHandle& fleet)
   {
     return *fleet._pimpl;
@@ -586,18 +718,23 @@ public:
 
   void publish_lane_states() const;
 
+  /// Begin warming the caches of the current planner if cache warming has
+  /// been enabled for this fleet.
+  void warm_planner_caches() const;
+
   void update_fleet() const;
 
   void update_fleet_state() const;
   void update_fleet_logs() const;
+  void update_fleet_metrics() const;
 
-  nlohmann::json_schema::json_validator make_validator(
-    const nlohmann::json& schema) const;
+  static rmf_task_ros2::SchemaRegistry::ConstValidatorPtr make_validator(
+    const nlohmann::json& schema);
 
   void add_standard_tasks();
 
-  std::string make_error_str(
-    uint64_t code, std::string category, std::string detail) const;
+  static std::string make_error_str(
+    uint64_t code, std::string category, std::string detail);
 
   std::shared_ptr<rmf_task::Request> convert(
     const std::string& task_id,
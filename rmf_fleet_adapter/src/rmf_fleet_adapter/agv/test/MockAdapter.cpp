@@ -345,35 +345,40 @@ void MockAdapter::dispatch_task(
 
         // NOTE: although the current adapter supports multiple fleets. The test
         // here assumses using a single fleet for each adapter
-        bool accepted = false;
         auto bid = rmf_task_msgs::build<rmf_task_msgs::msg::BidNotice>()
         .request(request.dump())
         .task_id(task_id)
         .time_window(rclcpp::Duration(2, 0));
 
+        // The fleet plans its bid in the background, so the task gets awarded
+        // whenever the response comes in.
         fimpl.bid_notice_cb(
           bid,
-          [&accepted](const rmf_task_ros2::bidding::Response& response)
+          [w = std::weak_ptr<FleetUpdateHandle>(fleet), task_id](
+            const rmf_task_ros2::bidding::Response& response)
           {
-            accepted = response.proposal.has_value();
+            const auto handle = w.lock();
+            if (!handle)
+              return;
+
+            auto& impl = FleetUpdateHandle::Implementation::get(*handle);
+            if (response.proposal.has_value())
+            {
+              rmf_task_msgs::msg::DispatchCommand req;
+              req.task_id = task_id;
+              req.fleet_name = impl.name;
+              req.type = req.TYPE_AWARD;
+              impl.dispatch_command_cb(
+                std::make_shared<rmf_task_msgs::msg::DispatchCommand>(req));
+              std::cout << "Fleet [" << impl.name
+                        << "] accepted the task request" << std::endl;
+            }
+            else
+            {
+              std::cout << "Fleet [" << impl.name
+                        << "] rejected the task request" << std::endl;
+            }
           });
-
-        if (accepted)
-        {
-          rmf_task_msgs::msg::DispatchCommand req;
-          req.task_id = task_id;
-          req.fleet_name = fimpl.name;
-          req.type = req.TYPE_AWARD;
-          fimpl.dispatch_command_cb(
-            std::make_shared<rmf_task_msgs::msg::DispatchCommand>(req));
-          std::cout << "Fleet [" << fimpl.name << "] accepted the task request"
-                    << std::endl;
-        }
-        else
-        {
-          std::cout << "Fleet [" << fimpl.name << "] rejected the task request"
-                    << std::endl;
-        }
       }
     });
 }
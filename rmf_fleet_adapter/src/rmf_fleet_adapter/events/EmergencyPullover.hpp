@@ -118,8 +118,8 @@ public:
     std::optional<ExecutePlan> _execution;
     std::shared_ptr<services::FindEmergencyPullover> _find_pullover_service;
     rmf_rxcpp::subscription_guard _pullover_subscription;
-    rclcpp::TimerBase::SharedPtr _find_pullover_timeout;
-    rclcpp::TimerBase::SharedPtr _retry_timer;
+    agv::TimerWheel::TimerPtr _find_pullover_timeout;
+    agv::TimerWheel::TimerPtr _retry_timer;
 
     bool _is_interrupted = false;
   };
@@ -362,8 +362,9 @@ void GoToPlace::Active::_find_plan()
       self->_retry_timer = nullptr;
     });
 
-  _find_path_timeout = _context->node()->try_create_wall_timer(
+  _find_path_timeout = _context->node()->schedule_timer(
     std::chrono::seconds(10),
+    _context->worker(),
     [
       weak_service = _find_path_service->weak_from_this(),
       weak_self = weak_from_this()
@@ -393,8 +394,9 @@ void GoToPlace::Active::_schedule_retry()
     return;
 
   // TODO(MXG): Make the retry timing configurable
-  _retry_timer = _context->node()->try_create_wall_timer(
+  _retry_timer = _context->node()->schedule_timer(
     std::chrono::seconds(5),
+    _context->worker(),
     [w = weak_from_this()]()
     {
       const auto self = w.lock();
@@ -135,8 +135,8 @@ public:
     std::optional<ExecutePlan> _execution;
     std::shared_ptr<services::FindPath> _find_path_service;
     rmf_rxcpp::subscription_guard _plan_subscription;
-    rclcpp::TimerBase::SharedPtr _find_path_timeout;
-    rclcpp::TimerBase::SharedPtr _retry_timer;
+    agv::TimerWheel::TimerPtr _find_path_timeout;
+    agv::TimerWheel::TimerPtr _retry_timer;
 
     rmf_rxcpp::subscription_guard _replan_request_subscription;
 
@@ -134,8 +134,8 @@ auto WaitForTraffic::Active::make(
   if (all_reached_already || one_deprecated)
     consider_going();
 
-  active->_timer = active->_context->node()->try_create_wall_timer(
-    std::chrono::seconds(1), consider_going);
+  active->_timer = active->_context->node()->schedule_timer(
+    std::chrono::seconds(1), active->_context->worker(), consider_going);
 
   return active;
 }
@@ -102,7 +102,7 @@ public:
     rmf_task::events::SimpleEventStatePtr _state;
     std::function<void()> _update;
     std::function<void()> _finished;
-    rclcpp::TimerBase::SharedPtr _timer;
+    agv::TimerWheel::TimerPtr _timer;
     std::optional<rmf_traffic::Time> _decision_made;
   };
 
@@ -81,8 +81,9 @@ auto WaitUntil::Active::make(
   active->_finished = std::move(finished);
   active->_update_waiting();
 
-  active->_timer = active->_context->node()->try_create_wall_timer(
+  active->_timer = active->_context->node()->schedule_timer(
     std::chrono::milliseconds(200),
+    active->_context->worker(),
     [w = active->weak_from_this()]()
     {
       const auto self = w.lock();
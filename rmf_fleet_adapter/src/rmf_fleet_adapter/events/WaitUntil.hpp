@@ -90,7 +90,7 @@ public:
     std::function<void()> _update;
     std::function<void()> _finished;
     std::optional<Eigen::Vector3d> _last_position;
-    rclcpp::TimerBase::SharedPtr _timer;
+    agv::TimerWheel::TimerPtr _timer;
     bool _is_interrupted = false;
 
     void _update_waiting();
@@ -29,6 +29,7 @@ Planning::Planning(
 : _current_result(planner->setup(starts, std::move(goal), std::move(options)))
 {
   _current_result->options().saturation_limit(10000);
+  _track_search_state();
 }
 
 //==============================================================================
@@ -36,6 +37,7 @@ Planning::Planning(rmf_traffic::agv::Planner::Result _setup)
 : _current_result(std::move(_setup))
 {
   _current_result->options().saturation_limit(10000);
+  _track_search_state();
 }
 
 //==============================================================================
@@ -47,14 +49,22 @@ void Planning::resume()
 //==============================================================================
 void Planning::discard()
 {
+  auto lock = _lock_result();
+  if (_running)
+  {
+    _discard_requested = true;
+    return;
+  }
+
   _current_result = rmf_utils::nullopt;
+  _search_state.reset();
 }
 
 //==============================================================================
 bool Planning::active() const
 {
-//  return _current_result.has_value();
-  return static_cast<bool>(_current_result);
+  auto lock = _lock_result();
+  return _current_result.has_value() && !_discard_requested;
 }
 
 //==============================================================================
@@ -81,5 +91,25 @@ std::unique_lock<std::mutex> Planning::_lock_resume() const
   return lock;
 }
 
+//==============================================================================
+std::unique_lock<std::mutex> Planning::_lock_result() const
+{
+  std::unique_lock<std::mutex> lock(_result_mutex, std::defer_lock);
+  while (!lock.try_lock())
+  {
+    // Intentionally busy wait to obtain the mutex as fast as possible
+  }
+
+  return lock;
+}
+
+//==============================================================================
+void Planning::_track_search_state()
+{
+  static auto& category =
+    get_job_metrics().category(search_state_category);
+  _search_state.emplace(category);
+}
+
 } // namespace jobs
 } // namespace rmf_fleet_adapter
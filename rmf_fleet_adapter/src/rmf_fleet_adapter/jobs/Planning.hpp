@@ -18,11 +18,15 @@
 #ifndef SRC__RMF_FLEET_ADAPTER__JOBS__PLANNINGJOB_HPP
 #define SRC__RMF_FLEET_ADAPTER__JOBS__PLANNINGJOB_HPP
 
+#include "../JobMetrics.hpp"
+
 #include <rmf_rxcpp/RxJobs.hpp>
 #include <rmf_traffic/agv/Planner.hpp>
 #include <rmf_traffic/agv/RouteValidator.hpp>
 #include <rmf_traffic/schedule/Snapshot.hpp>
 
+#include <optional>
+
 namespace rmf_fleet_adapter {
 namespace jobs {
 
@@ -31,6 +35,13 @@ namespace jobs {
 class Planning : public std::enable_shared_from_this<Planning>
 {
 public:
+  /// The category of this job in get_job_metrics()
+  static constexpr const char* job_category = "planning";
+
+  /// The category in get_job_metrics() that counts how many planning jobs
+  /// are holding onto a search state.
+  static constexpr const char* search_state_category = "planning/search_state";
+
   struct Result
   {
     std::shared_ptr<Planning> job;
@@ -49,6 +60,9 @@ public:
 
   void resume();
 
+  /// Free the search state of this job. If the job is in the middle of a
+  /// planning step then the state will be freed when the step is finished,
+  /// and the job will complete without reporting any more progress.
   void discard();
 
   bool active() const;
@@ -60,9 +74,16 @@ public:
 private:
   mutable std::mutex _resume_mutex;
   std::function<void()> _resume;
+
+  mutable std::mutex _result_mutex;
   rmf_utils::optional<rmf_traffic::agv::Planner::Result> _current_result;
+  std::optional<JobMetrics::Alive> _search_state;
+  bool _running = false;
+  bool _discard_requested = false;
 
   std::unique_lock<std::mutex> _lock_resume() const;
+  std::unique_lock<std::mutex> _lock_result() const;
+  void _track_search_state();
 };
 
 } // namespace jobs
@@ -28,6 +28,9 @@ class Rollout
 {
 public:
 
+  /// The category of this job in get_job_metrics()
+  static constexpr const char* job_category = "rollout";
+
   struct Result
   {
     std::vector<rmf_traffic::schedule::Itinerary> alternatives;
@@ -17,16 +17,21 @@
 
 #include "SearchForPath.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace rmf_fleet_adapter {
 namespace jobs {
 
 //==============================================================================
 std::function<bool()> make_interrupter(
   std::shared_ptr<std::atomic_bool> interrupt_flag,
-  std::optional<rmf_traffic::Time> deadline)
+  std::optional<rmf_traffic::Time> deadline,
+  std::shared_ptr<std::atomic_bool> cancel_flag = nullptr)
 {
   const auto counter = std::make_shared<uint32_t>(0);
-  return [interrupt_flag, deadline, counter]()
+  return [interrupt_flag, deadline, counter, cancel_flag]()
     {
       ++*counter;
       if (*counter > 20)
@@ -36,8 +41,11 @@ std::function<bool()> make_interrupter(
         if (*interrupt_flag)
           return true;
 
-        const auto now = std::chrono::steady_clock::now();
-        if (deadline <= now)
+        if (cancel_flag && *cancel_flag)
+          return true;
+
+        if (deadline.has_value() &&
+          *deadline <= std::chrono::steady_clock::now())
           return true;
       }
 
@@ -59,37 +67,85 @@ SearchForPath::SearchForPath(
   _goal(std::move(goal)),
   _schedule(std::move(schedule)),
   _participant_id(participant_id),
-  _worker(rxcpp::schedulers::make_event_loop().create_worker())
+  _worker(rmf_rxcpp::detail::get_event_loop().create_worker())
 {
   if (planning_time_limit.has_value())
   {
     const auto start_time = std::chrono::steady_clock::now();
     _deadline = start_time + *planning_time_limit;
   }
-  auto greedy_options = _planner->get_default_options();
-  greedy_options.validator(nullptr);
-  greedy_options.interrupter(make_interrupter(_interrupt_flag, _deadline));
 
   // TODO(MXG): This is a gross hack to side-step the saturation issue that
   // happens when too many start conditions are given. That problem should be
-  // fixed after we've improved the planner's heuristic.
-  auto greedy_starts = _starts;
-  if (greedy_starts.size() > 1)
-    greedy_starts.erase(greedy_starts.begin()+1, greedy_starts.end());
+  // fixed after we've improved the planner's heuristic. In the meantime we
+  // search from each start separately and keep whichever plan is cheapest.
+  double base_cost = std::numeric_limits<double>::infinity();
+  for (const auto& start : _starts)
+  {
+    auto cancel = std::make_shared<std::atomic_bool>(false);
+    auto greedy_options = _planner->get_default_options();
+    greedy_options.validator(nullptr);
+    greedy_options.interrupter(
+      make_interrupter(_interrupt_flag, _deadline, cancel));
+
+    auto greedy_setup = _planner->setup(start, _goal, greedy_options);
+    const auto estimate = greedy_setup.cost_estimate();
+    if (!estimate.has_value() && !_greedy_candidates.empty())
+    {
+      // This start cannot reach the goal, so there is no point in searching
+      // from it.
+      continue;
+    }
+
+    // The first start is always kept so that disconnected searches can still
+    // be reported.
+    const double initial_estimate = estimate.has_value() ?
+      *estimate : std::numeric_limits<double>::infinity();
+
+    if (estimate.has_value())
+    {
+      base_cost = std::min(base_cost, *estimate);
+      greedy_setup.options().maximum_cost_estimate(_greedy_leeway * *estimate);
+    }
+
+    _greedy_candidates.push_back(
+      GreedyCandidate{
+        std::make_shared<Planning>(std::move(greedy_setup)),
+        std::move(cancel),
+        initial_estimate,
+        rmf_rxcpp::subscription_guard(),
+        false
+      });
+  }
+
+  if (_greedy_candidates.empty())
+    return;
+
+  if (std::isfinite(base_cost))
+  {
+    // Drop the first start if it turned out to be disconnected while some
+    // other start is not.
+    _greedy_candidates.erase(
+      std::remove_if(
+        _greedy_candidates.begin(), _greedy_candidates.end(),
+        [](const GreedyCandidate& c)
+        {
+          return !std::isfinite(c.initial_estimate);
+        }),
+      _greedy_candidates.end());
+  }
 
-  auto greedy_setup = _planner->setup(greedy_starts, _goal, greedy_options);
-  const double base_cost = *greedy_setup.cost_estimate();
-  greedy_setup.options().maximum_cost_estimate(_greedy_leeway*base_cost);
+  _greedy_job = _greedy_candidates.front().job;
 
   auto compliant_options = _planner->get_default_options();
   compliant_options.validator(
     rmf_traffic::agv::ScheduleRouteValidator::make(
       _schedule, _participant_id, *profile));
-  compliant_options.maximum_cost_estimate(_compliant_leeway*base_cost);
-  greedy_options.interrupter(make_interrupter(_interrupt_flag, _deadline));
+  if (std::isfinite(base_cost))
+    compliant_options.maximum_cost_estimate(_compliant_leeway*base_cost);
+  compliant_options.interrupter(make_interrupter(_interrupt_flag, _deadline));
   auto compliant_setup = _planner->setup(_starts, _goal, compliant_options);
 
-  _greedy_job = std::make_shared<Planning>(std::move(greedy_setup));
   _compliant_job = std::make_shared<Planning>(std::move(compliant_setup));
 }
 
@@ -129,5 +185,24 @@ void SearchForPath::set_cost_limit(double cost)
   _explicit_cost_limit = cost;
 }
 
+//==============================================================================
+void SearchForPath::set_priority(rmf_rxcpp::JobPriority priority)
+{
+  _priority = priority;
+}
+
+//==============================================================================
+void SearchForPath::_cancel_greedy_candidates(const double cost_threshold)
+{
+  for (auto& candidate : _greedy_candidates)
+  {
+    if (candidate.finished)
+      continue;
+
+    if (cost_threshold <= candidate.initial_estimate)
+      *candidate.cancel = true;
+  }
+}
+
 } // namespace jobs
 } // namespace rmf_fleet_adapter
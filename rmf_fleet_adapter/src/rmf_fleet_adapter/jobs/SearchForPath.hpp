@@ -34,6 +34,9 @@ class SearchForPath : public std::enable_shared_from_this<SearchForPath>
 {
 public:
 
+  /// The category of this job in get_job_metrics()
+  static constexpr const char* job_category = "search_for_path";
+
   SearchForPath(
     std::shared_ptr<const rmf_traffic::agv::Planner> planner,
     rmf_traffic::agv::Plan::StartSet starts,
@@ -51,6 +54,8 @@ public:
 
   struct Result
   {
+    /// The best greedy search. This is never null in a result that completes
+    /// the search, but its progress might not have succeeded.
     std::shared_ptr<Planning> greedy_job;
     std::shared_ptr<Planning> compliant_job;
     Type type;
@@ -65,6 +70,12 @@ public:
 
   void set_cost_limit(double cost);
 
+  /// Set the priority class that the planning steps of this search should be
+  /// scheduled with. The planning time limit, if any, is used as the deadline
+  /// of the steps within their class. This must be called before the search
+  /// is started.
+  void set_priority(rmf_rxcpp::JobPriority priority);
+
   Planning& greedy();
   const Planning& greedy() const;
 
@@ -84,9 +95,36 @@ private:
   // participants. It is used for two purposes:
   // 1. Provide a reference for what an acceptable cost is for the compliant job
   // 2. Provide a backup plan if a compliant job can't be found
+  //
+  // This always points at the best greedy candidate found so far.
   std::shared_ptr<Planning> _greedy_job;
-  rmf_rxcpp::subscription_guard _greedy_sub;
   bool _greedy_finished = false;
+  bool _greedy_success = false;
+
+  // Giving the greedy planner many start conditions at once saturates it, so
+  // each start gets its own greedy search instead. These all run in parallel
+  // on the planning event loop. As soon as one of them finds a plan, any other
+  // candidate whose initial cost estimate cannot beat it gets cancelled.
+  struct GreedyCandidate
+  {
+    std::shared_ptr<Planning> job;
+    std::shared_ptr<std::atomic_bool> cancel;
+    double initial_estimate;
+    rmf_rxcpp::subscription_guard sub;
+    bool finished = false;
+  };
+  std::vector<GreedyCandidate> _greedy_candidates;
+
+  void _cancel_greedy_candidates(double cost_threshold);
+
+  template<typename Subscriber>
+  void _report_greedy_failure(
+    const Subscriber& s,
+    const rmf_traffic::agv::Planner::Result& r);
+
+  // Set once the final result has been reported so that late results from
+  // cancelled searches are ignored.
+  bool _completed = false;
 
   // The compliant job makes the plan which is optimal without conflicting with
   // any other traffic currently on the schedule. In some cases, it might not
@@ -99,6 +137,7 @@ private:
 
   rxcpp::schedulers::worker _worker;
   std::optional<rmf_traffic::Time> _deadline;
+  rmf_rxcpp::JobPriority _priority = rmf_rxcpp::JobPriority::routine;
 
   // TODO(MXG): Make these leeway factors configurable
   const double _greedy_leeway = 10.0;
@@ -37,22 +37,63 @@ void Planning::operator()(const Subscriber& s, const Worker& w)
         if (const auto self = a.lock())
         {
           auto lock = self->_lock_resume();
-          w.schedule([a, s, w](const auto&)
+          using Clock = JobMetrics::clock_type;
+          w.schedule([a, s, w, queued = Clock::now()](const auto&)
             {
+              const auto category =
+                rmf_rxcpp::detail::job_category<Planning>();
+              const auto start = Clock::now();
+              if (category)
+                category->queued(start - queued);
+
               if (const auto action = a.lock())
+              {
                 (*action)(s, w);
+                if (category)
+                  category->executed(Clock::now() - start);
+              }
             });
         }
       };
   }
 
-  if (!_current_result)
-    return;
+  {
+    auto lock = _lock_result();
+    if (!_current_result || _discard_requested)
+      return;
 
+    _running = true;
+  }
+
+  // The result is not locked while it is being resumed, so that discard() does
+  // not need to wait for this step to finish. Instead it leaves a request for
+  // us to discard the result when we are done.
   _current_result->resume();
 
-  const bool completed =
-    _current_result->success() || !_current_result->cost_estimate();
+  bool completed = false;
+  bool discarded = false;
+  {
+    auto lock = _lock_result();
+    _running = false;
+    if (_discard_requested)
+    {
+      _current_result = rmf_utils::nullopt;
+      _search_state.reset();
+      discarded = true;
+    }
+    else
+    {
+      completed =
+        _current_result->success() || !_current_result->cost_estimate();
+    }
+  }
+
+  if (discarded)
+  {
+    // Nobody is interested in the progress of this job anymore
+    s.on_completed();
+    return;
+  }
 
   s.on_next(Result{shared_from_this()});
   if (completed)
@@ -55,6 +55,11 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
 
   if (_explicit_cost_limit)
   {
+    // An explicit cost limit means the caller is stepping through the search
+    // itself, so only the primary greedy search is used.
+    _greedy_candidates.erase(
+      _greedy_candidates.begin()+1, _greedy_candidates.end());
+
     _greedy_job->progress().options().maximum_cost_estimate(
       _explicit_cost_limit);
 
@@ -62,116 +67,101 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
       _explicit_cost_limit);
   }
 
-  _greedy_sub = rmf_rxcpp::make_job<Planning::Result>(_greedy_job)
-    .observe_on(rxcpp::identity_same_worker(_worker))
-    .subscribe(
-    [weak = weak_from_this(), s](const Planning::Result& result)
-    {
-      const auto search = weak.lock();
-      if (!search)
-        return;
-
-      if (search->_deadline.has_value())
+  for (std::size_t i = 0; i < _greedy_candidates.size(); ++i)
+  {
+    _greedy_candidates[i].sub =
+      rmf_rxcpp::make_planning_job<Planning::Result>(
+      _greedy_candidates[i].job, _priority, _deadline)
+      .observe_on(rxcpp::identity_same_worker(_worker))
+      .subscribe(
+      [weak = weak_from_this(), s, i](const Planning::Result& result)
       {
-        const auto now = std::chrono::steady_clock::now();
-        if (search->_deadline <= now)
-          search->interrupt();
-      }
-
-      auto show_compliant = search->_compliant_finished ?
-      search->_compliant_job : std::shared_ptr<Planning>(nullptr);
+        const auto search = weak.lock();
+        if (!search)
+          return;
 
-      Result next{search->_greedy_job, show_compliant, Type::greedy};
+        if (search->_completed)
+          return;
 
-      const auto& r = result.job->progress();
-      if (r.success())
-      {
-        if (search->_compliant_finished)
+        if (search->_deadline.has_value())
         {
-          s.on_next(next);
-          s.on_completed();
-          return;
+          const auto now = std::chrono::steady_clock::now();
+          if (search->_deadline <= now)
+            search->interrupt();
         }
-        else if (search->_explicit_cost_limit)
+
+        auto& candidate = search->_greedy_candidates[i];
+        const auto& r = result.job->progress();
+
+        if (search->_explicit_cost_limit)
         {
-          s.on_next(next);
+          auto show_compliant = search->_compliant_finished ?
+          search->_compliant_job : std::shared_ptr<Planning>(nullptr);
+
+          Result next{search->_greedy_job, show_compliant, Type::greedy};
+          if (r.success())
+          {
+            if (search->_compliant_finished)
+            {
+              search->_completed = true;
+              s.on_next(next);
+              s.on_completed();
+              return;
+            }
+
+            s.on_next(next);
+            search->_greedy_finished = true;
+            search->_greedy_success = true;
+            return;
+          }
 
-          search->_greedy_finished = true;
+          s.on_next(next);
+          // We do not automatically resume, because that should be the choice
+          // of whoever we are reporting to
           return;
         }
 
-        search->_greedy_finished = true;
-        return;
-      }
-
-      if (!search->_explicit_cost_limit)
-      {
-        const double current_cost = r.cost_estimate() ?
-        *r.cost_estimate() : std::numeric_limits<double>::infinity();
-        const double maximum_cost = r.options().maximum_cost_estimate() ?
-        *r.options().maximum_cost_estimate() :
-        std::numeric_limits<double>::infinity();
-
-        auto opt_to_str = [](const auto& v) -> std::string
+        candidate.finished = true;
+        if (r.success())
         {
-          if (v)
-            return std::to_string(*v);
+          const double cost = r->get_cost();
+          if (!search->_greedy_success
+          || cost < search->_greedy_job->progress()->get_cost())
+          {
+            search->_greedy_job = candidate.job;
+            search->_greedy_success = true;
+          }
+
+          // No other start can produce a cheaper plan than this if its initial
+          // estimate is already more expensive.
+          search->_cancel_greedy_candidates(cost);
+        }
 
-          return "null";
-        };
+        for (const auto& c : search->_greedy_candidates)
+        {
+          if (!c.finished)
+            return;
+        }
 
-        const auto to_string = [](const rmf_traffic::agv::Plan::Start& start)
+        if (!search->_greedy_success)
         {
-          std::ostringstream oss;
-          oss << "[" << start.waypoint() << "] r:" << start.orientation();
-          if (start.lane())
-            oss << " | lane: " << *start.lane();
-          else
-            oss << " | no lane";
-
-          if (start.location())
-            oss << " | <" << start.location()->transpose() << ">";
-
-          return oss.str();
-        };
-
-        const auto& desc = search->_schedule->get_participant(
-          search->_participant_id);
-        // If the job has not succeeded, then something very suspicious is
-        // happening. The initial cost estimate must be very very bad for this to
-        // occur, which would imply broader systemic issues in the planner.
-        std::cerr << "[SearchForPath] CRITICAL ERROR: Failed to find an "
-                  << "acceptable greedy solution. Participant [" << desc->name()
-                  << "] owned by [" << desc->owner() << "] Requested path";
-        for (const auto& start : search->_starts)
-          std::cerr << " (" << to_string(start) << ")";
-        std::cerr << " --> (" << search->_goal.waypoint() << "). Maximum cost: "
-                  << maximum_cost << " | Leeway factor: "
-                  << search->_greedy_leeway << " | Current cost: " << current_cost
-                  << " | Saturated: " << r.saturated() << " (limit: "
-                  << opt_to_str(r.options().saturation_limit())
-                  << ") | interrupted: " << r.interrupted() << std::endl;
-        const auto& v = r.get_configuration().vehicle_traits();
-        std::cerr << "linear | v: " << v.linear().get_nominal_velocity()
-                  << ", a: " << v.linear().get_nominal_acceleration()
-                  << "\nangular | v: " << v.rotational().get_nominal_velocity()
-                  << ", a: " << v.rotational().get_nominal_acceleration()
-                  << std::endl;
-        assert(false);
-
-        // We'll return the failed plan, I guess. If the greedy planner fails,
-        // then there is no hope of the compliant planner succeeding.
-        s.on_next(next);
-        s.on_completed();
-        return;
-      }
+          search->_report_greedy_failure(s, r);
+          return;
+        }
 
-      s.on_next(next);
-      // We do not automatically resume, because that should be the choice of
-      // whoever we are reporting to
-    });
+        search->_greedy_finished = true;
+        if (search->_compliant_finished)
+        {
+          search->_completed = true;
+          s.on_next(
+            Result{search->_greedy_job, search->_compliant_job, Type::greedy});
+          s.on_completed();
+        }
+      });
+  }
 
-  _compliant_sub = rmf_rxcpp::make_job<Planning::Result>(_compliant_job)
+  _compliant_sub = rmf_rxcpp::make_planning_job<Planning::Result>(
+    _compliant_job, _priority, _deadline)
     .observe_on(rxcpp::identity_same_worker(_worker))
     .subscribe(
     [weak = weak_from_this(), s](const Planning::Result& result)
@@ -180,6 +170,9 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
       if (!search)
         return;
 
+      if (search->_completed)
+        return;
+
       if (search->_deadline.has_value())
       {
         const auto now = std::chrono::steady_clock::now();
@@ -195,16 +188,29 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
       auto& r = result.job->progress();
       if (r.success())
       {
-        // Return the successful schedule-compliant plan
-        if (search->_greedy_finished || search->_explicit_cost_limit)
+        search->_compliant_finished = true;
+        if (search->_explicit_cost_limit)
         {
           s.on_next(next);
-        }
-        search->_compliant_finished = true;
+          if (search->_greedy_finished)
+          {
+            search->_completed = true;
+            s.on_completed();
+          }
 
-        if (search->_greedy_finished)
-          s.on_completed();
+          return;
+        }
 
+        // The compliant plan is preferred whenever it exists, so there is no
+        // reason to wait for the greedy searches to finish. The best greedy
+        // candidate is still reported so the fallback plan stays available,
+        // although it might not have finished its search.
+        search->_cancel_greedy_candidates(
+          -std::numeric_limits<double>::infinity());
+        search->_completed = true;
+        next.greedy_job = search->_greedy_job;
+        s.on_next(next);
+        s.on_completed();
         return;
       }
 
@@ -212,6 +218,7 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
       {
         if (search->_greedy_finished)
         {
+          search->_completed = true;
           s.on_next(next);
           s.on_completed();
         }
@@ -251,6 +258,7 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
 
         // We shouldn't keep trying, because we have exceeded the cost limit, even
         // when accounting for the greedy plan cost.
+        search->_completed = true;
         s.on_next(next);
         s.on_completed();
         return;
@@ -262,6 +270,74 @@ void SearchForPath::operator()(const Subscriber& s, const Worker&)
     });
 }
 
+//==============================================================================
+template<typename Subscriber>
+void SearchForPath::_report_greedy_failure(
+  const Subscriber& s,
+  const rmf_traffic::agv::Planner::Result& r)
+{
+  const double current_cost = r.cost_estimate() ?
+    *r.cost_estimate() : std::numeric_limits<double>::infinity();
+  const double maximum_cost = r.options().maximum_cost_estimate() ?
+    *r.options().maximum_cost_estimate() :
+    std::numeric_limits<double>::infinity();
+
+  auto opt_to_str = [](const auto& v) -> std::string
+    {
+      if (v)
+        return std::to_string(*v);
+
+      return "null";
+    };
+
+  const auto to_string = [](const rmf_traffic::agv::Plan::Start& start)
+    {
+      std::ostringstream oss;
+      oss << "[" << start.waypoint() << "] r:" << start.orientation();
+      if (start.lane())
+        oss << " | lane: " << *start.lane();
+      else
+        oss << " | no lane";
+
+      if (start.location())
+        oss << " | <" << start.location()->transpose() << ">";
+
+      return oss.str();
+    };
+
+  const auto& desc = _schedule->get_participant(_participant_id);
+  // If none of the greedy jobs succeeded, then something very suspicious is
+  // happening. The initial cost estimate must be very very bad for this to
+  // occur, which would imply broader systemic issues in the planner.
+  std::cerr << "[SearchForPath] CRITICAL ERROR: Failed to find an "
+            << "acceptable greedy solution. Participant [" << desc->name()
+            << "] owned by [" << desc->owner() << "] Requested path";
+  for (const auto& start : _starts)
+    std::cerr << " (" << to_string(start) << ")";
+  std::cerr << " --> (" << _goal.waypoint() << "). Maximum cost: "
+            << maximum_cost << " | Leeway factor: "
+            << _greedy_leeway << " | Current cost: " << current_cost
+            << " | Saturated: " << r.saturated() << " (limit: "
+            << opt_to_str(r.options().saturation_limit())
+            << ") | interrupted: " << r.interrupted() << std::endl;
+  const auto& v = r.get_configuration().vehicle_traits();
+  std::cerr << "linear | v: " << v.linear().get_nominal_velocity()
+            << ", a: " << v.linear().get_nominal_acceleration()
+            << "\nangular | v: " << v.rotational().get_nominal_velocity()
+            << ", a: " << v.rotational().get_nominal_acceleration()
+            << std::endl;
+  assert(false);
+
+  // We'll return the failed plan, I guess. If the greedy planner fails, then
+  // there is no hope of the compliant planner succeeding.
+  auto show_compliant = _compliant_finished ?
+    _compliant_job : std::shared_ptr<Planning>(nullptr);
+
+  _completed = true;
+  s.on_next(Result{_greedy_job, show_compliant, Type::greedy});
+  s.on_completed();
+}
+
 } // namespace jobs
 } // namespace rmf_fleet_adapter
 
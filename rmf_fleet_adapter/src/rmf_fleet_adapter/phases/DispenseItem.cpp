@@ -122,7 +122,8 @@ void DispenseItem::ActivePhase::_init_obs()
 
         me->_do_publish();
         me->_timer =
-        node->try_create_wall_timer(std::chrono::milliseconds(1000), [weak]()
+        node->schedule_timer(
+          std::chrono::milliseconds(1000), me->_context->worker(), [weak]()
         {
           auto me = weak.lock();
           if (!me)
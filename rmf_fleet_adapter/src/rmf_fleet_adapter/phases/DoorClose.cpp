@@ -86,8 +86,9 @@ void DoorClose::ActivePhase::_init_obs()
 
         me->_status.state = LegacyTask::StatusMsg::STATE_ACTIVE;
         me->_publish_close_door();
-        me->_timer = me->_context->node()->try_create_wall_timer(
+        me->_timer = me->_context->node()->schedule_timer(
           std::chrono::milliseconds(1000),
+          me->_context->worker(),
           [weak]()
           {
             auto me = weak.lock();
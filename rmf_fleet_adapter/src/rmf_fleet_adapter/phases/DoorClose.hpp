@@ -65,7 +65,7 @@ struct DoorClose
     std::string _request_id;
     rxcpp::observable<LegacyTask::StatusMsg> _obs;
     std::string _description;
-    rclcpp::TimerBase::SharedPtr _timer;
+    agv::TimerWheel::TimerPtr _timer;
     LegacyTask::StatusMsg _status;
 
     ActivePhase(
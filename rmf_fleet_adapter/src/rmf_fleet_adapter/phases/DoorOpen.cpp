@@ -111,7 +111,8 @@ void DoorOpen::ActivePhase::_init_obs()
         me->_status.state = LegacyTask::StatusMsg::STATE_ACTIVE;
         me->_publish_open_door();
         me->_timer =
-        transport->try_create_wall_timer(std::chrono::milliseconds(1000),
+        transport->schedule_timer(
+          std::chrono::milliseconds(1000), me->_context->worker(),
         [weak, transport]()
         {
           auto me = weak.lock();
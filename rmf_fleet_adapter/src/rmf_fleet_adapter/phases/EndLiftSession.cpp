@@ -93,8 +93,9 @@ void EndLiftSession::Active::_init_obs()
           return;
 
         me->_publish_session_end();
-        me->_timer = me->_context->node()->try_create_wall_timer(
+        me->_timer = me->_context->node()->schedule_timer(
           std::chrono::milliseconds(1000),
+          me->_context->worker(),
           [weak]()
           {
             const auto me = weak.lock();
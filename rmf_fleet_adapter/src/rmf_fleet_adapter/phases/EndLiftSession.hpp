@@ -59,7 +59,7 @@ struct EndLiftSession
     std::string _destination;
     std::string _description;
     rxcpp::observable<LegacyTask::StatusMsg> _obs;
-    rclcpp::TimerBase::SharedPtr _timer;
+    agv::TimerWheel::TimerPtr _timer;
 
     void _init_obs();
     void _publish_session_end();
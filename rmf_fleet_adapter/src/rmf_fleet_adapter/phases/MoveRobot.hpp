@@ -122,7 +122,7 @@ struct MoveRobot
     std::optional<rmf_traffic::Time> _last_tail_bump;
     std::size_t _next_path_index = 0;
 
-    rclcpp::TimerBase::SharedPtr _update_timeout_timer;
+    agv::TimerWheel::TimerPtr _update_timeout_timer;
     rclcpp::Time _last_update_rostime;
     // TODO(MXG): Make this timeout configurable by users
     rmf_traffic::Duration _update_timeout = std::chrono::seconds(10);
@@ -137,8 +137,8 @@ void MoveRobot::Action::operator()(const Subscriber& s)
     return;
 
   _last_update_rostime = _context->node()->now();
-  _update_timeout_timer = _context->node()->try_create_wall_timer(
-    _update_timeout, [w = weak_from_this()]()
+  _update_timeout_timer = _context->node()->schedule_timer(
+    _update_timeout, _context->worker(), [w = weak_from_this()]()
     {
       const auto self = w.lock();
       if (!self)
@@ -108,8 +108,9 @@ void RequestLift::ActivePhase::_init_obs()
           return;
 
         me->_do_publish();
-        me->_timer = me->_context->node()->try_create_wall_timer(
+        me->_timer = me->_context->node()->schedule_timer(
           std::chrono::milliseconds(1000),
+          me->_context->worker(),
           [weak]()
           {
             auto me = weak.lock();
@@ -235,8 +236,9 @@ LegacyTask::StatusMsg RequestLift::ActivePhase::_get_status(
                   // Do nothing
                 });
 
-            _rewait_timer = _context->node()->try_create_wall_timer(
+            _rewait_timer = _context->node()->schedule_timer(
               _context->get_lift_rewait_duration(),
+              _context->worker(),
               [w = weak_from_this()]()
               {
                 if (const auto& me = w.lock())
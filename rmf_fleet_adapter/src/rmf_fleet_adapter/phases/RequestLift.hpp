@@ -66,7 +66,7 @@ struct RequestLift
       rxcpp::subjects::behavior<bool>(false);
     std::string _description;
     rxcpp::observable<LegacyTask::StatusMsg> _obs;
-    rclcpp::TimerBase::SharedPtr _timer;
+    agv::TimerWheel::TimerPtr _timer;
     std::shared_ptr<EndLiftSession::Active> _lift_end_phase;
     Located _located;
     rmf_rxcpp::subscription_guard _reset_session_subscription;
@@ -78,7 +78,7 @@ struct RequestLift
     };
 
     std::shared_ptr<WatchdogInfo> _watchdog_info;
-    rclcpp::TimerBase::SharedPtr _rewait_timer;
+    agv::TimerWheel::TimerPtr _rewait_timer;
     bool _rewaiting = false;
 
     ActivePhase(
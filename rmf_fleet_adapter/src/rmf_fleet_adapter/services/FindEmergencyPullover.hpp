@@ -30,6 +30,9 @@ class FindEmergencyPullover
 {
 public:
 
+  /// The category of this job in get_job_metrics()
+  static constexpr const char* job_category = "find_emergency_pullover";
+
   FindEmergencyPullover(
     std::shared_ptr<const rmf_traffic::agv::Planner> planner,
     rmf_traffic::agv::Plan::StartSet starts,
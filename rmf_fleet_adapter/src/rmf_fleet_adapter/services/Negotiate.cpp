@@ -16,6 +16,7 @@
 */
 
 #include "Negotiate.hpp"
+#include "../project_itinerary.hpp"
 
 namespace rmf_fleet_adapter {
 namespace services {
@@ -127,6 +128,12 @@ bool Negotiate::discarded() const
   return _discarded || _viewer->defunct();
 }
 
+//==============================================================================
+void Negotiate::use_cache(std::shared_ptr<NegotiationCache> cache)
+{
+  _cache = std::move(cache);
+}
+
 //==============================================================================
 const rmf_traffic::schedule::Negotiator::ResponderPtr&
 Negotiate::responder() const
@@ -134,6 +141,14 @@ Negotiate::responder() const
   return _responder;
 }
 
+//==============================================================================
+void Negotiate::track_robot(const std::string& name)
+{
+  _robot_alive.emplace(
+    get_job_metrics().category(
+      std::string(job_category) + "/" + name));
+}
+
 //==============================================================================
 Negotiate::~Negotiate()
 {
@@ -155,5 +170,97 @@ void Negotiate::_resume_next()
   top->resume();
 }
 
+//==============================================================================
+std::function<void()> Negotiate::_make_submission(rmf_traffic::agv::Plan plan)
+{
+  if (_cache)
+    _cache->store(_starts, _goals, plan);
+
+  return
+    [plan = std::move(plan),
+    initial_itinerary = std::move(_initial_itinerary),
+    followed_by = _followed_by,
+    planner = _planner,
+    approval = std::move(_approval),
+    responder = _responder,
+    viewer = _viewer,
+    plan_id = _plan_id]()
+    {
+      std::vector<rmf_traffic::Route> final_itinerary;
+      final_itinerary.reserve(
+        initial_itinerary.size() + plan.get_itinerary().size());
+
+      for (const auto& it : {initial_itinerary, plan.get_itinerary()})
+      {
+        for (const auto& route : it)
+        {
+          if (route.trajectory().size() > 1)
+            final_itinerary.push_back(route);
+        }
+      }
+
+      final_itinerary = project_itinerary(plan, followed_by, *planner);
+      for (const auto& parent : viewer->base_proposals())
+      {
+        // Make sure all parent dependencies are accounted for
+        // TODO(MXG): This is kind of a gross hack that we add to
+        // force the lookahead to work for patrols. This approach
+        // should be reworked in a future redesign of the traffic
+        // system.
+        for (auto& r : final_itinerary)
+        {
+          for (std::size_t i = 0; i < parent.itinerary.size(); ++i)
+          {
+            r.add_dependency(
+              r.trajectory().size(),
+              rmf_traffic::Dependency{
+                parent.participant,
+                parent.plan,
+                i,
+                parent.itinerary[i].trajectory().size()
+              });
+          }
+        }
+      }
+
+      responder->submit(
+        plan_id,
+        final_itinerary,
+        [
+          plan_id,
+          plan,
+          approval = std::move(approval),
+          final_itinerary
+        ]()
+        -> UpdateVersion
+        {
+          if (approval)
+            return approval(plan_id, plan, final_itinerary);
+
+          return rmf_utils::nullopt;
+        });
+    };
+}
+
+//==============================================================================
+void Negotiate::_release_jobs()
+{
+  // Jobs that are in the middle of a planning step will release their search
+  // state as soon as the step is finished.
+  for (const auto& job : _queued_jobs)
+    job->discard();
+
+  _queued_jobs.clear();
+  _current_jobs.clear();
+  _resume_jobs = decltype(_resume_jobs)();
+  _best_job = nullptr;
+
+  // These would otherwise be left pointing at the released search states
+  _evaluator.best_estimate.progress = nullptr;
+  _evaluator.second_best_estimate.progress = nullptr;
+  _evaluator.best_result.progress = nullptr;
+  _evaluator.best_discarded.progress = nullptr;
+}
+
 } // namespace services
 } // namespace rmf_fleet_adapter
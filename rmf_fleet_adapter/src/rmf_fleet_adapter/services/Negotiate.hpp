@@ -21,6 +21,7 @@
 #include <rmf_traffic/schedule/Negotiator.hpp>
 #include "../jobs/Planning.hpp"
 #include "../jobs/Rollout.hpp"
+#include "NegotiationCache.hpp"
 #include "ProgressEvaluator.hpp"
 
 namespace rmf_fleet_adapter {
@@ -31,6 +32,9 @@ class Negotiate : public std::enable_shared_from_this<Negotiate>
 {
 public:
 
+  /// The category of this job in get_job_metrics()
+  static constexpr const char* job_category = "negotiate";
+
   using ItineraryVersion = rmf_traffic::schedule::ItineraryVersion;
   using UpdateVersion = rmf_utils::optional<ItineraryVersion>;
   using ApprovalCallback =
@@ -90,12 +94,29 @@ public:
 
   const rmf_traffic::schedule::Negotiator::ResponderPtr& responder() const;
 
+  /// Share plans with the other services of the same robot through this cache.
+  /// The plans that this service submits will be stored in it, and the plans
+  /// that are already in it will be tried before any planning is done.
+  void use_cache(std::shared_ptr<NegotiationCache> cache);
+
+  /// Count this service among the negotiations of the named robot in
+  /// get_job_metrics().
+  void track_robot(const std::string& name);
+
   ~Negotiate();
 
 private:
 
   void _resume_next();
 
+  /// Release the search states of all the planning jobs at once. This is done
+  /// as soon as the negotiation has been concluded, instead of waiting for
+  /// this service to be destroyed.
+  void _release_jobs();
+
+  /// Make the callback that submits this plan to the negotiation
+  std::function<void()> _make_submission(rmf_traffic::agv::Plan plan);
+
   rmf_traffic::PlanId _plan_id;
   std::shared_ptr<const rmf_traffic::agv::Planner> _planner;
   rmf_traffic::agv::Plan::StartSet _starts;
@@ -142,6 +163,15 @@ private:
   static constexpr std::size_t max_concurrent_jobs = 5;
 
   ProgressEvaluator _evaluator;
+
+  std::shared_ptr<NegotiationCache> _cache;
+
+  // A plan from the cache that is valid for this table
+  std::optional<rmf_traffic::agv::Plan> _incumbent;
+
+  JobMetrics::Alive _alive{
+    rmf_rxcpp::detail::job_category<Negotiate>()};
+  std::optional<JobMetrics::Alive> _robot_alive;
 };
 
 } // namespace services
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "NegotiationCache.hpp"
+
+#include <algorithm>
+
+namespace rmf_fleet_adapter {
+namespace services {
+
+namespace {
+//==============================================================================
+bool same_starts(
+  const NegotiationCache::StartSet& a,
+  const NegotiationCache::StartSet& b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    const auto& sa = a[i];
+    const auto& sb = b[i];
+    if (sa.time() != sb.time()
+      || sa.waypoint() != sb.waypoint()
+      || sa.orientation() != sb.orientation()
+      || sa.location() != sb.location()
+      || sa.lane() != sb.lane())
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool same_goals(
+  const std::vector<NegotiationCache::Goal>& a,
+  const std::vector<NegotiationCache::Goal>& b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    if (a[i].waypoint() != b[i].waypoint())
+      return false;
+
+    const double* oa = a[i].orientation();
+    const double* ob = b[i].orientation();
+    if (static_cast<bool>(oa) != static_cast<bool>(ob))
+      return false;
+
+    if (oa && *oa != *ob)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool has_conflict(
+  const rmf_traffic::agv::RouteValidator& validator,
+  const rmf_traffic::agv::Plan& plan)
+{
+  for (const auto& route : plan.get_itinerary())
+  {
+    if (validator.find_conflict(route))
+      return true;
+  }
+
+  return false;
+}
+} // anonymous namespace
+
+//==============================================================================
+void NegotiationCache::store(
+  const StartSet& starts,
+  const std::vector<Goal>& goals,
+  rmf_traffic::agv::Plan plan)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  const auto it = std::find_if(
+    _entries.begin(),
+    _entries.end(),
+    [&](const Entry& entry)
+    {
+      return same_starts(entry.starts, starts)
+      && same_goals(entry.goals, goals);
+    });
+
+  // Plans that came out of this cache get submitted again, so replace the old
+  // plan instead of keeping several copies of it.
+  if (it != _entries.end())
+    _entries.erase(it);
+
+  _entries.push_back({starts, goals, std::move(plan)});
+  while (_entries.size() > capacity)
+    _entries.pop_front();
+}
+
+//==============================================================================
+std::optional<rmf_traffic::agv::Plan> NegotiationCache::find(
+  const StartSet& starts,
+  const std::vector<Goal>& goals,
+  const std::vector<ValidatorPtr>& validators,
+  const double below) const
+{
+  std::vector<rmf_traffic::agv::Plan> candidates;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& entry : _entries)
+    {
+      if (entry.plan.get_cost() < below
+        && same_starts(entry.starts, starts)
+        && same_goals(entry.goals, goals))
+        candidates.push_back(entry.plan);
+    }
+  }
+
+  // The validators are checked outside of the lock because each one needs to
+  // look through the schedule.
+  std::sort(candidates.begin(), candidates.end(),
+    [](const auto& a, const auto& b)
+    {
+      return a.get_cost() < b.get_cost();
+    });
+
+  for (auto& candidate : candidates)
+  {
+    for (const auto& validator : validators)
+    {
+      if (!has_conflict(*validator, candidate))
+        return std::move(candidate);
+    }
+  }
+
+  return std::nullopt;
+}
+
+} // namespace services
+} // namespace rmf_fleet_adapter
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_FLEET_ADAPTER__SERVICES__NEGOTIATIONCACHE_HPP
+#define SRC__RMF_FLEET_ADAPTER__SERVICES__NEGOTIATIONCACHE_HPP
+
+#include <rmf_traffic/agv/Planner.hpp>
+#include <rmf_traffic/agv/RouteValidator.hpp>
+
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+
+namespace rmf_fleet_adapter {
+namespace services {
+
+//==============================================================================
+/// The plans that one robot has submitted while responding to negotiation
+/// tables. When the robot needs to respond to another table with the same
+/// starts and goals, such as a sibling or child of a table that it already
+/// responded to, the plans can be checked against the validators of the new
+/// table before any planning is done for it.
+///
+/// The heuristics of the planner are already shared by every search that uses
+/// the same planner, so only complete plans are kept here.
+class NegotiationCache
+{
+public:
+
+  using StartSet = rmf_traffic::agv::Plan::StartSet;
+  using Goal = rmf_traffic::agv::Plan::Goal;
+  using ValidatorPtr =
+    rmf_utils::clone_ptr<rmf_traffic::agv::NegotiatingRouteValidator>;
+
+  /// The number of plans that are kept. Once this is exceeded, the oldest
+  /// plans are forgotten.
+  static constexpr std::size_t capacity = 16;
+
+  /// Remember a plan that was submitted for these starts and goals. This
+  /// replaces any plan that was stored for the same starts and goals before.
+  void store(
+    const StartSet& starts,
+    const std::vector<Goal>& goals,
+    rmf_traffic::agv::Plan plan);
+
+  /// Find the cheapest plan for these starts and goals that has no conflicts
+  /// according to at least one of the validators.
+  ///
+  /// \param[in] below
+  ///   Only plans that cost less than this will be considered.
+  std::optional<rmf_traffic::agv::Plan> find(
+    const StartSet& starts,
+    const std::vector<Goal>& goals,
+    const std::vector<ValidatorPtr>& validators,
+    double below = std::numeric_limits<double>::infinity()) const;
+
+private:
+
+  struct Entry
+  {
+    StartSet starts;
+    std::vector<Goal> goals;
+    rmf_traffic::agv::Plan plan;
+  };
+
+  mutable std::mutex _mutex;
+  std::deque<Entry> _entries;
+};
+
+} // namespace services
+} // namespace rmf_fleet_adapter
+
+#endif // SRC__RMF_FLEET_ADAPTER__SERVICES__NEGOTIATIONCACHE_HPP
@@ -17,6 +17,8 @@
 
 #include "ProgressEvaluator.hpp"
 
+#include <cmath>
+
 namespace rmf_fleet_adapter {
 namespace services {
 
@@ -95,17 +97,18 @@ bool ProgressEvaluator::evaluate(Result& progress)
   const bool giveup = dropdead_cost <= cost;
   if (!progress.success() && !giveup)
   {
-    if (!best_result.progress)
+    const double best_cost = std::min(best_result.cost, incumbent_cost);
+    if (!best_result.progress && std::isinf(incumbent_cost))
     {
       progress.options().maximum_cost_estimate(
         std::min(estimate_leeway * cost, dropdead_cost));
 
       return true;
     }
-    else if (cost < best_result.cost)
+    else if (cost < best_cost)
     {
       progress.options().maximum_cost_estimate(
-        std::min(best_result.cost, dropdead_cost));
+        std::min(best_cost, dropdead_cost));
       return true;
     }
   }
@@ -57,6 +57,11 @@ struct ProgressEvaluator
   Info best_discarded;
   std::size_t finished_count = 0;
 
+  /// The cost of a valid plan that was found without this evaluator, such as
+  /// a plan that was reused from another negotiation table. Searches that
+  /// cannot find anything cheaper than this will be given up.
+  double incumbent_cost = std::numeric_limits<double>::infinity();
+
   double compliant_leeway_base;
 
   // TODO(MXG): This is redundant with SearchForPath::compliant_leeway, so we
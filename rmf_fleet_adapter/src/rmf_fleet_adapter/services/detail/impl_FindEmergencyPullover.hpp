@@ -40,6 +40,10 @@ void FindEmergencyPullover::operator()(const Subscriber& s)
         _planner, _starts, wp.index(), _schedule, _participant_id, _profile,
         std::chrono::seconds(5));
 
+      // The robot needs to get out of the way, so this goes ahead of every
+      // other kind of planning.
+      search->set_priority(rmf_rxcpp::JobPriority::emergency);
+
       // Be sure to initialize these individually and not in a single statement,
       // otherwise the logic might short-circuit one of the initialize() calls
       const bool keep_greedy =
@@ -19,7 +19,6 @@
 #define SRC__RMF_FLEET_ADAPTER__SERVICES__DETAIL__IMPL_NEGOTIATE_HPP
 
 #include "../Negotiate.hpp"
-#include "../../project_itinerary.hpp"
 
 namespace rmf_fleet_adapter {
 namespace services {
@@ -61,8 +60,31 @@ void Negotiate::operator()(const Subscriber& s)
     }
   }
 
-  const double initial_max_cost =
-    _evaluator.best_estimate.cost * _evaluator.estimate_leeway;
+  if (_cache)
+  {
+    // A plan that this robot submitted for another table can be used for this
+    // one too as long as it has no conflicts here.
+    _incumbent = _cache->find(_starts, _goals, validators);
+    if (_incumbent.has_value())
+      _evaluator.incumbent_cost = _incumbent->get_cost();
+  }
+
+  // The best estimate is a lower bound on the cost of any plan that the
+  // searches could find, so if the incumbent plan already meets it then there
+  // is no need to search at all. A small tolerance is allowed for rounding.
+  if (_incumbent.has_value()
+    && _evaluator.incumbent_cost <= _evaluator.best_estimate.cost + 1e-3)
+  {
+    _finished = true;
+    s.on_next(Result{shared_from_this(), _make_submission(*_incumbent)});
+    s.on_completed();
+    _release_jobs();
+    return;
+  }
+
+  const double initial_max_cost = std::min(
+    _evaluator.best_estimate.cost * _evaluator.estimate_leeway,
+    _evaluator.incumbent_cost);
 
   const std::size_t N_jobs = _queued_jobs.size();
 
@@ -80,81 +102,24 @@ void Negotiate::operator()(const Subscriber& s)
 
       if (self->_evaluator.finished_count >= N_jobs || *self->_interrupted)
       {
-        if (self->_evaluator.best_result.progress
-          && self->_evaluator.best_result.progress->success())
+        const auto* const best = self->_evaluator.best_result.progress;
+        if ((best && best->success()) || self->_incumbent.has_value())
         {
           self->_finished = true;
           // This means we found a successful plan to submit to the negotiation.
+          // Only the plan itself is kept, because the search state of the
+          // result is about to be released.
+          const bool use_best =
+            self->_evaluator.best_result.cost < self->_evaluator.incumbent_cost;
           s.on_next(
             Result{
               self->shared_from_this(),
-              [r = *self->_evaluator.best_result.progress,
-              initial_itinerary = std::move(self->_initial_itinerary),
-              followed_by = self->_followed_by,
-              planner = self->_planner,
-              approval = std::move(self->_approval),
-              responder = self->_responder,
-              viewer = self->_viewer,
-              plan_id = self->_plan_id]()
-              {
-                std::vector<rmf_traffic::Route> final_itinerary;
-                final_itinerary.reserve(
-                  initial_itinerary.size() + r->get_itinerary().size());
-
-                for (const auto& it : {initial_itinerary, r->get_itinerary()})
-                {
-                  for (const auto& route : it)
-                  {
-                    if (route.trajectory().size() > 1)
-                      final_itinerary.push_back(route);
-                  }
-                }
-
-                final_itinerary = project_itinerary(*r, followed_by, *planner);
-                for (const auto& parent : viewer->base_proposals())
-                {
-                  // Make sure all parent dependencies are accounted for
-                  // TODO(MXG): This is kind of a gross hack that we add to
-                  // force the lookahead to work for patrols. This approach
-                  // should be reworked in a future redesign of the traffic
-                  // system.
-                  for (auto& r : final_itinerary)
-                  {
-                    for (std::size_t i = 0; i < parent.itinerary.size(); ++i)
-                    {
-                      r.add_dependency(
-                        r.trajectory().size(),
-                        rmf_traffic::Dependency{
-                          parent.participant,
-                          parent.plan,
-                          i,
-                          parent.itinerary[i].trajectory().size()
-                        });
-                    }
-                  }
-                }
-
-                responder->submit(
-                  plan_id,
-                  final_itinerary,
-                  [
-                    plan_id,
-                    plan = *r,
-                    approval = std::move(approval),
-                    final_itinerary
-                  ]()
-                  -> UpdateVersion
-                  {
-                    if (approval)
-                      return approval(plan_id, plan, final_itinerary);
-
-                    return rmf_utils::nullopt;
-                  });
-              }
+              self->_make_submission(use_best ? **best : *self->_incumbent)
             });
 
           s.on_completed();
           self->interrupt();
+          self->_release_jobs();
           return true;
         }
         else if (self->_alternatives && !self->_alternatives->empty())
@@ -173,6 +138,7 @@ void Negotiate::operator()(const Subscriber& s)
 
           s.on_completed();
           self->interrupt();
+          self->_release_jobs();
           return true;
         }
         else if (!self->_attempting_rollout)
@@ -194,6 +160,7 @@ void Negotiate::operator()(const Subscriber& s)
 
           s.on_completed();
           self->interrupt();
+          self->_release_jobs();
           return true;
         }
 
@@ -204,7 +171,10 @@ void Negotiate::operator()(const Subscriber& s)
       return false;
     };
 
-  _search_sub = rmf_rxcpp::make_job_from_action_list(_queued_jobs)
+  // Other fleets are waiting on our response, so these jobs go ahead of any
+  // routine replanning.
+  _search_sub = rmf_rxcpp::make_planning_job_from_action_list(
+    _queued_jobs, rmf_rxcpp::JobPriority::negotiation)
     .observe_on(rxcpp::observe_on_event_loop())
     .subscribe(
     [n_weak = weak_from_this(), s,
@@ -222,9 +192,15 @@ void Negotiate::operator()(const Subscriber& s)
       {
         s.on_next(Result{n, []() {}});
         s.on_completed();
+        n->_release_jobs();
         return;
       }
 
+      // A job may have finished a step after the negotiation concluded or
+      // after the job was discarded. Its progress is of no use to us anymore.
+      if (n->_finished || !result.job->active())
+        return;
+
       bool resume = false;
       if (n->_evaluator.evaluate(result.job->progress()))
       {
@@ -112,6 +112,21 @@ public:
 
     this->_prefix = std::move(prefix);
     this->_fleet_name = std::move(fleet_name);
+    _fleet_state.name = _fleet_name;
+
+    // Robot states that arrive within the same publishing period get coalesced
+    // into a single fleet state message. A period of zero publishes a fleet
+    // state for every robot state update that arrives.
+    const double publish_period =
+      this->declare_parameter("publish_period", 0.1);
+
+    if (publish_period > 0.0)
+    {
+      _publish_timer = create_wall_timer(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(publish_period)),
+        [this]() { _publish_if_changed(); });
+    }
   }
 
 private:
@@ -126,10 +141,16 @@ private:
   std::string _namespace;
 #endif
 
-  std::unordered_map<std::string, std::unique_ptr<RobotState>> _latest_states;
+  // The latest state of each robot is kept inside of the fleet state message
+  // that gets published, so that robots whose states have not changed never
+  // need to be copied again.
+  FleetState _fleet_state;
+  std::unordered_map<std::string, std::size_t> _robot_index;
+  bool _changed = false;
 
   rclcpp::Publisher<FleetState>::SharedPtr _fleet_state_pub;
   rclcpp::Subscription<RobotState>::SharedPtr _robot_state_sub;
+  rclcpp::TimerBase::SharedPtr _publish_timer;
 
 #ifdef FAILOVER_MODE
   rclcpp::Subscription<stubborn_buddies_msgs::msg::Status>::SharedPtr
@@ -145,32 +166,33 @@ private:
     if (name.substr(0, _prefix.size()) != _prefix)
       return;
 
-    const auto insertion = _latest_states.insert(std::make_pair(name, nullptr));
-    const auto it = insertion.first;
-    bool updated = false;
+    const auto insertion =
+      _robot_index.insert({name, _fleet_state.robots.size()});
     if (insertion.second)
     {
-      it->second = std::move(msg);
-      updated = true;
+      _fleet_state.robots.emplace_back(std::move(*msg));
     }
     else
     {
-      if (rclcpp::Time(it->second->location.t) < rclcpp::Time(msg->location.t) )
-      {
-        it->second = std::move(msg);
-        updated = true;
-      }
+      auto& latest = _fleet_state.robots[insertion.first->second];
+      if (rclcpp::Time(msg->location.t) <= rclcpp::Time(latest.location.t))
+        return;
+
+      latest = std::move(*msg);
     }
 
-    if (updated)
-    {
-      FleetState fleet;
-      fleet.name = _fleet_name;
-      for (const auto& robot_state : _latest_states)
-        fleet.robots.emplace_back(*robot_state.second);
+    _changed = true;
+    if (!_publish_timer)
+      _publish_if_changed();
+  }
 
-      _fleet_state_pub->publish(fleet);
-    }
+  void _publish_if_changed()
+  {
+    if (!_changed)
+      return;
+
+    _changed = false;
+    _fleet_state_pub->publish(_fleet_state);
   }
 
 };
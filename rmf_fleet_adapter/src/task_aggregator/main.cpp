@@ -22,34 +22,67 @@
 
 #include <rmf_task_msgs/msg/tasks.hpp>
 #include <rmf_task_msgs/msg/task_summary.hpp>
+#include <rmf_task_msgs/srv/get_task_list.hpp>
 
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 class TaskAggregator : public rclcpp::Node
 {
 
   using TaskSummary = rmf_task_msgs::msg::TaskSummary;
   using Tasks = rmf_task_msgs::msg::Tasks;
+  using GetTaskList = rmf_task_msgs::srv::GetTaskList;
 
 public:
+
+  struct Retention
+  {
+    /// Most tasks in a terminal state to keep. Zero keeps all of them.
+    std::size_t max_terminal_tasks = 1000;
+
+    /// Longest time to keep a task after it reaches a terminal state. Zero
+    /// keeps them until max_terminal_tasks pushes them out.
+    std::chrono::nanoseconds max_terminal_age = std::chrono::hours(1);
+  };
+
   TaskAggregator(
     std::string node_name,
     std::string input_topic,
-    double rate)
+    double rate,
+    double snapshot_period,
+    Retention retention)
   : Node(node_name),
-    _rate(rate)
+    _rate(rate),
+    _retention(retention)
   {
-    // Create a wall timer to periodically publish Tasks msg
+    // Create a wall timer to periodically publish the summaries that changed
     const double period = 1.0/_rate;
     auto timer_period = std::chrono::duration_cast<std::chrono::nanoseconds>(
       std::chrono::duration<double, std::ratio<1>>(period));
     _timer = this->create_wall_timer(
       timer_period, std::bind(&TaskAggregator::timer_callback, this));
 
-    // Create publisher for Tasks msg
+    // Create a wall timer to periodically publish every summary that is kept
+    auto snapshot_timer_period =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double, std::ratio<1>>(snapshot_period));
+    _snapshot_timer = this->create_wall_timer(
+      snapshot_timer_period,
+      std::bind(&TaskAggregator::snapshot_callback, this));
+
+    // Create publisher for full snapshots in a Tasks msg
     _tasks_pub = this->create_publisher<Tasks>(
       "/tasks",
       rclcpp::ServicesQoS());
 
+    // Create publisher for the summaries that changed since the last tick
+    _task_updates_pub = this->create_publisher<Tasks>(
+      "/task_updates",
+      rclcpp::ServicesQoS());
+
     // Create subscription to receive TaskSummary msgs from fleet adapters
     _cb_group_task_summary = this->create_callback_group(
       rclcpp::CallbackGroupType::MutuallyExclusive);
@@ -65,6 +98,15 @@ public:
         std::placeholders::_1),
       sub_map_opt);
 
+    // Create a service to get the full list on demand
+    _get_tasks_srv = this->create_service<GetTaskList>(
+      "~/get_tasks",
+      std::bind(
+        &TaskAggregator::get_tasks_cb,
+        this,
+        std::placeholders::_1,
+        std::placeholders::_2));
+
     RCLCPP_INFO(
       get_logger(),
       "Listening for Task Summaries on topic /%s",
@@ -73,35 +115,178 @@ public:
 
 private:
 
+  struct Entry
+  {
+    TaskSummary summary;
+
+    // When the task reached a terminal state, if it has
+    std::optional<rclcpp::Time> terminal_since;
+
+    // True if the summary is waiting to be published as an update
+    bool changed = false;
+  };
+
+  static bool is_terminal(const TaskSummary& summary)
+  {
+    return summary.state == TaskSummary::STATE_COMPLETED
+      || summary.state == TaskSummary::STATE_FAILED
+      || summary.state == TaskSummary::STATE_CANCELED;
+  }
+
   void timer_callback()
   {
     Tasks tasks;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _cull(now());
+
+      for (const auto& task_id : _changed)
+      {
+        const auto it = _db.find(task_id);
+        if (it == _db.end())
+          continue;
 
-    for (const auto& t : _db)
-      tasks.tasks.push_back(t.second);
+        it->second.changed = false;
+        tasks.tasks.push_back(it->second.summary);
+      }
+      _changed.clear();
+    }
+
+    if (!tasks.tasks.empty())
+      _task_updates_pub->publish(tasks);
+  }
+
+  void snapshot_callback()
+  {
+    Tasks tasks;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _cull(now());
+
+      tasks.tasks.reserve(_db.size());
+      for (const auto& t : _db)
+        tasks.tasks.push_back(t.second.summary);
+    }
 
     _tasks_pub->publish(tasks);
   }
 
   void task_summary_cb(const TaskSummary::SharedPtr msg)
   {
-    if (_db.find(msg->task_id) != _db.end())
+    const auto time = now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& entry = _db[msg->task_id];
+    entry.summary = *msg;
+
+    if (!entry.changed)
     {
-      _db[msg->task_id] = *msg;
+      entry.changed = true;
+      _changed.push_back(msg->task_id);
+    }
+
+    if (!is_terminal(entry.summary))
+    {
+      if (entry.terminal_since.has_value())
+        --_terminal_count;
+
+      entry.terminal_since = std::nullopt;
+    }
+    else if (!entry.terminal_since.has_value())
+    {
+      entry.terminal_since = time;
+      _terminal_order.push_back({time, msg->task_id});
+      ++_terminal_count;
+    }
+
+    _cull(time);
+  }
+
+  void get_tasks_cb(
+    const GetTaskList::Request::SharedPtr request,
+    GetTaskList::Response::SharedPtr response)
+  {
+    const auto add = [&response](const TaskSummary& summary)
+      {
+        if (is_terminal(summary))
+          response->terminated_tasks.push_back(summary);
+        else
+          response->active_tasks.push_back(summary);
+      };
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (request->task_id.empty())
+    {
+      for (const auto& t : _db)
+        add(t.second.summary);
     }
     else
     {
-      _db.insert(std::make_pair(msg->task_id, *msg));
+      for (const auto& task_id : request->task_id)
+      {
+        const auto it = _db.find(task_id);
+        if (it != _db.end())
+          add(it->second.summary);
+      }
+    }
+
+    response->success = true;
+  }
+
+  /// Forget the tasks that have been in a terminal state for too long, oldest
+  /// first. This must be called while _mutex is locked.
+  void _cull(const rclcpp::Time& time)
+  {
+    const auto max_count = _retention.max_terminal_tasks;
+    const auto max_age = rclcpp::Duration(_retention.max_terminal_age);
+    while (!_terminal_order.empty())
+    {
+      const auto& [since, task_id] = _terminal_order.front();
+
+      // The task might have left its terminal state or reached it again since
+      // this record was made. Then the record is stale, so we drop it without
+      // touching the task.
+      const auto it = _db.find(task_id);
+      if (it == _db.end() || it->second.terminal_since != since)
+      {
+        _terminal_order.pop_front();
+        continue;
+      }
+
+      const bool too_many = max_count > 0 && _terminal_count > max_count;
+      const bool too_old = max_age.nanoseconds() > 0
+        && since + max_age < time;
+
+      if (!too_many && !too_old)
+        break;
+
+      _db.erase(it);
+      --_terminal_count;
+      _terminal_order.pop_front();
     }
   }
 
   double _rate;
+  Retention _retention;
 
-  std::unordered_map<std::string, TaskSummary> _db;
+  std::mutex _mutex;
+  std::unordered_map<std::string, Entry> _db;
+
+  // The IDs of the summaries that changed since the last update, in the order
+  // that they first changed
+  std::vector<std::string> _changed;
+
+  // The tasks in the order that they reached a terminal state. This can hold
+  // stale records of tasks that have since left their terminal state, so the
+  // tasks that are currently terminal are counted separately.
+  std::deque<std::pair<rclcpp::Time, std::string>> _terminal_order;
+  std::size_t _terminal_count = 0;
 
   rclcpp::TimerBase::SharedPtr _timer;
+  rclcpp::TimerBase::SharedPtr _snapshot_timer;
   rclcpp::Publisher<Tasks>::SharedPtr _tasks_pub;
+  rclcpp::Publisher<Tasks>::SharedPtr _task_updates_pub;
   rclcpp::Subscription<TaskSummary>::SharedPtr _task_summary_sub;
+  rclcpp::Service<GetTaskList>::SharedPtr _get_tasks_srv;
   rclcpp::CallbackGroup::SharedPtr _cb_group_task_summary;
 };
 
@@ -148,10 +333,33 @@ int main(int argc, char* argv[])
   get_arg(args, "-r", rate_string, "rate", false);
   double rate = rate_string.empty() ? 1.0 : std::stod(rate_string);
 
+  std::string snapshot_string;
+  get_arg(args, "-s", snapshot_string, "snapshot period in seconds", false);
+  double snapshot_period =
+    snapshot_string.empty() ? 10.0 : std::stod(snapshot_string);
+
+  TaskAggregator::Retention retention;
+  std::string count_string;
+  get_arg(args, "-c", count_string, "number of finished tasks to keep", false);
+  if (!count_string.empty())
+    retention.max_terminal_tasks = std::stoul(count_string);
+
+  std::string age_string;
+  get_arg(
+    args, "-a", age_string, "seconds to keep each finished task", false);
+  if (!age_string.empty())
+  {
+    retention.max_terminal_age =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(std::stod(age_string)));
+  }
+
   auto task_aggregator_node = std::make_shared<TaskAggregator>(
     node_name,
     input_topic,
-    rate);
+    rate,
+    snapshot_period,
+    retention);
 
   rclcpp::spin(task_aggregator_node);
 
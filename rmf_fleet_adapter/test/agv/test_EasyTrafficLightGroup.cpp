@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <agv/internal_EasyTrafficLightGroup.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+#include <rmf_traffic_ros2/blockade/Node.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+#include "../thread_cooldown.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+//==============================================================================
+template<typename Condition>
+bool eventually(Condition condition)
+{
+  using namespace std::chrono_literals;
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  while (std::chrono::steady_clock::now() < deadline)
+  {
+    if (condition())
+      return true;
+
+    std::this_thread::sleep_for(50ms);
+  }
+
+  return condition();
+}
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Update a group of easy traffic lights in batches")
+{
+  using namespace std::chrono_literals;
+  using Group = rmf_fleet_adapter::agv::EasyTrafficLightGroup;
+  using MovingInstruction = Group::MovingInstruction;
+  using WaitingInstruction = Group::WaitingInstruction;
+  rmf_fleet_adapter_test::thread_cooldown = true;
+
+  auto rcl_context = std::make_shared<rclcpp::Context>();
+  rcl_context->init(0, nullptr);
+  const auto options = rclcpp::NodeOptions().context(rcl_context);
+
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  const auto node = rmf_fleet_adapter::agv::Node::make(
+    worker, "test_EasyTrafficLightGroup", options);
+  node->add_node(rmf_traffic_ros2::blockade::make_node(
+      "test_EasyTrafficLightGroup_blockade", options));
+
+  const auto blockade_writer =
+    rmf_traffic_ros2::blockade::Writer::make(*node);
+
+  const rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(1.0)
+  };
+
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.7, 0.3},
+    {1.0, 0.45},
+    profile
+  };
+
+  auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  std::vector<rmf_traffic::schedule::Participant> itineraries;
+  for (const auto& name : {"robot_0", "robot_1"})
+  {
+    itineraries.push_back(
+      rmf_traffic::schedule::make_participant(
+        rmf_traffic::schedule::ParticipantDescription{
+          name,
+          "test_EasyTrafficLightGroup",
+          rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+          profile
+        },
+        database));
+  }
+
+  const auto group = Group::Implementation::make(
+    [](std::vector<Group::RobotCommand>) {},
+    nullptr,
+    std::make_shared<rmf_traffic::schedule::Mirror>(),
+    worker,
+    node,
+    traits,
+    std::move(itineraries),
+    blockade_writer,
+    nullptr);
+
+  REQUIRE(group->size() == 2);
+  node->start();
+
+  WHEN("The robots have no path")
+  {
+    const auto moving = group->moving_from(
+      {{0, 0, {0.0, 0.0, 0.0}}, {1, 0, {0.0, 50.0, 0.0}}});
+    CHECK(moving == std::vector<MovingInstruction>{
+        MovingInstruction::MovingError, MovingInstruction::MovingError});
+
+    const auto waiting = group->waiting(
+      {{0, 0, std::nullopt}, {1, 0, Eigen::Vector3d(0.0, 50.0, 0.0)}});
+    CHECK(waiting == std::vector<WaitingInstruction>{
+        WaitingInstruction::WaitingError, WaitingInstruction::WaitingError});
+  }
+
+  WHEN("A batch names a robot that is not in the group")
+  {
+    CHECK_THROWS_AS(
+      (void)(group->waiting({{0, 0, std::nullopt}, {2, 0, std::nullopt}})),
+      std::out_of_range);
+
+    // Every robot is checked before any of them are locked, so the robots
+    // that are in the group can still be updated.
+    const auto waiting = group->waiting({{0, 0, std::nullopt}});
+    CHECK(waiting == std::vector<WaitingInstruction>{
+        WaitingInstruction::WaitingError});
+  }
+
+  WHEN("Both robots are given paths in one batch")
+  {
+    const std::string map = "test_map";
+    const auto make_path = [&](const double y)
+      {
+        return std::vector<rmf_fleet_adapter::agv::Waypoint>{
+          {map, {0.0, y, 0.0}},
+          {map, {5.0, y, 0.0}},
+          {map, {10.0, y, 0.0}}
+        };
+      };
+
+    group->follow_new_paths({{0, make_path(0.0)}, {1, make_path(50.0)}});
+
+    THEN("Both robots may leave their first checkpoint")
+    {
+      // The robots may need to wait while their plans are found and the
+      // blockade moderator gives them their ranges.
+      std::vector<WaitingInstruction> waiting;
+      CHECK(eventually(
+          [&]()
+          {
+            waiting = group->waiting(
+              {{0, 0, std::nullopt}, {1, 0, std::nullopt}});
+            return waiting == std::vector<WaitingInstruction>{
+              WaitingInstruction::Resume, WaitingInstruction::Resume};
+          }));
+
+      std::vector<MovingInstruction> moving;
+      CHECK(eventually(
+          [&]()
+          {
+            moving = group->moving_from(
+              {{1, 0, {1.0, 50.0, 0.0}}, {0, 0, {1.0, 0.0, 0.0}}});
+            return moving == std::vector<MovingInstruction>{
+              MovingInstruction::ContinueAtNextCheckpoint,
+              MovingInstruction::ContinueAtNextCheckpoint};
+          }));
+    }
+  }
+
+  node->stop();
+}
+
+//==============================================================================
+SCENARIO("Commands from a group of easy traffic lights are merged in order")
+{
+  using namespace std::chrono_literals;
+  using Group = rmf_fleet_adapter::agv::EasyTrafficLightGroup;
+  using Command = Group::Command;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<std::vector<Group::RobotCommand>> batches;
+
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  const auto commands = std::make_shared<Group::Implementation::Commands>(
+    [&](std::vector<Group::RobotCommand> batch)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      batches.push_back(std::move(batch));
+      cv.notify_all();
+    }, worker);
+
+  // Commands that are issued by the same job get delivered together once the
+  // job is finished.
+  worker.schedule(
+    [commands](const auto&)
+    {
+      commands->push(1, Command::Pause);
+      commands->push(0, Command::Pause);
+      commands->push(1, Command::Resume);
+      commands->push(0, Command::Resume);
+    });
+
+  std::unique_lock<std::mutex> lock(mutex);
+  REQUIRE(cv.wait_for(lock, 5s, [&]() { return !batches.empty(); }));
+
+  // Give any stray batch a chance to show up
+  cv.wait_for(lock, 100ms, [&]() { return batches.size() > 1; });
+  REQUIRE(batches.size() == 1);
+
+  const auto& batch = batches.front();
+  REQUIRE(batch.size() == 4);
+  CHECK(batch[0].robot == 1);
+  CHECK(batch[0].command == Command::Pause);
+  CHECK(batch[1].robot == 0);
+  CHECK(batch[1].command == Command::Pause);
+  CHECK(batch[2].robot == 1);
+  CHECK(batch[2].command == Command::Resume);
+  CHECK(batch[3].robot == 0);
+  CHECK(batch[3].command == Command::Resume);
+}
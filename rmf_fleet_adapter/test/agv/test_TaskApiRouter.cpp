@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <agv/TaskApiRouter.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+using rmf_fleet_adapter::agv::TaskApiRouter;
+
+SCENARIO("Task API router")
+{
+  const auto router = TaskApiRouter::make();
+
+  // The immediate scheduler runs each request inside of route(), which makes
+  // the results easy to check.
+  const auto worker = rxcpp::schedulers::make_immediate().create_worker();
+
+  std::vector<std::string> received_a;
+  std::vector<std::string> received_b;
+  const auto a = router->add_recipient(
+    "fleet", "robot_a", worker,
+    [&](const nlohmann::json&, const std::string& id)
+    {
+      received_a.push_back(id);
+    });
+
+  auto b = router->add_recipient(
+    "fleet", "robot_b", worker,
+    [&](const nlohmann::json&, const std::string& id)
+    {
+      received_b.push_back(id);
+    });
+
+  CHECK(router->recipients() == 2);
+
+  const auto cancel = [](const std::string& task_id)
+    {
+      return nlohmann::json{
+        {"type", "cancel_task_request"}, {"task_id", task_id}}.dump();
+    };
+
+  WHEN("Tasks are claimed")
+  {
+    a->claim("task_1");
+    b->claim("task_2");
+    CHECK(router->claimed_tasks() == 2);
+
+    CHECK(router->route(cancel("task_1"), "r1") == 1);
+    CHECK(router->route(cancel("task_2"), "r2") == 1);
+    CHECK(router->route(cancel("task_3"), "r3") == 0);
+    CHECK(received_a == std::vector<std::string>{"r1"});
+    CHECK(received_b == std::vector<std::string>{"r2"});
+
+    THEN("A new claim takes the task over")
+    {
+      b->claim("task_1");
+      a->release("task_1");
+      CHECK(router->route(cancel("task_1"), "r4") == 1);
+      CHECK(received_b.back() == "r4");
+      CHECK(router->claimed_tasks() == 2);
+    }
+
+    THEN("Removing a recipient releases its tasks")
+    {
+      b.reset();
+      CHECK(router->recipients() == 1);
+      CHECK(router->claimed_tasks() == 1);
+      CHECK(router->route(cancel("task_2"), "r5") == 0);
+    }
+  }
+
+  WHEN("A robot task request arrives")
+  {
+    nlohmann::json request = {
+      {"type", "robot_task_request"},
+      {"fleet", "fleet"},
+      {"robot", "robot_b"},
+      {"request", {}}
+    };
+
+    CHECK(router->route(request.dump(), "r1") == 1);
+    CHECK(received_b == std::vector<std::string>{"r1"});
+
+    request["fleet"] = "other_fleet";
+    CHECK(router->route(request.dump(), "r2") == 0);
+  }
+
+  WHEN("Requests cannot be routed")
+  {
+    // A request without its task ID still goes to one recipient so that it
+    // can report the validation error.
+    CHECK(router->route(
+        nlohmann::json{{"type", "kill_task_request"}}.dump(), "r1") == 1);
+
+    // Requests that are not meant for robots are dropped
+    CHECK(router->route(
+        nlohmann::json{{"type", "dispatch_task_request"}}.dump(), "r2") == 0);
+    CHECK(router->route(nlohmann::json::object().dump(), "r3") == 0);
+    CHECK(received_a.size() + received_b.size() == 1);
+
+    CHECK_THROWS(router->route("{not json", "r4"));
+  }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <agv/TimerWheel.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+using rmf_fleet_adapter::agv::TimerWheel;
+using namespace std::chrono_literals;
+
+SCENARIO("Timer wheel")
+{
+  const auto start = TimerWheel::Clock::now();
+  const auto wheel = TimerWheel::make(10ms, start);
+
+  // The immediate scheduler runs each trigger inside of advance(), which makes
+  // the results easy to check.
+  const auto worker = rxcpp::schedulers::make_immediate().create_worker();
+
+  std::size_t short_count = 0;
+  std::size_t long_count = 0;
+  const auto short_timer = wheel->schedule(
+    100ms, worker, [&]() { ++short_count; });
+  const auto long_timer = wheel->schedule(
+    1h, worker, [&]() { ++long_count; });
+  CHECK(wheel->size() == 2);
+
+  WHEN("The wheel advances")
+  {
+    wheel->advance(start + 95ms);
+    CHECK(short_count == 0);
+
+    wheel->advance(start + 105ms);
+    CHECK(short_count == 1);
+
+    wheel->advance(start + 1005ms);
+    CHECK(short_count == 10);
+    CHECK(long_count == 0);
+
+    // Cross several cascades of the higher levels
+    wheel->advance(start + 1h + 10ms);
+    CHECK(long_count == 1);
+  }
+
+  WHEN("A timer is cancelled")
+  {
+    short_timer->cancel();
+    CHECK(short_timer->is_canceled());
+    wheel->advance(start + 1s);
+    CHECK(short_count == 0);
+    CHECK(wheel->size() == 1);
+
+    short_timer->reset();
+    CHECK_FALSE(short_timer->is_canceled());
+    CHECK(wheel->size() == 2);
+  }
+
+  WHEN("A timer is reset before it triggers")
+  {
+    const auto timer = wheel->schedule(500ms, worker, [&]() { ++long_count; });
+    wheel->advance(start + 300ms);
+    timer->reset();
+    wheel->advance(start + 600ms);
+    CHECK(long_count == 0);
+
+    wheel->advance(start + 1s);
+    CHECK(long_count == 1);
+  }
+
+  WHEN("A handle is destroyed")
+  {
+    auto timer = wheel->schedule(50ms, worker, [&]() { ++long_count; });
+    timer.reset();
+    wheel->advance(start + 1s);
+    CHECK(long_count == 0);
+    CHECK(wheel->size() == 2);
+  }
+}
+
+SCENARIO("Timer wheel level boundaries")
+{
+  const auto start = TimerWheel::Clock::now();
+  const auto wheel = TimerWheel::make(10ms, start);
+  const auto worker = rxcpp::schedulers::make_immediate().create_worker();
+
+  std::size_t count = 0;
+
+  WHEN("A timer is due on the first tick of the second level")
+  {
+    // 64 ticks
+    const auto timer = wheel->schedule(640ms, worker, [&]() { ++count; });
+    wheel->advance(start + 635ms);
+    CHECK(count == 0);
+
+    wheel->advance(start + 645ms);
+    CHECK(count == 1);
+  }
+
+  WHEN("A timer is due on the first tick of the third level")
+  {
+    // 4096 ticks
+    const auto timer = wheel->schedule(40960ms, worker, [&]() { ++count; });
+    wheel->advance(start + 40955ms);
+    CHECK(count == 0);
+
+    wheel->advance(start + 40965ms);
+    CHECK(count == 1);
+  }
+}
+
+SCENARIO("Timer wheel activity")
+{
+  const auto wheel = TimerWheel::make(10ms);
+  const auto worker = rxcpp::schedulers::make_immediate().create_worker();
+
+  std::size_t activated = 0;
+  wheel->on_active([&]() { ++activated; });
+
+  auto first = wheel->schedule(1s, worker, []() {});
+  CHECK(activated == 1);
+
+  auto second = wheel->schedule(1s, worker, []() {});
+  CHECK(activated == 1);
+
+  first.reset();
+  second.reset();
+  wheel->advance(TimerWheel::Clock::now() + 2s);
+  CHECK(wheel->size() == 0);
+
+  const auto third = wheel->schedule(1s, worker, []() {});
+  CHECK(activated == 2);
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures how much memory a storm of negotiations holds onto. Each round
+// starts many negotiations between two robots whose paths cross, and keeps the
+// Negotiate services alive after they have responded, the way a fleet adapter
+// keeps them until the negotiation is closed. The planner search states that
+// the services are still holding and the resident memory of the process are
+// reported after every round.
+
+#include <services/Negotiate.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+using Negotiate = rmf_fleet_adapter::services::Negotiate;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr std::size_t NumRounds = 5;
+
+//==============================================================================
+/// Resident memory of the process in MiB
+double resident_mib()
+{
+  std::ifstream statm("/proc/self/statm");
+  std::size_t size = 0;
+  std::size_t resident = 0;
+  statm >> size >> resident;
+  return static_cast<double>(resident * sysconf(_SC_PAGESIZE))
+    / (1024.0 * 1024.0);
+}
+
+//==============================================================================
+/// Peak resident memory of the process in MiB
+double peak_mib()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+//==============================================================================
+int64_t alive(const std::string& category)
+{
+  return rmf_fleet_adapter::get_job_metrics().category(category).alive.load();
+}
+
+//==============================================================================
+struct Robot
+{
+  rmf_traffic::schedule::Participant participant;
+  rmf_traffic::agv::Plan::Start start;
+  rmf_traffic::agv::Plan::Goal goal;
+};
+
+//==============================================================================
+/// Counts the Negotiate services that have responded
+class Responses
+{
+public:
+
+  void received()
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_received;
+    _cv.notify_all();
+  }
+
+  void wait(const std::size_t count)
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [&]() { return _received >= count; });
+  }
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::size_t _received = 0;
+};
+
+//==============================================================================
+void run_storm(
+  const std::shared_ptr<rmf_traffic::schedule::Database>& database,
+  const std::shared_ptr<const rmf_traffic::agv::Planner>& planner,
+  const std::vector<Robot>& robots,
+  const std::size_t negotiations)
+{
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  std::vector<rmf_traffic::schedule::ParticipantId> participants;
+  for (const auto& r : robots)
+    participants.push_back(r.participant.id());
+
+  // Everything is kept alive until the end of the round
+  std::vector<std::shared_ptr<rmf_traffic::schedule::Negotiation>> rooms;
+  std::vector<std::shared_ptr<Negotiate>> services;
+  std::vector<rmf_rxcpp::subscription_guard> subscriptions;
+  Responses responses;
+
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < negotiations; ++i)
+  {
+    const auto negotiation = rmf_traffic::schedule::Negotiation::make_shared(
+      database->snapshot(), participants);
+    rooms.push_back(negotiation);
+
+    for (const auto& r : robots)
+    {
+      const auto table = negotiation->table(r.participant.id(), {});
+      auto negotiate = Negotiate::path(
+        0, planner, {r.start}, r.goal, {}, table->viewer(),
+        std::make_shared<rmf_traffic::schedule::SimpleResponder>(table),
+        nullptr, rmf_fleet_adapter::services::ProgressEvaluator());
+
+      subscriptions.emplace_back(
+        rmf_rxcpp::make_job<Negotiate::Result>(negotiate)
+        .observe_on(rxcpp::identity_same_worker(worker))
+        .subscribe(
+          [&responses](const Negotiate::Result& result)
+          {
+            result.respond();
+            responses.received();
+          }));
+
+      services.push_back(std::move(negotiate));
+    }
+  }
+
+  responses.wait(services.size());
+  const auto duration = std::chrono::duration<double, std::milli>(
+    Clock::now() - start).count();
+
+  std::cout << "  " << services.size() << " services responded in "
+            << duration << "ms, live search states "
+            << alive(rmf_fleet_adapter::jobs::Planning::search_state_category)
+            << ", resident " << resident_mib() << "MiB, peak "
+            << peak_mib() << "MiB" << std::endl;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::vector<std::size_t> sizes = {1, 10, 50, 100};
+  if (argc > 1)
+  {
+    sizes.clear();
+    for (int i = 1; i < argc; ++i)
+      sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+  }
+
+  const auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  const rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(1.0)
+  };
+
+  const auto make_participant = [&](const std::string& name)
+    {
+      return rmf_traffic::schedule::make_participant(
+        rmf_traffic::schedule::ParticipantDescription{
+          name,
+          "negotiation_memory",
+          rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+          profile
+        },
+        database);
+    };
+
+  /*
+   *                   8------9
+   *                   |      |
+   *     3------4------5------6------7
+   *                   |      |
+   *                   1------2
+   *                   |
+   *                   0
+   **/
+  const std::string map = "test_map";
+  rmf_traffic::agv::Graph graph;
+  graph.add_waypoint(map, {0.0, -10.0}); // 0
+  graph.add_waypoint(map, {0.0, -5.0}); // 1
+  graph.add_waypoint(map, {5.0, -5.0}).set_holding_point(true); // 2
+  graph.add_waypoint(map, {-10.0, 0.0}); // 3
+  graph.add_waypoint(map, {-5.0, 0.0}); // 4
+  graph.add_waypoint(map, {0.0, 0.0}); // 5
+  graph.add_waypoint(map, {5.0, 0.0}); // 6
+  graph.add_waypoint(map, {10.0, 0.0}); // 7
+  graph.add_waypoint(map, {0.0, 5.0}); // 8
+  graph.add_waypoint(map, {5.0, 5.0}).set_holding_point(true); // 9
+
+  const auto add_bidir_lane = [&](const std::size_t w0, const std::size_t w1)
+    {
+      graph.add_lane(w0, w1);
+      graph.add_lane(w1, w0);
+    };
+
+  add_bidir_lane(0, 1);
+  add_bidir_lane(1, 2);
+  add_bidir_lane(1, 5);
+  add_bidir_lane(2, 6);
+  add_bidir_lane(3, 4);
+  add_bidir_lane(4, 5);
+  add_bidir_lane(5, 6);
+  add_bidir_lane(6, 7);
+  add_bidir_lane(5, 8);
+  add_bidir_lane(6, 9);
+  add_bidir_lane(8, 9);
+
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.7, 0.3},
+    {1.0, 0.45},
+    profile
+  };
+
+  const auto planner = std::make_shared<const rmf_traffic::agv::Planner>(
+    rmf_traffic::agv::Planner::Configuration{graph, traits},
+    rmf_traffic::agv::Planner::Options{nullptr, std::chrono::seconds(1)});
+
+  // The two robots drive towards each other through the middle of the graph
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<Robot> robots;
+  using Start = rmf_traffic::agv::Plan::Start;
+  using Goal = rmf_traffic::agv::Plan::Goal;
+  robots.push_back({make_participant("robot_1"), Start(now, 3, 0.0), Goal(7)});
+  robots.push_back({make_participant("robot_2"), Start(now, 7, 0.0), Goal(3)});
+
+  for (auto& r : robots)
+  {
+    const auto plan = planner->plan(r.start, r.goal);
+    if (!plan)
+    {
+      std::cerr << "Unable to find an initial plan" << std::endl;
+      return 1;
+    }
+
+    r.participant.set(r.participant.assign_plan_id(), plan->get_itinerary());
+  }
+
+  std::cout << "resident at start " << resident_mib() << "MiB" << std::endl;
+  for (const auto n : sizes)
+  {
+    std::cout << n << " negotiations:" << std::endl;
+    for (std::size_t round = 0; round < NumRounds; ++round)
+      run_storm(database, planner, robots, n);
+
+    std::cout << "  resident after the rounds " << resident_mib() << "MiB, "
+              << "live search states "
+              << alive(rmf_fleet_adapter::jobs::Planning::search_state_category)
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures the latency of task API requests as the number of robots in a fleet
+// adapter grows, comparing every robot parsing every request against the
+// TaskApiRouter parsing each request once. Like in the fleet adapter, all the
+// robots share one worker.
+
+#include <agv/TaskApiRouter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using TaskApiRouter = rmf_fleet_adapter::agv::TaskApiRouter;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr std::size_t NumRequests = 2000;
+constexpr std::size_t TasksPerRobot = 5;
+
+//==============================================================================
+std::string task_id(const std::size_t robot, const std::size_t task)
+{
+  return "task_" + std::to_string(robot) + "_" + std::to_string(task);
+}
+
+//==============================================================================
+std::string cancel_request(const std::string& task)
+{
+  return nlohmann::json{
+    {"type", "cancel_task_request"},
+    {"task_id", task},
+    {"labels", {"benchmark", "operator:alice", "reason:blocked corridor"}}
+  }.dump();
+}
+
+//==============================================================================
+/// Keeps track of when each request was sent and when its robot received it
+class Latencies
+{
+public:
+
+  explicit Latencies(const std::size_t requests)
+  : _sent(requests),
+    _latency(requests)
+  {
+    // Do nothing
+  }
+
+  void sent(const std::size_t i)
+  {
+    _sent[i] = Clock::now();
+  }
+
+  void received(const std::size_t i)
+  {
+    _latency[i] = Clock::now() - _sent[i];
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (++_received == _latency.size())
+      _cv.notify_all();
+  }
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cv.wait(lock, [&]() { return _received == _latency.size(); });
+  }
+
+  void print(const std::string& name, const Clock::duration total)
+  {
+    std::sort(_latency.begin(), _latency.end());
+    const auto us = [](Clock::duration d)
+      {
+        return std::chrono::duration<double, std::micro>(d).count();
+      };
+
+    std::cout << "  " << name << ": " << _latency.size() << " requests in "
+              << us(total) / 1000.0 << "ms, latency p50 "
+              << us(_latency[_latency.size()/2]) << "us, p99 "
+              << us(_latency[_latency.size()*99/100]) << "us, max "
+              << us(_latency.back()) << "us" << std::endl;
+  }
+
+private:
+  std::vector<Clock::time_point> _sent;
+  std::vector<Clock::duration> _latency;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::size_t _received = 0;
+};
+
+//==============================================================================
+/// Every robot parses every request on the shared worker, the way each
+/// TaskManager used to subscribe to the requests by itself.
+void run_broadcast(const std::size_t robots)
+{
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  std::vector<std::unordered_set<std::string>> tasks(robots);
+  for (std::size_t r = 0; r < robots; ++r)
+  {
+    for (std::size_t t = 0; t < TasksPerRobot; ++t)
+      tasks[r].insert(task_id(r, t));
+  }
+
+  Latencies latencies(NumRequests);
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < NumRequests; ++i)
+  {
+    const auto msg = std::make_shared<const std::string>(
+      cancel_request(task_id(i % robots, i % TasksPerRobot)));
+    latencies.sent(i);
+    for (std::size_t r = 0; r < robots; ++r)
+    {
+      worker.schedule(
+        [&, r, i, msg](const auto&)
+        {
+          const auto request = nlohmann::json::parse(*msg);
+          if (request["type"] != "cancel_task_request")
+            return;
+
+          if (tasks[r].count(request["task_id"].get<std::string>()))
+            latencies.received(i);
+        });
+    }
+  }
+
+  latencies.wait();
+  latencies.print("broadcast", Clock::now() - start);
+}
+
+//==============================================================================
+/// The request is parsed once and only handed to the robot that has the task
+void run_routed(const std::size_t robots)
+{
+  const auto worker = rxcpp::schedulers::make_event_loop().create_worker();
+  const auto router = TaskApiRouter::make();
+
+  Latencies latencies(NumRequests);
+  std::vector<TaskApiRouter::RecipientPtr> recipients;
+  for (std::size_t r = 0; r < robots; ++r)
+  {
+    recipients.push_back(
+      router->add_recipient(
+        "fleet", "robot_" + std::to_string(r), worker,
+        [&](const nlohmann::json&, const std::string& request_id)
+        {
+          latencies.received(std::stoul(request_id));
+        }));
+
+    for (std::size_t t = 0; t < TasksPerRobot; ++t)
+      recipients.back()->claim(task_id(r, t));
+  }
+
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < NumRequests; ++i)
+  {
+    const auto msg = cancel_request(task_id(i % robots, i % TasksPerRobot));
+    latencies.sent(i);
+    router->route(msg, std::to_string(i));
+  }
+
+  latencies.wait();
+  latencies.print("routed   ", Clock::now() - start);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::vector<std::size_t> sizes = {1, 10, 40, 80, 160};
+  if (argc > 1)
+  {
+    sizes.clear();
+    for (int i = 1; i < argc; ++i)
+      sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+  }
+
+  for (const auto n : sizes)
+  {
+    std::cout << n << " robots:" << std::endl;
+    run_broadcast(n);
+    run_routed(n);
+  }
+
+  return 0;
+}
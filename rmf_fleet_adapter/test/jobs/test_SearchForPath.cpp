@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <jobs/SearchForPath.hpp>
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+#include "../thread_cooldown.hpp"
+
+//==============================================================================
+SCENARIO("Search for a path without a time limit")
+{
+  using namespace std::chrono_literals;
+  rmf_fleet_adapter_test::thread_cooldown = true;
+  auto database = std::make_shared<rmf_traffic::schedule::Database>();
+
+  const rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(1.0)
+  };
+
+  const auto make_description = [&](const std::string& name)
+    {
+      return rmf_traffic::schedule::ParticipantDescription{
+        name,
+        "test_SearchForPath",
+        rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+        profile
+      };
+    };
+
+  auto p0 = rmf_traffic::schedule::make_participant(
+    make_description("participant 0"), database);
+  auto p1 = rmf_traffic::schedule::make_participant(
+    make_description("participant 1"), database);
+
+  // A grid that is large enough for both searches to check their interrupter
+  // many times before they finish
+  const std::string test_map_name = "test_map";
+  const std::size_t N = 12;
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    for (std::size_t j = 0; j < N; ++j)
+      graph.add_waypoint(test_map_name, {5.0*i, 5.0*j});
+  }
+
+  const auto index = [&](const std::size_t i, const std::size_t j)
+    {
+      return i*N + j;
+    };
+
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    for (std::size_t j = 0; j < N; ++j)
+    {
+      if (i+1 < N)
+      {
+        graph.add_lane(index(i, j), index(i+1, j));
+        graph.add_lane(index(i+1, j), index(i, j));
+      }
+
+      if (j+1 < N)
+      {
+        graph.add_lane(index(i, j), index(i, j+1));
+        graph.add_lane(index(i, j+1), index(i, j));
+      }
+    }
+  }
+
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.7, 0.3},
+    {1.0, 0.45},
+    profile
+  };
+
+  const auto planner = std::make_shared<rmf_traffic::agv::Planner>(
+    rmf_traffic::agv::Planner::Configuration{graph, traits},
+    rmf_traffic::agv::Planner::Options{nullptr});
+
+  // Park the other participant in the middle of the grid so that the
+  // compliant search has to work its way around it.
+  const auto now = std::chrono::steady_clock::now();
+  const Eigen::Vector2d middle = graph.get_waypoint(
+    index(N/2, N/2)).get_location();
+  rmf_traffic::Trajectory parked;
+  parked.insert(now, {middle[0], middle[1], 0.0}, Eigen::Vector3d::Zero());
+  parked.insert(
+    now + 10min, {middle[0], middle[1], 0.0}, Eigen::Vector3d::Zero());
+  p1.set(p1.assign_plan_id(), {rmf_traffic::Route(test_map_name, parked)});
+
+  const auto search = std::make_shared<rmf_fleet_adapter::jobs::SearchForPath>(
+    planner,
+    rmf_traffic::agv::Plan::StartSet({{now, index(0, 0), 0.0}}),
+    rmf_traffic::agv::Plan::Goal(index(N-1, N-1)),
+    database->snapshot(), p0.id(),
+    std::make_shared<rmf_traffic::Profile>(profile),
+    std::nullopt);
+
+  using Result = rmf_fleet_adapter::jobs::SearchForPath::Result;
+  std::promise<Result> result_promise;
+  auto result_future = result_promise.get_future();
+  auto sub = rmf_rxcpp::make_job<Result>(search)
+    .observe_on(rxcpp::observe_on_event_loop())
+    .subscribe(
+    [&result_promise](const Result& result)
+    {
+      result_promise.set_value(result);
+    });
+
+  const auto status = result_future.wait_for(1min);
+  REQUIRE(std::future_status::ready == status);
+
+  const auto result = result_future.get();
+  REQUIRE(result.greedy_job);
+  CHECK(result.greedy_job->progress().success());
+  CHECK(result.type == rmf_fleet_adapter::jobs::SearchForPath::Type::compliant);
+  REQUIRE(result.compliant_job);
+  CHECK(result.compliant_job->progress().success());
+}
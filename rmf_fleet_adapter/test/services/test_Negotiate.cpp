@@ -2607,3 +2607,91 @@ SCENARIO("fan-in-fan-out bottleneck", "[.high_cpu]")
   }
 }
 
+
+//==============================================================================
+SCENARIO("Plans are reused between negotiation tables")
+{
+  using namespace std::chrono_literals;
+
+  auto database = std::make_shared<rmf_traffic::schedule::Database>();
+  auto p0 = rmf_traffic::schedule::make_participant(a0_description, database);
+  auto p1 = rmf_traffic::schedule::make_participant(a1_description, database);
+
+  // A single corridor where the two participants drive towards each other
+  const std::string test_map_name = "test_map";
+  rmf_traffic::agv::Graph graph;
+  for (std::size_t i = 0; i < 5; ++i)
+    graph.add_waypoint(test_map_name, {5.0*i, 0.0});
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    graph.add_lane(i, i+1);
+    graph.add_lane(i+1, i);
+  }
+
+  const auto planner = std::make_shared<rmf_traffic::agv::Planner>(
+    rmf_traffic::agv::Planner::Configuration{graph, a0_traits},
+    rmf_traffic::agv::Planner::Options{nullptr, 1s});
+
+  using Start = rmf_traffic::agv::Plan::Start;
+  using Goal = rmf_traffic::agv::Plan::Goal;
+  const auto now = std::chrono::steady_clock::now();
+  const rmf_traffic::agv::Plan::StartSet starts_0 = {Start(now, 0, 0.0)};
+  const std::vector<Goal> goals_0 = {Goal(4)};
+  const auto plan_0 = planner->plan(starts_0, goals_0.front());
+  REQUIRE(plan_0);
+
+  const auto plan_1 = planner->plan(Start(now, 4, 0.0), Goal(0));
+  REQUIRE(plan_1);
+
+  const auto negotiation = rmf_traffic::schedule::Negotiation::make_shared(
+    database->snapshot(), {p0.id(), p1.id()});
+
+  const auto validators_for = [](const auto& table)
+    {
+      return rmf_traffic::agv::NegotiatingRouteValidator::Generator(
+        table->viewer()).all();
+    };
+
+  rmf_fleet_adapter::services::NegotiationCache cache;
+  const auto root_0 = negotiation->table(p0.id(), {});
+  CHECK_FALSE(cache.find(starts_0, goals_0, validators_for(root_0)));
+
+  cache.store(starts_0, goals_0, *plan_0);
+  const auto reused = cache.find(starts_0, goals_0, validators_for(root_0));
+  REQUIRE(reused);
+  CHECK(reused->get_cost() == Approx(plan_0->get_cost()));
+
+  // The plan is only for these starts and goals
+  CHECK_FALSE(
+    cache.find({Start(now + 10s, 0, 0.0)}, goals_0, validators_for(root_0)));
+  CHECK_FALSE(cache.find(starts_0, {Goal(3)}, validators_for(root_0)));
+
+  // Nothing cheaper than the plan is known
+  CHECK_FALSE(
+    cache.find(
+      starts_0, goals_0, validators_for(root_0), plan_0->get_cost() - 1.0));
+
+  // Storing another plan for the same starts and goals replaces the old one
+  const rmf_traffic::agv::Planner slow_planner(
+    rmf_traffic::agv::Planner::Configuration{
+      graph,
+      rmf_traffic::agv::VehicleTraits{{0.35, 0.3}, {1.0, 0.45}, a0_profile}},
+    rmf_traffic::agv::Planner::Options{nullptr, 1s});
+  const auto slow_plan_0 = slow_planner.plan(starts_0, goals_0.front());
+  REQUIRE(slow_plan_0);
+  REQUIRE(plan_0->get_cost() < slow_plan_0->get_cost());
+
+  cache.store(starts_0, goals_0, *slow_plan_0);
+  const auto replaced = cache.find(starts_0, goals_0, validators_for(root_0));
+  REQUIRE(replaced);
+  CHECK(replaced->get_cost() == Approx(slow_plan_0->get_cost()));
+
+  // The plan is not used where it would conflict with the submission of the
+  // other participant
+  rmf_traffic::schedule::SimpleResponder(negotiation->table(p1.id(), {}))
+  .submit(0, plan_1->get_itinerary());
+  const auto child_0 = negotiation->table(p0.id(), {p1.id()});
+  REQUIRE(child_0);
+  CHECK_FALSE(cache.find(starts_0, goals_0, validators_for(child_0)));
+}
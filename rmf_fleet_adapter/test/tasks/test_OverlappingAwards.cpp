@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "../mock/MockRobotCommand.hpp"
+#include <rmf_websocket/BroadcastServer.hpp>
+
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include <rmf_fleet_adapter/agv/test/MockAdapter.hpp>
+
+#include <rmf_traffic_ros2/Time.hpp>
+
+#include <rmf_battery/agv/BatterySystem.hpp>
+#include <rmf_battery/agv/SimpleMotionPowerSink.hpp>
+#include <rmf_battery/agv/SimpleDevicePowerSink.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+#include "../thread_cooldown.hpp"
+
+#include <mutex>
+#include <set>
+
+//==============================================================================
+// Every task is dispatched right away, so the bids of the later tasks are all
+// planned before the earlier tasks are awarded, and some awards arrive while
+// the reallocation of an earlier award is still underway. None of the awards
+// may push another awarded task out of the queue.
+SCENARIO("Tasks that are awarded while other awards are underway")
+{
+  rmf_fleet_adapter_test::thread_cooldown = true;
+  using namespace std::chrono_literals;
+
+  const std::string test_map_name = "test_map";
+  rmf_traffic::agv::Graph graph;
+  graph.add_waypoint(test_map_name, {0.0, 0.0}).set_charger(true); // 0
+  graph.add_waypoint(test_map_name, {5.0, 0.0}); // 1
+  graph.add_waypoint(test_map_name, {10.0, 0.0}); // 2
+  graph.add_lane(0, 1);
+  graph.add_lane(1, 0);
+  graph.add_lane(1, 2);
+  graph.add_lane(2, 1);
+
+  const std::string home = "home";
+  REQUIRE(graph.add_key(home, 0));
+  const std::string away = "away";
+  REQUIRE(graph.add_key(away, 2));
+
+  const rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(1.0)
+  };
+
+  const rmf_traffic::agv::VehicleTraits traits{
+    {0.7, 0.3},
+    {1.0, 0.45},
+    profile
+  };
+
+  auto rcl_context = std::make_shared<rclcpp::Context>();
+  rcl_context->init(0, nullptr);
+  rmf_fleet_adapter::agv::test::MockAdapter adapter(
+    "test_OverlappingAwards", rclcpp::NodeOptions().context(rcl_context));
+
+  const std::vector<std::string> task_ids =
+  {"patrol_0", "patrol_1", "patrol_2", "patrol_3"};
+
+  std::mutex completed_mutex;
+  std::set<std::string> completed;
+  std::promise<void> all_completed_promise;
+  auto all_completed_future = all_completed_promise.get_future();
+
+  using WebsocketServer = rmf_websocket::BroadcastServer;
+  const auto ws_server = WebsocketServer::make(
+    47878,
+    [&](const nlohmann::json& data)
+    {
+      if (data.at("status") != "completed")
+        return;
+
+      std::lock_guard<std::mutex> lock(completed_mutex);
+      const auto id = data.at("booking").at("id").get<std::string>();
+      const bool inserted = completed.insert(id).second;
+      if (inserted && completed.size() == task_ids.size())
+        all_completed_promise.set_value();
+    },
+    WebsocketServer::ApiMsgType::TaskStateUpdate);
+
+  const auto fleet = adapter.add_fleet(
+    "test_fleet", traits, graph, "ws://localhost:47878");
+
+  using BatterySystem = rmf_battery::agv::BatterySystem;
+  using PowerSystem = rmf_battery::agv::PowerSystem;
+  using MechanicalSystem = rmf_battery::agv::MechanicalSystem;
+  using SimpleMotionPowerSink = rmf_battery::agv::SimpleMotionPowerSink;
+  using SimpleDevicePowerSink = rmf_battery::agv::SimpleDevicePowerSink;
+
+  auto battery_system = std::make_shared<BatterySystem>(
+    *BatterySystem::make(24.0, 40.0, 8.8));
+  auto mechanical_system = MechanicalSystem::make(70.0, 40.0, 0.22);
+  auto motion_sink = std::make_shared<SimpleMotionPowerSink>(
+    *battery_system, *mechanical_system);
+  auto ambient_power_system = PowerSystem::make(20.0);
+  auto ambient_sink = std::make_shared<SimpleDevicePowerSink>(
+    *battery_system, *ambient_power_system);
+  auto tool_power_system = PowerSystem::make(10.0);
+  auto tool_sink = std::make_shared<SimpleDevicePowerSink>(
+    *battery_system, *tool_power_system);
+
+  fleet->set_task_planner_params(
+    battery_system, motion_sink, ambient_sink, tool_sink, 0.2, 1.0, false);
+
+  fleet->consider_patrol_requests(
+    [](
+      const nlohmann::json&,
+      rmf_fleet_adapter::agv::FleetUpdateHandle::Confirmation& confirm)
+    {
+      confirm.accept();
+    });
+
+  const auto now = rmf_traffic_ros2::convert(adapter.node()->now());
+  const rmf_traffic::agv::Plan::StartSet starts = {{now, 0, 0.0}};
+  auto robot_cmd = std::make_shared<
+    rmf_fleet_adapter_test::MockRobotCommand>(adapter.node(), graph);
+  fleet->add_robot(
+    robot_cmd, "T0", profile, starts,
+    [&robot_cmd](rmf_fleet_adapter::agv::RobotUpdateHandlePtr updater)
+    {
+      updater->update_battery_soc(1.0);
+      robot_cmd->updater = std::move(updater);
+    });
+
+  adapter.start();
+  ws_server->start();
+
+  // Wait for the task manager to start
+  std::this_thread::sleep_for(1s);
+
+  for (std::size_t i = 0; i < task_ids.size(); ++i)
+  {
+    nlohmann::json request;
+    request["category"] = "patrol";
+    auto& desc = request["description"];
+    desc["places"] = i % 2 == 0 ?
+      std::vector<std::string>{away, home} :
+      std::vector<std::string>{home, away};
+    desc["rounds"] = 1;
+    adapter.dispatch_task(task_ids[i], request);
+  }
+
+  const auto status = all_completed_future.wait_for(60s);
+  CHECK(status == std::future_status::ready);
+
+  {
+    std::lock_guard<std::mutex> lock(completed_mutex);
+    for (const auto& id : task_ids)
+    {
+      CAPTURE(id);
+      CHECK(completed.count(id) == 1);
+    }
+  }
+
+  adapter.stop();
+  ws_server->stop();
+}
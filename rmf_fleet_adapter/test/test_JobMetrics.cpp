@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <JobMetrics.hpp>
+
+#include <rmf_rxcpp/RxJobs.hpp>
+
+#include <rmf_utils/catch.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+//==============================================================================
+struct CategorizedAction
+{
+  static constexpr const char* job_category = "test_categorized";
+
+  template<typename Subscriber>
+  void operator()(const Subscriber& s)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    s.on_next(0);
+    s.on_completed();
+  }
+};
+} // anonymous namespace
+
+//==============================================================================
+SCENARIO("Job metrics")
+{
+  auto& metrics = rmf_fleet_adapter::get_job_metrics();
+  metrics.take();
+
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    auto action = std::make_shared<CategorizedAction>();
+    rmf_rxcpp::make_job<int>(action).as_blocking().subscribe();
+  }
+
+  // The execution time of a job is recorded after the job returns, which can
+  // be just after its subscriber hears that it completed.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  auto& alive_category = metrics.category("test_alive");
+  std::optional<rmf_fleet_adapter::JobMetrics::Alive> alive;
+  alive.emplace(alive_category);
+
+  const auto summaries = metrics.take();
+  const auto it = std::find_if(summaries.begin(), summaries.end(),
+      [](const auto& s) { return s.name == "test_categorized"; });
+  REQUIRE(it != summaries.end());
+  CHECK(it->queue_delay.count == 3);
+  CHECK(it->execution_time.count == 3);
+  CHECK(it->execution_time.min >= 1000000);
+  CHECK_FALSE(it->alive.has_value());
+
+  const auto alive_it = std::find_if(summaries.begin(), summaries.end(),
+      [](const auto& s) { return s.name == "test_alive"; });
+  REQUIRE(alive_it != summaries.end());
+  REQUIRE(alive_it->alive.has_value());
+  CHECK(*alive_it->alive == 1);
+
+  alive.reset();
+  CHECK(alive_category.alive == 0);
+
+  // The histograms start over after each call to take()
+  for (const auto& s : metrics.take())
+    CHECK(s.execution_time.count == 0);
+}
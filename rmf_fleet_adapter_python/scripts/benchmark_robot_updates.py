@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+
+# Measures how many robot state updates per second a Python fleet adapter can
+# push through the bindings, comparing one call per robot against the batched
+# update_positions() call. A background Python thread keeps busy the whole time
+# so that contention over the GIL shows up in the numbers.
+
+import argparse
+import threading
+import time
+from functools import partial
+
+import rmf_adapter as adpt
+import rmf_adapter.vehicletraits as traits
+import rmf_adapter.geometry as geometry
+import rmf_adapter.graph as graph
+import rmf_adapter.plan as plan
+
+map_name = "test_map"
+fleet_name = "benchmark_fleet"
+
+
+class IdleRobotCommand(adpt.RobotCommandHandle):
+    def __init__(self):
+        adpt.RobotCommandHandle.__init__(self)
+        self.updater = None
+
+    def follow_new_path(self, waypoints, next_arrival_estimator,
+                        path_finished_callback):
+        pass
+
+    def stop(self):
+        pass
+
+    def dock(self, dock_name, docking_finished_callback):
+        pass
+
+
+def make_graph(width):
+    nav_graph = graph.Graph()
+    for x in range(width):
+        for y in range(width):
+            nav_graph.add_waypoint(map_name, [2.0*x, 2.0*y])
+
+    for x in range(width):
+        for y in range(width):
+            index = x*width + y
+            if x + 1 < width:
+                nav_graph.add_bidir_lane(index, index + width)
+            if y + 1 < width:
+                nav_graph.add_bidir_lane(index, index + 1)
+
+    return nav_graph
+
+
+def robot_position(nav_graph, robot, tick):
+    wp = nav_graph.get_waypoint((robot + tick) % nav_graph.num_waypoints)
+    return [wp.location[0], wp.location[1], 0.0]
+
+
+def run_individual(robots, nav_graph, ticks):
+    start = time.perf_counter()
+    for tick in range(ticks):
+        for i, robot in enumerate(robots):
+            robot.updater.update_lost_position(
+                map_name, robot_position(nav_graph, i, tick))
+            robot.updater.update_battery_soc(1.0)
+    return time.perf_counter() - start
+
+
+def run_batched(robots, nav_graph, ticks):
+    start = time.perf_counter()
+    for tick in range(ticks):
+        adpt.update_positions([
+            adpt.robot_update_handle.RobotStateUpdate(
+                robot.updater,
+                map_name,
+                robot_position(nav_graph, i, tick),
+                battery_soc=1.0)
+            for i, robot in enumerate(robots)
+        ])
+    return time.perf_counter() - start
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-n', '--robots', type=int, default=50)
+    parser.add_argument('-t', '--ticks', type=int, default=100)
+    args = parser.parse_args()
+
+    try:
+        adpt.init_rclcpp()
+    except RuntimeError:
+        # Continue if it is already initialized
+        pass
+
+    nav_graph = make_graph(10)
+    profile = traits.Profile(geometry.make_final_convex_circle(0.3))
+    robot_traits = traits.VehicleTraits(linear=traits.Limits(0.7, 0.3),
+                                        angular=traits.Limits(1.0, 0.45),
+                                        profile=profile)
+
+    adapter = adpt.MockAdapter("BenchmarkRobotUpdates")
+    fleet = adapter.add_fleet(fleet_name, robot_traits, nav_graph)
+
+    def updater_inserter(cmd, updater):
+        cmd.updater = updater
+
+    robots = []
+    for i in range(args.robots):
+        cmd = IdleRobotCommand()
+        starts = [plan.Start(adapter.now(), i % nav_graph.num_waypoints, 0.0)]
+        fleet.add_robot(cmd, f"robot_{i}", profile, starts,
+                        partial(updater_inserter, cmd))
+        robots.append(cmd)
+
+    adapter.start()
+
+    deadline = time.time() + 10.0
+    while any(r.updater is None for r in robots):
+        if time.time() > deadline:
+            raise RuntimeError("Timed out waiting for robots to be added")
+        time.sleep(0.1)
+
+    def keep_busy(stop):
+        # Stands in for the rest of a Python fleet adapter, e.g. polling the
+        # robots' own APIs
+        while not stop.is_set():
+            sum(range(1000))
+
+    stop = threading.Event()
+    busy = threading.Thread(target=keep_busy, args=(stop,), daemon=True)
+    busy.start()
+
+    num_updates = args.robots * args.ticks
+    for name, run in [('individual', run_individual),
+                      ('batched', run_batched)]:
+        elapsed = run(robots, nav_graph, args.ticks)
+        print(f'{name:>10}: {num_updates} updates in {elapsed:.3f}s '
+              f'({num_updates/elapsed:.0f} updates/s)')
+
+    stop.set()
+    busy.join()
+    adapter.stop()
+
+
+if __name__ == "__main__":
+    main()
@@ -5,6 +5,8 @@
 #include <pybind11/stl.h>
 #include "pybind11_json/pybind11_json.hpp"
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "rmf_traffic_ros2/Time.hpp"
 #include "rmf_fleet_adapter/agv/Adapter.hpp"
@@ -41,6 +43,58 @@ using RobotInterruption = agv::RobotUpdateHandle::Interruption;
 using IssueTicket = agv::RobotUpdateHandle::IssueTicket;
 using Stubbornness = agv::RobotUpdateHandle::Unstable::Stubbornness;
 
+//==============================================================================
+/// The latest state of one robot, used to update many robots in one call.
+/// If lanes are given, the robot is placed on those lanes. Otherwise if a
+/// target waypoint is given, the robot is merging onto that waypoint.
+/// Otherwise the robot is merged onto the navigation graph of map_name.
+struct RobotStateUpdate
+{
+  RobotStateUpdate(
+    std::shared_ptr<agv::RobotUpdateHandle> handle_,
+    std::string map_name_,
+    Eigen::Vector3d position_,
+    std::optional<double> battery_soc_,
+    std::vector<std::size_t> lanes_,
+    std::optional<std::size_t> target_waypoint_)
+  : handle(std::move(handle_)),
+    map_name(std::move(map_name_)),
+    position(std::move(position_)),
+    battery_soc(battery_soc_),
+    lanes(std::move(lanes_)),
+    target_waypoint(target_waypoint_)
+  {
+    // Do nothing
+  }
+
+  std::shared_ptr<agv::RobotUpdateHandle> handle;
+  std::string map_name;
+  Eigen::Vector3d position;
+  std::optional<double> battery_soc;
+  std::vector<std::size_t> lanes;
+  std::optional<std::size_t> target_waypoint;
+};
+
+//==============================================================================
+void apply_robot_state_updates(const std::vector<RobotStateUpdate>& updates)
+{
+  for (const auto& update : updates)
+  {
+    if (!update.handle)
+      continue;
+
+    if (!update.lanes.empty())
+      update.handle->update_position(update.position, update.lanes);
+    else if (update.target_waypoint.has_value())
+      update.handle->update_position(update.position, *update.target_waypoint);
+    else
+      update.handle->update_position(update.map_name, update.position);
+
+    if (update.battery_soc.has_value())
+      update.handle->update_battery_soc(*update.battery_soc);
+  }
+}
+
 void bind_types(py::module&);
 void bind_graph(py::module&);
 void bind_shapes(py::module&);
@@ -77,25 +131,30 @@ PYBIND11_MODULE(rmf_adapter, m) {
     std::shared_ptr<agv::RobotUpdateHandle>>(
     m, "RobotUpdateHandle")
   // Private constructor: Only to be constructed via FleetUpdateHandle!
-  .def("interrupted", &agv::RobotUpdateHandle::replan)
-  .def("replan", &agv::RobotUpdateHandle::replan)
+  .def("interrupted", &agv::RobotUpdateHandle::replan,
+    py::call_guard<py::gil_scoped_release>())
+  .def("replan", &agv::RobotUpdateHandle::replan,
+    py::call_guard<py::gil_scoped_release>())
   .def("update_current_waypoint",
     py::overload_cast<std::size_t, double>(
       &agv::RobotUpdateHandle::update_position),
     py::arg("waypoint"),
-    py::arg("orientation"))
+    py::arg("orientation"),
+    py::call_guard<py::gil_scoped_release>())
   .def("update_current_lanes",
     py::overload_cast<const Eigen::Vector3d&,
     const std::vector<std::size_t>&>(
       &agv::RobotUpdateHandle::update_position),
     py::arg("position"),
-    py::arg("lanes"))
+    py::arg("lanes"),
+    py::call_guard<py::gil_scoped_release>())
   .def("update_off_grid_position",
     py::overload_cast<const Eigen::Vector3d&,
     std::size_t>(
       &agv::RobotUpdateHandle::update_position),
     py::arg("position"),
-    py::arg("target_waypoint"))
+    py::arg("target_waypoint"),
+    py::call_guard<py::gil_scoped_release>())
   .def("update_lost_position",
     py::overload_cast<const std::string&,
     const Eigen::Vector3d&,
@@ -107,17 +166,21 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("position"),
     py::arg("max_merge_waypoint_distance") = 0.1,
     py::arg("max_merge_lane_distance") = 1.0,
-    py::arg("min_lane_length") = 1e-8)
+    py::arg("min_lane_length") = 1e-8,
+    py::call_guard<py::gil_scoped_release>())
   .def("update_position",
     py::overload_cast<rmf_traffic::agv::Plan::StartSet>(
       &agv::RobotUpdateHandle::update_position),
-    py::arg("start_set"))
+    py::arg("start_set"),
+    py::call_guard<py::gil_scoped_release>())
   .def("set_charger_waypoint", &agv::RobotUpdateHandle::set_charger_waypoint,
     py::arg("charger_wp"))
   .def("update_battery_soc", &agv::RobotUpdateHandle::update_battery_soc,
-    py::arg("battery_soc"))
+    py::arg("battery_soc"),
+    py::call_guard<py::gil_scoped_release>())
   .def("override_status", &agv::RobotUpdateHandle::override_status,
-    py::arg("new_status"))
+    py::arg("new_status"),
+    py::call_guard<py::gil_scoped_release>())
   .def_property("maximum_delay",
     py::overload_cast<>(
       &agv::RobotUpdateHandle::maximum_delay, py::const_),
@@ -254,6 +317,35 @@ PYBIND11_MODULE(rmf_adapter, m) {
   // ACTION EXECUTOR   =======================================================
   auto m_robot_update_handle = m.def_submodule("robot_update_handle");
 
+  // BATCHED ROBOT UPDATES ===================================================
+  py::class_<RobotStateUpdate>(
+    m_robot_update_handle, "RobotStateUpdate")
+  .def(py::init<std::shared_ptr<agv::RobotUpdateHandle>,
+    std::string,
+    Eigen::Vector3d,
+    std::optional<double>,
+    std::vector<std::size_t>,
+    std::optional<std::size_t>>(),
+    py::arg("handle"),
+    py::arg("map_name"),
+    py::arg("position"),
+    py::arg("battery_soc") = std::nullopt,
+    py::arg("lanes") = std::vector<std::size_t>(),
+    py::arg("target_waypoint") = std::nullopt)
+  .def_readwrite("handle", &RobotStateUpdate::handle)
+  .def_readwrite("map_name", &RobotStateUpdate::map_name)
+  .def_readwrite("position", &RobotStateUpdate::position)
+  .def_readwrite("battery_soc", &RobotStateUpdate::battery_soc)
+  .def_readwrite("lanes", &RobotStateUpdate::lanes)
+  .def_readwrite("target_waypoint", &RobotStateUpdate::target_waypoint);
+
+  m.def("update_positions",
+    &apply_robot_state_updates,
+    py::arg("updates"),
+    py::call_guard<py::gil_scoped_release>(),
+    "Apply the latest states of many robots in one call. The GIL is released\
+     while the updates are applied.");
+
   py::class_<ActionExecution>(
     m_robot_update_handle, "ActionExecution")
   .def("update_remaining_time",
@@ -318,10 +410,19 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("handle_cb"))
   .def("close_lanes",
     &agv::FleetUpdateHandle::close_lanes,
-    py::arg("lane_indices"))
+    py::arg("lane_indices"),
+    py::call_guard<py::gil_scoped_release>())
   .def("open_lanes",
     &agv::FleetUpdateHandle::open_lanes,
-    py::arg("lane_indices"))
+    py::arg("lane_indices"),
+    py::call_guard<py::gil_scoped_release>())
+  .def("warm_planner_caches",
+    &agv::FleetUpdateHandle::warm_planner_caches,
+    py::arg("goals") = std::vector<std::size_t>(),
+    py::arg("cache_file") = std::nullopt,
+    py::call_guard<py::gil_scoped_release>(),
+    "Warm up the traffic planner caches in the background, optionally\
+     saving the set of warmed goals to cache_file for future restarts")
   .def("set_task_planner_params",
     [&](agv::FleetUpdateHandle& self,
     battery::BatterySystem& b_sys,
@@ -598,14 +699,19 @@ PYBIND11_MODULE(rmf_adapter, m) {
 
   // Python rclcpp init and spin call
   m.def("init_rclcpp", []() { rclcpp::init(0, nullptr); });
+  //
+  // The GIL is released while spinning so that Python threads can keep
+  // running. Any callback into Python will reacquire the GIL for itself.
   m.def("spin_rclcpp", [](rclcpp::Node::SharedPtr node_pt)
     {
       rclcpp::spin(node_pt);
-    });
+    },
+    py::call_guard<py::gil_scoped_release>());
   m.def("spin_some_rclcpp", [](rclcpp::Node::SharedPtr node_pt)
     {
       rclcpp::spin_some(node_pt);
-    });
+    },
+    py::call_guard<py::gil_scoped_release>());
 
   py::class_<agv::Adapter, std::shared_ptr<agv::Adapter>>(m, "Adapter")
   // .def(py::init<>())  // Private constructor
@@ -613,7 +719,8 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("node_name"),
     py::arg("node_options") = rclcpp::NodeOptions(),
     py::arg("wait_time") = rmf_utils::optional<rmf_traffic::Duration>(
-      rmf_utils::nullopt))
+      rmf_utils::nullopt),
+    py::call_guard<py::gil_scoped_release>())
   .def("add_fleet", &agv::Adapter::add_fleet,
     py::arg("fleet_name"),
     py::arg("traits"),
@@ -629,8 +736,10 @@ PYBIND11_MODULE(rmf_adapter, m) {
     py::arg("blocker_callback") = nullptr)
   .def_property_readonly("node",
     py::overload_cast<>(&agv::Adapter::node))
-  .def("start", &agv::Adapter::start)
-  .def("stop", &agv::Adapter::stop)
+  .def("start", &agv::Adapter::start,
+    py::call_guard<py::gil_scoped_release>())
+  .def("stop", &agv::Adapter::stop,
+    py::call_guard<py::gil_scoped_release>())
   .def("now", [](agv::Adapter& self)
     {
       return TimePoint(rmf_traffic_ros2::convert(self.node()->now())
@@ -656,8 +765,10 @@ PYBIND11_MODULE(rmf_adapter, m) {
     &agv::test::MockAdapter::dispatch_task,
     py::arg("task_id"),
     py::arg("request"))
-  .def("start", &agv::test::MockAdapter::start)
-  .def("stop", &agv::test::MockAdapter::stop)
+  .def("start", &agv::test::MockAdapter::start,
+    py::call_guard<py::gil_scoped_release>())
+  .def("stop", &agv::test::MockAdapter::stop,
+    py::call_guard<py::gil_scoped_release>())
   .def("now", [&](agv::test::MockAdapter& self)
     {
       return TimePoint(rmf_traffic_ros2::convert(self.node()->now())
@@ -115,7 +115,8 @@ void bind_plan(py::module& m)
     py::arg("start_time"),
     py::arg("max_merge_waypoint_distance") = 0.1,
     py::arg("max_merge_lane_distance") = 1.0,
-    py::arg("min_lane_length") = 1e-8);
+    py::arg("min_lane_length") = 1e-8,
+    py::call_guard<py::gil_scoped_release>());
 
   // PLAN ======================================================================
   py::class_<Plan>(m_plan, "Plan")
@@ -184,10 +185,14 @@ void bind_plan(py::module& m)
     Goal goal)
     {
       std::vector<Plan::Waypoint> waypoints;
-      const auto result = self.plan(start, goal);
-      if (result.success())
       {
-        waypoints = result->get_waypoints();
+        // Planning can take a long time, so let other Python threads run
+        py::gil_scoped_release release;
+        const auto result = self.plan(start, goal);
+        if (result.success())
+        {
+          waypoints = result->get_waypoints();
+        }
       }
 
       return waypoints;
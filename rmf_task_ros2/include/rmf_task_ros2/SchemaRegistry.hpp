@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_TASK_ROS2__SCHEMAREGISTRY_HPP
+#define RMF_TASK_ROS2__SCHEMAREGISTRY_HPP
+
+#include <rmf_utils/impl_ptr.hpp>
+
+#include <nlohmann/json.hpp>
+#include <nlohmann/json-schema.hpp>
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace rmf_task_ros2 {
+
+//==============================================================================
+/// A collection of JSON schemas and of the validators that have been compiled
+/// from them.
+///
+/// Compiling a validator parses its schema and resolves every $ref in it, so
+/// each validator is compiled once, the first time it is asked for, and then
+/// shared by everyone who asks for the same schema. All member functions are
+/// safe to call from any thread.
+class SchemaRegistry
+{
+public:
+
+  using Validator = nlohmann::json_schema::json_validator;
+  using ConstValidatorPtr = std::shared_ptr<const Validator>;
+  using Loader =
+    std::function<void(const nlohmann::json_uri& id, nlohmann::json& value)>;
+
+  /// The registry that is shared by every module in this process. It starts
+  /// out with every rmf_api_msgs schema used by the task and fleet APIs.
+  static const std::shared_ptr<SchemaRegistry>& global();
+
+  /// Make a registry that does not have any schemas yet.
+  static std::shared_ptr<SchemaRegistry> make();
+
+  /// Add a schema that other schemas can refer to with $ref. A schema with the
+  /// same $id as an earlier one replaces it for any validators compiled after
+  /// this, but validators that were already compiled are not affected.
+  ///
+  /// \throws std::runtime_error if the schema does not have an $id.
+  void add_schema(const nlohmann::json& schema);
+
+  /// Get the validator for a schema, compiling it if nobody has asked for it
+  /// yet. The schema is also added to the registry if its $id is new.
+  ///
+  /// \throws std::runtime_error if the schema does not have an $id, or
+  /// std::exception if it refers to a schema that is not in the registry.
+  ConstValidatorPtr validator(const nlohmann::json& schema);
+
+  /// Get the validator for the schema with this $id, or nullptr if the
+  /// registry does not have a schema with this $id.
+  ConstValidatorPtr validator(const std::string& id);
+
+  /// A loader that resolves $ref with the schemas of this registry. It stays
+  /// valid even if the registry is destroyed.
+  Loader loader() const;
+
+  /// The number of validators that have been compiled so far.
+  std::size_t compiled() const;
+
+  class Implementation;
+private:
+  SchemaRegistry();
+  rmf_utils::unique_impl_ptr<Implementation> _pimpl;
+};
+
+//==============================================================================
+/// Find the "type" field of a JSON API message by streaming through the
+/// message instead of parsing it into a json object. Streaming stops as soon
+/// as the field is found, so nothing after it gets looked at.
+///
+/// Receivers of the task API topics can use this to drop the messages that are
+/// not meant for them before paying for a full parse and validation.
+///
+/// \return the value of the field, or std::nullopt if the message is not a
+/// JSON object, does not have a string "type" at its top level, or is
+/// malformed before the field.
+std::optional<std::string> peek_message_type(const std::string& json_msg);
+
+} // namespace rmf_task_ros2
+
+#endif // RMF_TASK_ROS2__SCHEMAREGISTRY_HPP
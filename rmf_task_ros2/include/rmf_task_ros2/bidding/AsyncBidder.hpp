@@ -18,6 +18,7 @@
 #ifndef RMF_TASK_ROS2__BIDDING__ASYNCBIDDER_HPP
 #define RMF_TASK_ROS2__BIDDING__ASYNCBIDDER_HPP
 
+#include <optional>
 #include <unordered_set>
 
 #include <rclcpp/node.hpp>
@@ -40,8 +41,12 @@ public:
   /// \param[in] notice
   ///   bid notice msg
   ///
-  /// \return submission
-  ///   Estimates of a task. This submission is used by dispatcher for eval
+  /// \param[in] respond
+  ///   Call this with the estimates of the task to submit them to the
+  ///   dispatcher for eval. It does not need to be called before the callback
+  ///   returns, and it can be called from any thread, so the estimates can be
+  ///   computed in the background. The notice counts towards the concurrency
+  ///   limit until this is called or destroyed.
   using ReceiveNotice =
     std::function<void(const BidNoticeMsg& notice, Respond respond)>;
 
@@ -62,6 +67,19 @@ public:
     const std::shared_ptr<rclcpp::Node>& node,
     ReceiveNotice notice_cb);
 
+  /// Set how many bid notices the callback may be working on at once. Notices
+  /// that arrive while the limit is reached wait for their turn, and they are
+  /// dropped if their time window closes before it comes. A notice for a task
+  /// that is already waiting or being worked on is ignored. The default of
+  /// std::nullopt means there is no limit.
+  AsyncBidder& set_concurrency_limit(std::optional<std::size_t> limit);
+
+  /// Get the limit on how many bid notices can be worked on at once.
+  std::optional<std::size_t> concurrency_limit() const;
+
+  /// The number of bid notices that are waiting for their turn.
+  std::size_t waiting_notices() const;
+
   class Implementation;
 
 private:
@@ -16,6 +16,7 @@
 */
 
 #include <rmf_task_ros2/Dispatcher.hpp>
+#include <rmf_task_ros2/SchemaRegistry.hpp>
 #include <rmf_task_ros2/StandardNames.hpp>
 
 #include <rmf_websocket/BroadcastClient.hpp>
@@ -38,60 +39,13 @@
 #include <rmf_traffic_ros2/Time.hpp>
 
 #include <nlohmann/json.hpp>
-#include <nlohmann/json-schema.hpp>
 
 #include <rmf_api_msgs/schemas/dispatch_task_request.hpp>
-#include <rmf_api_msgs/schemas/dispatch_task_response.hpp>
-#include <rmf_api_msgs/schemas/task_request.hpp>
-#include <rmf_api_msgs/schemas/task_state.hpp>
-#include <rmf_api_msgs/schemas/error.hpp>
 
 #include <unordered_set>
 
 namespace rmf_task_ros2 {
 
-namespace {
-//==============================================================================
-std::function<void(const nlohmann::json_uri& id, nlohmann::json& value)>
-make_schema_loader()
-{
-  const std::vector<nlohmann::json> schemas = {
-    rmf_api_msgs::schemas::dispatch_task_request,
-    rmf_api_msgs::schemas::dispatch_task_response,
-    rmf_api_msgs::schemas::task_request,
-    rmf_api_msgs::schemas::task_state,
-    rmf_api_msgs::schemas::error
-  };
-
-  std::unordered_map<std::string, nlohmann::json> dictionary;
-  for (const auto& schema : schemas)
-  {
-    const auto json_uri = nlohmann::json_uri(schema["$id"]);
-    dictionary[json_uri.url()] = schema;
-  }
-
-  return [dictionary = std::move(dictionary)](
-    const nlohmann::json_uri& id, nlohmann::json& value)
-    {
-      const auto it = dictionary.find(id.url());
-      if (it != dictionary.end())
-        value = it->second;
-    };
-}
-
-//==============================================================================
-static const
-std::function<void(const nlohmann::json_uri& id, nlohmann::json& value)>
-schema_loader = make_schema_loader();
-
-//==============================================================================
-nlohmann::json_schema::json_validator make_validator(nlohmann::json schema)
-{
-  return nlohmann::json_schema::json_validator(
-    std::move(schema), schema_loader);
-}
-} // anonymous namespace
-
 //==============================================================================
 class Dispatcher::Implementation
 {
@@ -414,6 +368,12 @@ public:
       return;
     }
 
+    // Most of the requests on this topic are meant for the fleet adapters, so
+    // check the type before parsing the whole message.
+    const auto type = peek_message_type(msg.json_msg);
+    if (type.has_value() && *type != "dispatch_task_request")
+      return;
+
     nlohmann::json msg_json;
     try
     {
@@ -449,12 +409,12 @@ public:
         return;
       }
 
-      static const auto request_validator =
-        make_validator(rmf_api_msgs::schemas::dispatch_task_request);
+      static const auto request_validator = SchemaRegistry::global()
+        ->validator(rmf_api_msgs::schemas::dispatch_task_request);
 
       try
       {
-        request_validator.validate(msg_json);
+        request_validator->validate(msg_json);
       }
       catch (const std::exception& e)
       {
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_task_ros2/SchemaRegistry.hpp>
+
+#include <rmf_api_msgs/schemas/cancel_task_request.hpp>
+#include <rmf_api_msgs/schemas/cancel_task_response.hpp>
+#include <rmf_api_msgs/schemas/dispatch_task_request.hpp>
+#include <rmf_api_msgs/schemas/dispatch_task_response.hpp>
+#include <rmf_api_msgs/schemas/error.hpp>
+#include <rmf_api_msgs/schemas/fleet_log.hpp>
+#include <rmf_api_msgs/schemas/fleet_log_update.hpp>
+#include <rmf_api_msgs/schemas/fleet_state.hpp>
+#include <rmf_api_msgs/schemas/fleet_state_update.hpp>
+#include <rmf_api_msgs/schemas/interrupt_task_request.hpp>
+#include <rmf_api_msgs/schemas/interrupt_task_response.hpp>
+#include <rmf_api_msgs/schemas/kill_task_request.hpp>
+#include <rmf_api_msgs/schemas/kill_task_response.hpp>
+#include <rmf_api_msgs/schemas/location_2D.hpp>
+#include <rmf_api_msgs/schemas/log_entry.hpp>
+#include <rmf_api_msgs/schemas/resume_task_request.hpp>
+#include <rmf_api_msgs/schemas/resume_task_response.hpp>
+#include <rmf_api_msgs/schemas/rewind_task_request.hpp>
+#include <rmf_api_msgs/schemas/rewind_task_response.hpp>
+#include <rmf_api_msgs/schemas/robot_state.hpp>
+#include <rmf_api_msgs/schemas/robot_task_request.hpp>
+#include <rmf_api_msgs/schemas/robot_task_response.hpp>
+#include <rmf_api_msgs/schemas/simple_response.hpp>
+#include <rmf_api_msgs/schemas/skip_phase_request.hpp>
+#include <rmf_api_msgs/schemas/skip_phase_response.hpp>
+#include <rmf_api_msgs/schemas/task_log.hpp>
+#include <rmf_api_msgs/schemas/task_log_update.hpp>
+#include <rmf_api_msgs/schemas/task_request.hpp>
+#include <rmf_api_msgs/schemas/task_state.hpp>
+#include <rmf_api_msgs/schemas/task_state_update.hpp>
+#include <rmf_api_msgs/schemas/token_response.hpp>
+#include <rmf_api_msgs/schemas/undo_skip_phase_request.hpp>
+#include <rmf_api_msgs/schemas/undo_skip_phase_response.hpp>
+
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace rmf_task_ros2 {
+
+namespace {
+//==============================================================================
+std::string schema_url(const nlohmann::json& schema, const char* caller)
+{
+  const auto it = schema.find("$id");
+  if (it == schema.end() || !it->is_string())
+  {
+    throw std::runtime_error(
+      std::string("[rmf_task_ros2::SchemaRegistry::") + caller
+      + "] The schema does not have an $id");
+  }
+
+  return nlohmann::json_uri(it->get<std::string>()).url();
+}
+
+//==============================================================================
+/// The schemas are kept apart from the rest of the registry so that loaders
+/// can hold onto them after the registry is gone.
+struct Schemas
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, nlohmann::json> dictionary;
+};
+
+//==============================================================================
+/// Streams through a JSON message and stops at the value of the top-level
+/// "type" field.
+class TypePeeker : public nlohmann::json_sax<nlohmann::json>
+{
+public:
+
+  std::optional<std::string> type;
+
+  bool null() final { return value(); }
+  bool boolean(bool) final { return value(); }
+  bool number_integer(number_integer_t) final { return value(); }
+  bool number_unsigned(number_unsigned_t) final { return value(); }
+  bool number_float(number_float_t, const string_t&) final { return value(); }
+  bool binary(binary_t&) final { return value(); }
+
+  bool string(string_t& val) final
+  {
+    if (_depth == 1 && _at_type)
+    {
+      type = std::move(val);
+      return false;
+    }
+
+    return value();
+  }
+
+  bool start_object(std::size_t) final
+  {
+    if (_at_type)
+      return false;
+
+    ++_depth;
+    return true;
+  }
+
+  bool key(string_t& val) final
+  {
+    _at_type = _depth == 1 && val == "type";
+    return true;
+  }
+
+  bool end_object() final
+  {
+    --_depth;
+    return true;
+  }
+
+  bool start_array(std::size_t) final
+  {
+    if (_depth == 0 || _at_type)
+      return false;
+
+    ++_depth;
+    return true;
+  }
+
+  bool end_array() final
+  {
+    --_depth;
+    return true;
+  }
+
+  bool parse_error(
+    std::size_t,
+    const std::string&,
+    const nlohmann::json::exception&) final
+  {
+    return false;
+  }
+
+private:
+
+  // The message must be an object, and once we reach the type field there is
+  // nothing left to look for, whether or not its value is a string.
+  bool value() const
+  {
+    return _depth > 0 && !_at_type;
+  }
+
+  std::size_t _depth = 0;
+  bool _at_type = false;
+};
+} // anonymous namespace
+
+//==============================================================================
+class SchemaRegistry::Implementation
+{
+public:
+
+  std::shared_ptr<Schemas> schemas = std::make_shared<Schemas>();
+
+  mutable std::mutex validators_mutex;
+  std::unordered_map<std::string, ConstValidatorPtr> validators;
+
+  void add_schema(std::string url, const nlohmann::json& schema)
+  {
+    std::lock_guard<std::mutex> lock(schemas->mutex);
+    schemas->dictionary.insert_or_assign(std::move(url), schema);
+  }
+
+  Loader loader() const
+  {
+    return [schemas = schemas](
+      const nlohmann::json_uri& id, nlohmann::json& value)
+      {
+        std::lock_guard<std::mutex> lock(schemas->mutex);
+        const auto it = schemas->dictionary.find(id.url());
+        if (it != schemas->dictionary.end())
+          value = it->second;
+      };
+  }
+};
+
+//==============================================================================
+const std::shared_ptr<SchemaRegistry>& SchemaRegistry::global()
+{
+  static const std::shared_ptr<SchemaRegistry> registry = []()
+    {
+      auto registry = make();
+      const std::vector<nlohmann::json> schemas = {
+        rmf_api_msgs::schemas::cancel_task_request,
+        rmf_api_msgs::schemas::cancel_task_response,
+        rmf_api_msgs::schemas::dispatch_task_request,
+        rmf_api_msgs::schemas::dispatch_task_response,
+        rmf_api_msgs::schemas::error,
+        rmf_api_msgs::schemas::fleet_log,
+        rmf_api_msgs::schemas::fleet_log_update,
+        rmf_api_msgs::schemas::fleet_state,
+        rmf_api_msgs::schemas::fleet_state_update,
+        rmf_api_msgs::schemas::interrupt_task_request,
+        rmf_api_msgs::schemas::interrupt_task_response,
+        rmf_api_msgs::schemas::kill_task_request,
+        rmf_api_msgs::schemas::kill_task_response,
+        rmf_api_msgs::schemas::location_2D,
+        rmf_api_msgs::schemas::log_entry,
+        rmf_api_msgs::schemas::resume_task_request,
+        rmf_api_msgs::schemas::resume_task_response,
+        rmf_api_msgs::schemas::rewind_task_request,
+        rmf_api_msgs::schemas::rewind_task_response,
+        rmf_api_msgs::schemas::robot_state,
+        rmf_api_msgs::schemas::robot_task_request,
+        rmf_api_msgs::schemas::robot_task_response,
+        rmf_api_msgs::schemas::simple_response,
+        rmf_api_msgs::schemas::skip_phase_request,
+        rmf_api_msgs::schemas::skip_phase_response,
+        rmf_api_msgs::schemas::task_log,
+        rmf_api_msgs::schemas::task_log_update,
+        rmf_api_msgs::schemas::task_request,
+        rmf_api_msgs::schemas::task_state,
+        rmf_api_msgs::schemas::task_state_update,
+        rmf_api_msgs::schemas::token_response,
+        rmf_api_msgs::schemas::undo_skip_phase_request,
+        rmf_api_msgs::schemas::undo_skip_phase_response
+      };
+
+      for (const auto& schema : schemas)
+        registry->add_schema(schema);
+
+      return registry;
+    } ();
+
+  return registry;
+}
+
+//==============================================================================
+std::shared_ptr<SchemaRegistry> SchemaRegistry::make()
+{
+  auto registry = std::shared_ptr<SchemaRegistry>(new SchemaRegistry);
+  registry->_pimpl = rmf_utils::make_unique_impl<Implementation>();
+  return registry;
+}
+
+//==============================================================================
+void SchemaRegistry::add_schema(const nlohmann::json& schema)
+{
+  _pimpl->add_schema(schema_url(schema, "add_schema"), schema);
+}
+
+//==============================================================================
+auto SchemaRegistry::validator(const nlohmann::json& schema)
+-> ConstValidatorPtr
+{
+  auto url = schema_url(schema, "validator");
+  std::lock_guard<std::mutex> lock(_pimpl->validators_mutex);
+  const auto it = _pimpl->validators.find(url);
+  if (it != _pimpl->validators.end())
+    return it->second;
+
+  {
+    std::lock_guard<std::mutex> schemas_lock(_pimpl->schemas->mutex);
+    _pimpl->schemas->dictionary.try_emplace(url, schema);
+  }
+
+  // The loader locks the schemas while it resolves each $ref, so we must not
+  // hold onto that lock while compiling.
+  auto validator = std::make_shared<const Validator>(schema, _pimpl->loader());
+  _pimpl->validators.insert({std::move(url), validator});
+  return validator;
+}
+
+//==============================================================================
+auto SchemaRegistry::validator(const std::string& id) -> ConstValidatorPtr
+{
+  const auto url = nlohmann::json_uri(id).url();
+  nlohmann::json schema;
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->validators_mutex);
+    const auto it = _pimpl->validators.find(url);
+    if (it != _pimpl->validators.end())
+      return it->second;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->schemas->mutex);
+    const auto it = _pimpl->schemas->dictionary.find(url);
+    if (it == _pimpl->schemas->dictionary.end())
+      return nullptr;
+
+    schema = it->second;
+  }
+
+  return validator(schema);
+}
+
+//==============================================================================
+auto SchemaRegistry::loader() const -> Loader
+{
+  return _pimpl->loader();
+}
+
+//==============================================================================
+std::size_t SchemaRegistry::compiled() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->validators_mutex);
+  return _pimpl->validators.size();
+}
+
+//==============================================================================
+SchemaRegistry::SchemaRegistry()
+{
+  // Do nothing
+}
+
+//==============================================================================
+std::optional<std::string> peek_message_type(const std::string& json_msg)
+{
+  TypePeeker peeker;
+  nlohmann::json::sax_parse(json_msg, &peeker);
+  return std::move(peeker.type);
+}
+
+} // namespace rmf_task_ros2
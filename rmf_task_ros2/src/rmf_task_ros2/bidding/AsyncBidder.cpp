@@ -22,6 +22,10 @@
 #include <rmf_task_msgs/msg/bid_proposal.hpp>
 #include <rmf_task_ros2/StandardNames.hpp>
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+
 namespace rmf_task_ros2 {
 namespace bidding {
 
@@ -30,39 +34,111 @@ class AsyncBidder::Implementation
 {
 public:
 
-  std::weak_ptr<rclcpp::Node> w_node;
-  ReceiveNotice receive_notice;
+  using Clock = std::chrono::steady_clock;
 
   using BidNoticeSub = rclcpp::Subscription<BidNoticeMsg>;
-  BidNoticeSub::SharedPtr bid_notice_sub;
-
   using BidResponsePub = rclcpp::Publisher<BidResponseMsg>;
-  BidResponsePub::SharedPtr bid_response_pub;
+
+  struct Notice
+  {
+    BidNoticeMsg msg;
+    Clock::time_point deadline;
+  };
+
+  /// The notices that are waiting or being worked on. This is shared with the
+  /// respond callbacks, which may be called after the bidder is gone.
+  struct Queue
+  {
+    std::weak_ptr<rclcpp::Node> w_node;
+    ReceiveNotice receive_notice;
+    BidResponsePub::SharedPtr bid_response_pub;
+
+    std::mutex mutex;
+    std::optional<std::size_t> limit;
+    std::deque<Notice> waiting;
+    std::size_t active = 0;
+
+    // The tasks of every notice that is waiting or active
+    std::unordered_set<std::string> task_ids;
+  };
+
+  /// Holds a spot under the concurrency limit until the notice gets a response
+  /// or the respond callback is destroyed.
+  class Ticket
+  {
+  public:
+
+    Ticket(std::weak_ptr<Queue> queue, std::string task_id)
+    : _queue(std::move(queue)),
+      _task_id(std::move(task_id))
+    {
+      // Do nothing
+    }
+
+    void release()
+    {
+      if (_released.exchange(true))
+        return;
+
+      const auto queue = _queue.lock();
+      if (!queue)
+        return;
+
+      {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        --queue->active;
+        queue->task_ids.erase(_task_id);
+      }
+
+      dispatch(queue);
+    }
+
+    ~Ticket()
+    {
+      release();
+    }
+
+  private:
+    std::weak_ptr<Queue> _queue;
+    std::string _task_id;
+    std::atomic_bool _released = false;
+  };
+
+  std::shared_ptr<Queue> queue;
+  BidNoticeSub::SharedPtr bid_notice_sub;
 
   Implementation(
     std::shared_ptr<rclcpp::Node> node_,
     ReceiveNotice receive_notice)
-  : w_node{std::move(node_)},
-    receive_notice{std::move(receive_notice)}
+  : queue(std::make_shared<Queue>())
   {
     const auto bid_qos = rclcpp::ServicesQoS().reliable();
-    const auto node = w_node.lock();
+    queue->w_node = node_;
+    queue->receive_notice = std::move(receive_notice);
+    queue->bid_response_pub = node_->create_publisher<BidResponseMsg>(
+      rmf_task_ros2::BidResponseTopicName, bid_qos);
 
-    bid_notice_sub = node->create_subscription<BidNoticeMsg>(
+    bid_notice_sub = node_->create_subscription<BidNoticeMsg>(
       rmf_task_ros2::BidNoticeTopicName, bid_qos,
-      [&](const BidNoticeMsg::UniquePtr msg)
+      [q = queue](const BidNoticeMsg::UniquePtr msg)
       {
-        this->handle_notice(*msg);
+        handle_notice(q, *msg);
       });
+  }
 
-    bid_response_pub = node->create_publisher<BidResponseMsg>(
-      rmf_task_ros2::BidResponseTopicName, bid_qos);
+  ~Implementation()
+  {
+    // Responses that come in after this should not hand out any more notices
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->waiting.clear();
   }
 
   // Callback fn when a dispatch notice is received
-  void handle_notice(const BidNoticeMsg& msg)
+  static void handle_notice(
+    const std::shared_ptr<Queue>& queue,
+    const BidNoticeMsg& msg)
   {
-    const auto node = w_node.lock();
+    const auto node = queue->w_node.lock();
     if (!node)
       return;
 
@@ -71,17 +147,90 @@ public:
       msg.task_id.c_str());
 
     // check if the user did not supply a receive notice callback
-    if (!receive_notice)
+    if (!queue->receive_notice)
       return;
 
-    // Send the notice
-    receive_notice(
-      msg,
-      [task_id = msg.task_id, pub = bid_response_pub](
-        const Response& response)
+    // A window that is not positive would close before anyone could bid, so
+    // treat it as having no deadline instead.
+    const auto window = rmf_traffic_ros2::convert(
+      rclcpp::Duration(msg.time_window));
+    const auto deadline = window > rmf_traffic::Duration(0) ?
+      Clock::now() + window : Clock::time_point::max();
+
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      if (!queue->task_ids.insert(msg.task_id).second)
       {
-        pub->publish(convert(response, task_id));
-      });
+        RCLCPP_DEBUG(node->get_logger(),
+          "[Bidder] Ignoring a repeated bid notice for task_id [%s]",
+          msg.task_id.c_str());
+        return;
+      }
+
+      queue->waiting.push_back({msg, deadline});
+    }
+
+    dispatch(queue);
+  }
+
+  /// Hand out as many waiting notices as the concurrency limit allows, and
+  /// drop the ones whose time window has closed while they waited.
+  static void dispatch(const std::shared_ptr<Queue>& queue)
+  {
+    std::vector<BidNoticeMsg> ready;
+    std::vector<std::string> expired;
+    {
+      std::lock_guard<std::mutex> lock(queue->mutex);
+      const auto now = Clock::now();
+      auto& waiting = queue->waiting;
+      for (auto it = waiting.begin(); it != waiting.end(); )
+      {
+        if (now < it->deadline)
+        {
+          ++it;
+          continue;
+        }
+
+        queue->task_ids.erase(it->msg.task_id);
+        expired.push_back(std::move(it->msg.task_id));
+        it = waiting.erase(it);
+      }
+
+      while (!waiting.empty()
+        && (!queue->limit.has_value() || queue->active < *queue->limit))
+      {
+        ++queue->active;
+        ready.push_back(std::move(waiting.front().msg));
+        waiting.pop_front();
+      }
+    }
+
+    if (!expired.empty())
+    {
+      if (const auto node = queue->w_node.lock())
+      {
+        for (const auto& task_id : expired)
+        {
+          RCLCPP_WARN(node->get_logger(),
+            "[Bidder] Dropping the bid notice for task_id [%s] because its "
+            "bidding window closed while it was waiting to be evaluated",
+            task_id.c_str());
+        }
+      }
+    }
+
+    for (const auto& msg : ready)
+    {
+      auto ticket = std::make_shared<Ticket>(queue, msg.task_id);
+      queue->receive_notice(
+        msg,
+        [task_id = msg.task_id, pub = queue->bid_response_pub, ticket](
+          const Response& response)
+        {
+          pub->publish(convert(response, task_id));
+          ticket->release();
+        });
+    }
   }
 };
 
@@ -97,6 +246,34 @@ std::shared_ptr<AsyncBidder> AsyncBidder::make(
   return bidder;
 }
 
+//==============================================================================
+AsyncBidder& AsyncBidder::set_concurrency_limit(
+  std::optional<std::size_t> limit)
+{
+  {
+    std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+    _pimpl->queue->limit = limit;
+  }
+
+  // A higher limit may let some waiting notices through right away
+  Implementation::dispatch(_pimpl->queue);
+  return *this;
+}
+
+//==============================================================================
+std::optional<std::size_t> AsyncBidder::concurrency_limit() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+  return _pimpl->queue->limit;
+}
+
+//==============================================================================
+std::size_t AsyncBidder::waiting_notices() const
+{
+  std::lock_guard<std::mutex> lock(_pimpl->queue->mutex);
+  return _pimpl->queue->waiting.size();
+}
+
 //==============================================================================
 AsyncBidder::AsyncBidder()
 {
@@ -17,6 +17,7 @@
 
 #include <rmf_task_ros2/bidding/AsyncBidder.hpp>
 #include <rmf_task_ros2/bidding/Auctioneer.hpp>
+#include <rmf_task_ros2/StandardNames.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rmf_traffic_ros2/Time.hpp>
 
@@ -171,6 +172,44 @@ SCENARIO("Auction with 2 Bids", "[TwoBids]")
     REQUIRE(r_result_id == "bid2");
   }
 
+  WHEN("A bidder can only evaluate one notice at a time")
+  {
+    std::vector<std::string> received;
+    std::vector<AsyncBidder::Respond> pending;
+    auto bidder3 = AsyncBidder::make(
+      node,
+      [&received, &pending](const auto& notice, auto respond)
+      {
+        // Hold onto the response so it can be sent later
+        received.push_back(notice.task_id);
+        pending.push_back(std::move(respond));
+      });
+    bidder3->set_concurrency_limit(1);
+    CHECK(bidder3->concurrency_limit() == 1);
+
+    // Publish the notices directly, since the auctioneer only sends out one
+    // notice at a time
+    const auto notice_pub = node->create_publisher<BidNoticeMsg>(
+      BidNoticeTopicName, rclcpp::ServicesQoS().reliable());
+    notice_pub->publish(bidding_task1);
+    notice_pub->publish(bidding_task2);
+    notice_pub->publish(bidding_task1);
+
+    executor.spin_until_future_complete(ready_future,
+      rmf_traffic::time::from_seconds(0.5));
+
+    // The repeated notice for the first task is ignored
+    REQUIRE(received.size() == 1);
+    CHECK(received.front() == "bid1");
+    CHECK(bidder3->waiting_notices() == 1);
+
+    const auto respond = pending.front();
+    respond(Response{std::nullopt, {"Busy"}});
+    REQUIRE(received.size() == 2);
+    CHECK(received.back() == "bid2");
+    CHECK(bidder3->waiting_notices() == 0);
+  }
+
   rclcpp::shutdown(rcl_context);
 }
 
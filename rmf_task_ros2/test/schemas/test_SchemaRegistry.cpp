@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_task_ros2/SchemaRegistry.hpp>
+#include <rmf_api_msgs/schemas/cancel_task_request.hpp>
+#include <rmf_utils/catch.hpp>
+
+namespace rmf_task_ros2 {
+
+//==============================================================================
+SCENARIO("Validators are compiled once and shared")
+{
+  const auto& registry = SchemaRegistry::global();
+  const auto validator =
+    registry->validator(rmf_api_msgs::schemas::cancel_task_request);
+  REQUIRE(validator);
+  CHECK(validator == registry->validator(
+      rmf_api_msgs::schemas::cancel_task_request));
+  CHECK(validator == registry->validator(
+      rmf_api_msgs::schemas::cancel_task_request["$id"].get<std::string>()));
+  CHECK_FALSE(registry->validator(std::string("https://example.com/none")));
+
+  CHECK_NOTHROW(validator->validate(
+      {{"type", "cancel_task_request"}, {"task_id", "task_0"}}));
+  CHECK_THROWS(validator->validate({{"type", "cancel_task_request"}}));
+
+  GIVEN("A schema that refers to another")
+  {
+    const auto local = SchemaRegistry::make();
+    const nlohmann::json count = {
+      {"$id", "https://example.com/count.json"},
+      {"type", "integer"}
+    };
+    const nlohmann::json msg = {
+      {"$id", "https://example.com/msg.json"},
+      {"type", "object"},
+      {"properties", {{"count", {{"$ref", "count.json"}}}}}
+    };
+
+    CHECK_THROWS(local->validator(msg));
+    CHECK(local->compiled() == 0);
+    CHECK_THROWS(local->add_schema({{"type", "integer"}}));
+
+    local->add_schema(count);
+    const auto msg_validator = local->validator(msg);
+    CHECK(local->compiled() == 1);
+    CHECK_NOTHROW(msg_validator->validate({{"count", 3}}));
+    CHECK_THROWS(msg_validator->validate({{"count", "three"}}));
+  }
+}
+
+//==============================================================================
+SCENARIO("Peek at the type of a message")
+{
+  CHECK(peek_message_type(
+      R"({"type": "cancel_task_request", "task_id": "t"})")
+    == "cancel_task_request");
+
+  // Only the top level type counts
+  CHECK(peek_message_type(
+      R"({"request": {"type": "no"}, "x": [{"type": "no"}], "type": "yes"})")
+    == "yes");
+
+  // Nothing after the type gets looked at
+  CHECK(peek_message_type(R"({"type": "yes", "task_id": )") == "yes");
+
+  CHECK_FALSE(peek_message_type(R"({"type": 5})").has_value());
+  CHECK_FALSE(peek_message_type(R"({"type": {"name": "no"}})").has_value());
+  CHECK_FALSE(peek_message_type(R"({"task_id": "t"})").has_value());
+  CHECK_FALSE(peek_message_type(R"(["type", "no"])").has_value());
+  CHECK_FALSE(peek_message_type(R"("type")").has_value());
+  CHECK_FALSE(peek_message_type(R"({"task_id": )").has_value());
+  CHECK_FALSE(peek_message_type("").has_value());
+}
+
+} // namespace rmf_task_ros2
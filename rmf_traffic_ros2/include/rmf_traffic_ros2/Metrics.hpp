@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_TRAFFIC_ROS2__METRICS_HPP
+#define RMF_TRAFFIC_ROS2__METRICS_HPP
+
+#include <statistics_msgs/msg/metrics_message.hpp>
+
+#include <builtin_interfaces/msg/time.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace rmf_traffic_ros2 {
+
+//==============================================================================
+/// A histogram that any thread can record into without locking. Values are
+/// sorted into power-of-two buckets, so percentiles are accurate to within a
+/// factor of two. Recording a value only touches a few atomics, so histograms
+/// can stay on in production.
+class Histogram
+{
+public:
+
+  static constexpr std::size_t NumBuckets = 65;
+
+  /// A summary of the values that a Histogram received in one window
+  struct Summary
+  {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::array<uint64_t, NumBuckets> buckets = {};
+
+    double mean() const;
+
+    /// The upper bound of the bucket that contains the given percentile,
+    /// where 0 < p <= 1.
+    uint64_t percentile(double p) const;
+  };
+
+  //============================================================================
+  /// Records how many nanoseconds pass between its construction and
+  /// destruction.
+  class Timer
+  {
+  public:
+    explicit Timer(Histogram& histogram);
+    ~Timer();
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+  private:
+    Histogram& _histogram;
+    std::chrono::steady_clock::time_point _start;
+  };
+
+  void record(uint64_t value);
+
+  /// Record a duration in nanoseconds. Negative durations count as zero.
+  void record(std::chrono::nanoseconds duration);
+
+  /// Get a summary of every value recorded since the last call and start
+  /// over. Values that are recorded while this runs may be split across two
+  /// windows, which is fine for statistics.
+  Summary take();
+
+private:
+  std::atomic<uint64_t> _count{0};
+  std::atomic<uint64_t> _sum{0};
+  std::atomic<uint64_t> _min{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> _max{0};
+  std::array<std::atomic<uint64_t>, NumBuckets> _buckets{};
+};
+
+//==============================================================================
+/// Describe one window of a histogram with the average, minimum, maximum, and
+/// sample count statistics.
+statistics_msgs::msg::MetricsMessage make_metrics_message(
+  const std::string& source,
+  const std::string& name,
+  const std::string& unit,
+  const builtin_interfaces::msg::Time& window_start,
+  const builtin_interfaces::msg::Time& window_stop,
+  const Histogram::Summary& summary);
+
+} // namespace rmf_traffic_ros2
+
+#endif // RMF_TRAFFIC_ROS2__METRICS_HPP
@@ -27,6 +27,7 @@ const std::string Prefix = "rmf_traffic/";
 const std::string HeartbeatTopicName = Prefix + "heartbeat";
 const std::string ScheduleStartupTopicName = Prefix + "schedule_startup";
 const std::string QueriesInfoTopicName = Prefix + "registered_queries";
+const std::string ScheduleStatisticsTopicName = Prefix + "schedule_statistics";
 
 const std::string ItinerarySetTopicName = Prefix + "itinerary_set";
 const std::string ItineraryExtendTopicName = Prefix + "itinerary_extend";
@@ -60,6 +61,8 @@ const std::string NegotiationConclusionTopicName = Prefix +
   "negotiation_conclusion";
 const std::string NegotiationStatesTopicName = Prefix +
   "negotiation_states";
+const std::string NegotiationStateUpdatesTopicName = Prefix +
+  "negotiation_state_updates";
 const std::string NegotiationStatusesTopicName = Prefix +
   "negotiation_statuses";
 
@@ -67,6 +70,8 @@ const std::string BlockadeCancelTopicName = Prefix +
   "blockade_cancel";
 const std::string BlockadeHeartbeatTopicName = Prefix +
   "blockade_heartbeat";
+const std::string BlockadeHeartbeatDeltaTopicName = Prefix +
+  "blockade_heartbeat_delta";
 const std::string BlockadeReachedTopicName = Prefix +
   "blockade_reached";
 const std::string BlockadeReadyTopicName = Prefix +
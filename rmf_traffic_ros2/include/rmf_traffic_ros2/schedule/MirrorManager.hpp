@@ -64,14 +64,53 @@ public:
     /// Toggle the choice to wakeup on an update.
     Options& update_on_wakeup(bool choice);
 
+    /// Patches that add at least this many routes will have their conversion
+    /// divided across multiple threads. A value of zero means patches are
+    /// always converted on a single thread. The default is 500.
+    std::size_t parallel_conversion_threshold() const;
+
+    /// Set the parallel conversion threshold.
+    Options& parallel_conversion_threshold(std::size_t routes);
+
     class Implementation;
   private:
     rmf_utils::impl_ptr<Implementation> _pimpl;
   };
 
+  /// Statistics about the patches that this mirror has received
+  struct PatchMetrics
+  {
+    /// How many patches have been applied
+    std::size_t patches = 0;
+
+    /// How many patches could not be applied to the mirror
+    std::size_t failed_patches = 0;
+
+    /// How many patches were converted in parallel
+    std::size_t parallel_conversions = 0;
+
+    /// The number of routes that were added across all patches
+    std::size_t total_routes = 0;
+
+    /// The largest number of routes added by a single patch
+    std::size_t max_routes = 0;
+
+    /// Time spent converting patch messages
+    rmf_traffic::Duration total_conversion_time = rmf_traffic::Duration(0);
+    rmf_traffic::Duration max_conversion_time = rmf_traffic::Duration(0);
+
+    /// Time spent applying converted patches to the mirror, i.e. the time
+    /// that the update mutex was held
+    rmf_traffic::Duration total_apply_time = rmf_traffic::Duration(0);
+    rmf_traffic::Duration max_apply_time = rmf_traffic::Duration(0);
+  };
+
   /// Get an immutable view of the mirror
   std::shared_ptr<const rmf_traffic::schedule::Mirror> view() const;
 
+  /// Get statistics about the patches that have been applied to the mirror.
+  PatchMetrics patch_metrics() const;
+
   /// Attempt to update this mirror immediately.
   ///
   // TODO(MXG): Consider allowing this function to accept a callback that will
@@ -40,6 +40,19 @@ rmf_traffic_msgs::msg::SchedulePatch convert(
 rmf_traffic::schedule::Patch convert(
   const rmf_traffic_msgs::msg::SchedulePatch& from);
 
+//==============================================================================
+/// Convert a patch message, dividing its participants between up to
+/// max_threads threads. This is worthwhile for large patches, like remedial
+/// updates that carry the entire schedule. When max_threads is less than two,
+/// this is the same as the single-threaded conversion.
+rmf_traffic::schedule::Patch convert(
+  const rmf_traffic_msgs::msg::SchedulePatch& from,
+  std::size_t max_threads);
+
+//==============================================================================
+/// Count the number of routes that are being added by a patch message.
+std::size_t count_routes(const rmf_traffic_msgs::msg::SchedulePatch& msg);
+
 } // nmaespace rmf_traffic_ros2
 
 #endif // RMF_TRAFFIC_ROS2__SCHEDULE__PATCH_HPP
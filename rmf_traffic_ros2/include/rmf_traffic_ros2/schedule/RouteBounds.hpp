@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef RMF_TRAFFIC_ROS2__SCHEDULE__ROUTEBOUNDS_HPP
+#define RMF_TRAFFIC_ROS2__SCHEDULE__ROUTEBOUNDS_HPP
+
+#include <rmf_traffic/Profile.hpp>
+#include <rmf_traffic/Route.hpp>
+
+#include <Eigen/Geometry>
+
+#include <string>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// A conservative summary of where and when a route might be: the map of the
+/// route, a box that contains every position its trajectory passes through,
+/// grown by the size of the profile that follows it, and the time span of the
+/// trajectory.
+///
+/// Two routes whose bounds do not overlap cannot be in conflict, so checking
+/// the bounds of each pair of routes first lets conflict detection skip
+/// rmf_traffic::DetectConflict::between for most pairs. Compute the bounds of
+/// a route once and reuse them for every pair that the route is part of.
+///
+/// This is a plain value type instead of using an implementation pointer so
+/// that vectors of bounds can be built without any extra allocations.
+class RouteBounds
+{
+public:
+
+  /// Compute the bounds of a route.
+  ///
+  /// \param[in] profile
+  ///   The profile of the participant that follows the route. Both its
+  ///   footprint and its vicinity are accounted for.
+  ///
+  /// \param[in] route
+  ///   The route to bound. Trajectories with fewer than two waypoints cannot
+  ///   be bounded, so they are assumed to overlap with every route on the same
+  ///   map.
+  RouteBounds(
+    const rmf_traffic::Profile& profile,
+    const rmf_traffic::Route& route);
+
+  /// False if these routes are definitely not in conflict. True means a narrow
+  /// phase check, like rmf_traffic::DetectConflict::between, is needed.
+  bool might_conflict(const RouteBounds& other) const;
+
+  /// The map of the route.
+  const std::string& map() const;
+
+  /// True if the trajectory of the route could be bounded.
+  bool bounded() const;
+
+  /// The lower corner of the box. This is only meaningful when bounded().
+  const Eigen::Vector2d& min() const;
+
+  /// The upper corner of the box. This is only meaningful when bounded().
+  const Eigen::Vector2d& max() const;
+
+  /// When the trajectory starts. This is only meaningful when bounded().
+  rmf_traffic::Time start_time() const;
+
+  /// When the trajectory finishes. This is only meaningful when bounded().
+  rmf_traffic::Time finish_time() const;
+
+private:
+  std::string _map;
+  bool _bounded = false;
+  Eigen::Vector2d _min = Eigen::Vector2d::Zero();
+  Eigen::Vector2d _max = Eigen::Vector2d::Zero();
+  rmf_traffic::Time _start;
+  rmf_traffic::Time _finish;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // RMF_TRAFFIC_ROS2__SCHEDULE__ROUTEBOUNDS_HPP
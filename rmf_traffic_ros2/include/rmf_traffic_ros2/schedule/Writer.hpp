@@ -83,6 +83,23 @@ public:
     rmf_traffic::schedule::ParticipantDescription description,
     std::function<void(rmf_traffic::schedule::Participant)> ready_callback);
 
+  /// Asynchronously create several schedule participants.
+  ///
+  /// The registration requests for all of the participants are sent right
+  /// away instead of one after another, so the schedule node can process them
+  /// together.
+  ///
+  /// \param[in] descriptions
+  ///   The descriptions of the participants.
+  ///
+  /// \param[in] ready_callback
+  ///   The callback that will be triggered once every participant is ready.
+  ///   The participants will be in the same order as their descriptions.
+  void async_make_participants(
+    std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions,
+    std::function<void(std::vector<rmf_traffic::schedule::Participant>)>
+    ready_callback);
+
   class Implementation;
 private:
   Writer();
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic_ros2/Metrics.hpp>
+
+#include <statistics_msgs/msg/statistic_data_type.hpp>
+
+#include <algorithm>
+
+namespace rmf_traffic_ros2 {
+
+namespace {
+//==============================================================================
+std::size_t bucket_of(uint64_t value)
+{
+  std::size_t bucket = 0;
+  while (value > 0)
+  {
+    ++bucket;
+    value >>= 1;
+  }
+
+  return bucket;
+}
+
+//==============================================================================
+statistics_msgs::msg::StatisticDataPoint data_point(
+  const uint8_t type,
+  const double value)
+{
+  statistics_msgs::msg::StatisticDataPoint point;
+  point.data_type = type;
+  point.data = value;
+  return point;
+}
+} // anonymous namespace
+
+//==============================================================================
+double Histogram::Summary::mean() const
+{
+  if (count == 0)
+    return 0.0;
+
+  return static_cast<double>(sum) / static_cast<double>(count);
+}
+
+//==============================================================================
+uint64_t Histogram::Summary::percentile(const double p) const
+{
+  if (count == 0)
+    return 0;
+
+  const auto target = static_cast<uint64_t>(p * static_cast<double>(count));
+  uint64_t seen = 0;
+  for (std::size_t i = 0; i < NumBuckets; ++i)
+  {
+    seen += buckets[i];
+    if (seen >= target && seen > 0)
+    {
+      // Bucket i holds the values in [2^(i-1), 2^i)
+      const uint64_t upper = i == 0 ? 0 :
+        (i >= 64 ? std::numeric_limits<uint64_t>::max() : (1ull << i) - 1);
+      return std::min(upper, max);
+    }
+  }
+
+  return max;
+}
+
+//==============================================================================
+Histogram::Timer::Timer(Histogram& histogram)
+: _histogram(histogram),
+  _start(std::chrono::steady_clock::now())
+{
+  // Do nothing
+}
+
+//==============================================================================
+Histogram::Timer::~Timer()
+{
+  _histogram.record(std::chrono::steady_clock::now() - _start);
+}
+
+//==============================================================================
+void Histogram::record(const uint64_t value)
+{
+  _count.fetch_add(1, std::memory_order_relaxed);
+  _sum.fetch_add(value, std::memory_order_relaxed);
+  _buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+
+  uint64_t current = _min.load(std::memory_order_relaxed);
+  while (value < current &&
+    !_min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+    // Keep trying
+  }
+
+  current = _max.load(std::memory_order_relaxed);
+  while (current < value &&
+    !_max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+    // Keep trying
+  }
+}
+
+//==============================================================================
+void Histogram::record(const std::chrono::nanoseconds duration)
+{
+  record(static_cast<uint64_t>(std::max<int64_t>(0, duration.count())));
+}
+
+//==============================================================================
+auto Histogram::take() -> Summary
+{
+  Summary summary;
+  summary.count = _count.exchange(0, std::memory_order_relaxed);
+  summary.sum = _sum.exchange(0, std::memory_order_relaxed);
+  summary.min = _min.exchange(
+    std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  summary.max = _max.exchange(0, std::memory_order_relaxed);
+  for (std::size_t i = 0; i < NumBuckets; ++i)
+    summary.buckets[i] = _buckets[i].exchange(0, std::memory_order_relaxed);
+
+  if (summary.count == 0)
+    summary.min = 0;
+
+  return summary;
+}
+
+//==============================================================================
+statistics_msgs::msg::MetricsMessage make_metrics_message(
+  const std::string& source,
+  const std::string& name,
+  const std::string& unit,
+  const builtin_interfaces::msg::Time& window_start,
+  const builtin_interfaces::msg::Time& window_stop,
+  const Histogram::Summary& summary)
+{
+  using DataType = statistics_msgs::msg::StatisticDataType;
+  statistics_msgs::msg::MetricsMessage msg;
+  msg.measurement_source_name = source;
+  msg.metrics_source = name;
+  msg.unit = unit;
+  msg.window_start = window_start;
+  msg.window_stop = window_stop;
+  msg.statistics = {
+    data_point(DataType::STATISTICS_DATA_TYPE_AVERAGE, summary.mean()),
+    data_point(DataType::STATISTICS_DATA_TYPE_MINIMUM, summary.min),
+    data_point(DataType::STATISTICS_DATA_TYPE_MAXIMUM, summary.max),
+    data_point(DataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT, summary.count)
+  };
+  return msg;
+}
+
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "HeartbeatTracker.hpp"
+
+namespace rmf_traffic_ros2 {
+namespace blockade {
+
+namespace {
+//==============================================================================
+HeartbeatTracker::StatusMsg make_status(
+  const rmf_traffic::blockade::ParticipantId participant,
+  const rmf_traffic::blockade::Status& status,
+  const rmf_traffic::blockade::ReservedRange& range)
+{
+  return rmf_traffic_msgs::build<HeartbeatTracker::StatusMsg>()
+    .participant(participant)
+    .reservation(status.reservation)
+    .any_ready(status.last_ready.has_value())
+    .last_ready(status.last_ready.value_or(0))
+    .last_reached(status.last_reached)
+    .assignment_begin(range.begin)
+    .assignment_end(range.end);
+}
+} // anonymous namespace
+
+//==============================================================================
+auto HeartbeatTracker::full(const Moderator& moderator) -> HeartbeatMsg
+{
+  const auto& ranges = moderator.assignments().ranges();
+  const auto& statuses = moderator.statuses();
+
+  HeartbeatMsg msg;
+  msg.statuses.reserve(statuses.size());
+  _published.clear();
+  for (const auto& [participant, status] : statuses)
+  {
+    auto status_msg = make_status(participant, status, ranges.at(participant));
+    _published.insert({participant, status_msg});
+    msg.statuses.emplace_back(std::move(status_msg));
+  }
+
+  _gridlock = moderator.has_gridlock();
+  msg.has_gridlock = _gridlock;
+  _statuses_sent += msg.statuses.size();
+  return msg;
+}
+
+//==============================================================================
+auto HeartbeatTracker::delta(const Moderator& moderator)
+-> std::optional<Heartbeat>
+{
+  const auto& ranges = moderator.assignments().ranges();
+  const auto& statuses = moderator.statuses();
+
+  // Every participant that was published before must still be present,
+  // otherwise we need a full heartbeat to express the removal.
+  std::size_t still_present = 0;
+  for (const auto& [participant, _] : statuses)
+  {
+    if (_published.count(participant))
+      ++still_present;
+  }
+
+  if (still_present < _published.size())
+    return Heartbeat{full(moderator), true};
+
+  HeartbeatMsg msg;
+  for (const auto& [participant, status] : statuses)
+  {
+    auto status_msg = make_status(participant, status, ranges.at(participant));
+    const auto insertion = _published.insert({participant, status_msg});
+    if (!insertion.second)
+    {
+      if (insertion.first->second == status_msg)
+        continue;
+
+      insertion.first->second = status_msg;
+    }
+
+    msg.statuses.emplace_back(std::move(status_msg));
+  }
+
+  const bool gridlock = moderator.has_gridlock();
+  if (msg.statuses.empty() && gridlock == _gridlock)
+    return std::nullopt;
+
+  _gridlock = gridlock;
+  msg.has_gridlock = gridlock;
+  _statuses_sent += msg.statuses.size();
+  return Heartbeat{std::move(msg), false};
+}
+
+//==============================================================================
+std::size_t HeartbeatTracker::statuses_sent() const
+{
+  return _statuses_sent;
+}
+
+} // namespace blockade
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__BLOCKADE__HEARTBEATTRACKER_HPP
+#define SRC__RMF_TRAFFIC_ROS2__BLOCKADE__HEARTBEATTRACKER_HPP
+
+#include <rmf_traffic/blockade/Moderator.hpp>
+
+#include <rmf_traffic_msgs/msg/blockade_heartbeat.hpp>
+#include <rmf_traffic_msgs/msg/blockade_status.hpp>
+
+#include <optional>
+#include <unordered_map>
+
+namespace rmf_traffic_ros2 {
+namespace blockade {
+
+//==============================================================================
+/// Remembers the participant statuses that the blockade moderator last
+/// published so that heartbeats can carry only the participants whose status
+/// has changed.
+class HeartbeatTracker
+{
+public:
+
+  using HeartbeatMsg = rmf_traffic_msgs::msg::BlockadeHeartbeat;
+  using StatusMsg = rmf_traffic_msgs::msg::BlockadeStatus;
+  using Moderator = rmf_traffic::blockade::Moderator;
+
+  struct Heartbeat
+  {
+    HeartbeatMsg msg;
+
+    /// True if msg contains every participant. Otherwise it only contains the
+    /// participants whose status has changed since the last heartbeat.
+    bool full;
+  };
+
+  /// Make a heartbeat with the status of every participant.
+  HeartbeatMsg full(const Moderator& moderator);
+
+  /// Make a heartbeat with only the participants that changed since the last
+  /// heartbeat. If any participant has been removed since then, a full
+  /// heartbeat is made instead, because a partial heartbeat cannot express the
+  /// removal. If nothing has changed, nothing is returned.
+  std::optional<Heartbeat> delta(const Moderator& moderator);
+
+  /// The number of statuses that have been put into heartbeats so far.
+  std::size_t statuses_sent() const;
+
+private:
+  std::unordered_map<rmf_traffic::blockade::ParticipantId, StatusMsg>
+  _published;
+
+  bool _gridlock = false;
+  std::size_t _statuses_sent = 0;
+};
+
+} // namespace blockade
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__BLOCKADE__HEARTBEATTRACKER_HPP
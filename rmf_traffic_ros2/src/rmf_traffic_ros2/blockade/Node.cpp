@@ -18,6 +18,8 @@
 #include <rmf_traffic_ros2/blockade/Node.hpp>
 #include <rmf_traffic_ros2/StandardNames.hpp>
 
+#include "HeartbeatTracker.hpp"
+
 #include <rmf_traffic/blockade/Moderator.hpp>
 
 #include <rmf_traffic_msgs/msg/blockade_cancel.hpp>
@@ -28,6 +30,8 @@
 #include <rmf_traffic_msgs/msg/blockade_set.hpp>
 #include <rmf_traffic_msgs/msg/blockade_status.hpp>
 
+#include <functional>
+
 namespace rmf_traffic_ros2 {
 namespace blockade {
 
@@ -49,59 +53,126 @@ public:
       create_subscription<SetMsg>(
       BlockadeSetTopicName,
       rclcpp::SystemDefaultsQoS().best_effort(),
-      [=](const SetMsg::UniquePtr msg)
+      [=](SetMsg::UniquePtr msg)
       {
-        this->blockade_set(*msg);
+        this->queue_update(
+          [this, msg = std::shared_ptr<const SetMsg>(std::move(msg))]()
+          {
+            this->blockade_set(*msg);
+          });
       });
 
     blockade_ready_sub =
       create_subscription<ReadyMsg>(
       BlockadeReadyTopicName,
       rclcpp::SystemDefaultsQoS().best_effort(),
-      [=](const ReadyMsg::UniquePtr msg)
+      [=](ReadyMsg::UniquePtr msg)
       {
-        this->blockade_ready(*msg);
+        this->queue_update(
+          [this, msg = std::shared_ptr<const ReadyMsg>(std::move(msg))]()
+          {
+            this->blockade_ready(*msg);
+          });
       });
 
     blockade_reached_sub =
       create_subscription<ReachedMsg>(
       BlockadeReachedTopicName,
       rclcpp::SystemDefaultsQoS().best_effort(),
-      [=](const ReachedMsg::UniquePtr msg)
+      [=](ReachedMsg::UniquePtr msg)
       {
-        this->blockade_reached(*msg);
+        this->queue_update(
+          [this, msg = std::shared_ptr<const ReachedMsg>(std::move(msg))]()
+          {
+            this->blockade_reached(*msg);
+          });
       });
 
     blockade_release_sub =
       create_subscription<ReleaseMsg>(
       BlockadeReleaseTopicName,
       rclcpp::SystemDefaultsQoS().best_effort(),
-      [=](const ReleaseMsg::UniquePtr msg)
+      [=](ReleaseMsg::UniquePtr msg)
       {
-        this->blockade_release(*msg);
+        this->queue_update(
+          [this, msg = std::shared_ptr<const ReleaseMsg>(std::move(msg))]()
+          {
+            this->blockade_release(*msg);
+          });
       });
 
     blockade_cancel_sub =
       create_subscription<CancelMsg>(
       BlockadeCancelTopicName,
       rclcpp::SystemDefaultsQoS().best_effort(),
-      [=](const CancelMsg::UniquePtr msg)
+      [=](CancelMsg::UniquePtr msg)
       {
-        this->blockade_cancel(*msg);
+        this->queue_update(
+          [this, msg = std::shared_ptr<const CancelMsg>(std::move(msg))]()
+          {
+            this->blockade_cancel(*msg);
+          });
       });
 
     heartbeat_pub = create_publisher<HeartbeatMsg>(
       BlockadeHeartbeatTopicName,
       rclcpp::SystemDefaultsQoS().reliable());
 
+    heartbeat_delta_pub = create_publisher<HeartbeatMsg>(
+      BlockadeHeartbeatDeltaTopicName,
+      rclcpp::SystemDefaultsQoS().reliable());
+
+    // Period, in seconds, for publishing a heartbeat with the status of every
+    // participant
+    const double heartbeat_period =
+      declare_parameter<double>("heartbeat_period", 1.0);
+
+    // Incoming updates are gathered for this long, in seconds, before they are
+    // applied together and any resulting changes are published.
+    update_window = std::chrono::duration<double>(
+      declare_parameter<double>("update_window", 0.02));
+
     heartbeat_timer = create_wall_timer(
-      std::chrono::seconds(1),
+      std::chrono::duration<double>(heartbeat_period),
       [this]()
       {
         this->publish_status();
       });
   }
 
+  std::vector<std::function<void()>> pending_updates;
+  std::chrono::duration<double> update_window;
+
+  // This is only armed while there are pending updates
+  rclcpp::TimerBase::SharedPtr update_timer;
+
+  void queue_update(std::function<void()> update)
+  {
+    pending_updates.emplace_back(std::move(update));
+    if (update_timer)
+      return;
+
+    update_timer = create_wall_timer(
+      update_window,
+      [this]()
+      {
+        this->apply_updates();
+      });
+  }
+
+  void apply_updates()
+  {
+    update_timer->cancel();
+    update_timer.reset();
+
+    auto updates = std::move(pending_updates);
+    pending_updates.clear();
+    for (const auto& update : updates)
+      update();
+
+    check_for_updates();
+  }
+
   using SetMsg = rmf_traffic_msgs::msg::BlockadeSet;
   rclcpp::Subscription<SetMsg>::SharedPtr blockade_set_sub;
   void blockade_set(const SetMsg& set)
@@ -128,8 +199,6 @@ public:
       RCLCPP_ERROR(
         get_logger(), "Exception due to [set] update: %s", e.what());
     }
-
-    check_for_updates();
   }
 
   using ReadyMsg = rmf_traffic_msgs::msg::BlockadeReady;
@@ -145,8 +214,6 @@ public:
       RCLCPP_ERROR(
         get_logger(), "Exception due to [ready] update: %s", e.what());
     }
-
-    check_for_updates();
   }
 
   using ReleaseMsg = rmf_traffic_msgs::msg::BlockadeRelease;
@@ -163,8 +230,6 @@ public:
       RCLCPP_ERROR(
         get_logger(), "Exception due to [release] update: %s", e.what());
     }
-
-    check_for_updates();
   }
 
   using ReachedMsg = rmf_traffic_msgs::msg::BlockadeReached;
@@ -181,8 +246,6 @@ public:
       RCLCPP_ERROR(
         get_logger(), "Exception due to [reached] update: %s", e.what());
     }
-
-    check_for_updates();
   }
 
   using CancelMsg = rmf_traffic_msgs::msg::BlockadeCancel;
@@ -201,8 +264,6 @@ public:
       RCLCPP_ERROR(
         get_logger(), "Exception due to [cancel] update: %s", e.what());
     }
-
-    check_for_updates();
   }
 
   void check_for_updates()
@@ -212,39 +273,29 @@ public:
       return;
 
     last_assignment_version = current_version;
-    publish_status();
+    publish_changes();
   }
 
   using HeartbeatMsg = rmf_traffic_msgs::msg::BlockadeHeartbeat;
   rclcpp::Publisher<HeartbeatMsg>::SharedPtr heartbeat_pub;
-  using StatusMsg = rmf_traffic_msgs::msg::BlockadeStatus;
+  rclcpp::Publisher<HeartbeatMsg>::SharedPtr heartbeat_delta_pub;
+  HeartbeatTracker heartbeat_tracker;
+
   void publish_status()
   {
-    const auto& ranges = moderator->assignments().ranges();
-
-    std::vector<StatusMsg> statuses;
-    for (const auto& s : moderator->statuses())
-    {
-      const std::size_t participant = s.first;
-      const auto& range = ranges.at(participant);
-      const auto& status = s.second;
-
-      statuses.emplace_back(
-        rmf_traffic_msgs::build<StatusMsg>()
-        .participant(participant)
-        .reservation(status.reservation)
-        .any_ready(status.last_ready.has_value())
-        .last_ready(status.last_ready.value_or(0))
-        .last_reached(status.last_reached)
-        .assignment_begin(range.begin)
-        .assignment_end(range.end));
-    }
+    heartbeat_pub->publish(heartbeat_tracker.full(*moderator));
+  }
 
-    auto msg = rmf_traffic_msgs::build<HeartbeatMsg>()
-      .statuses(std::move(statuses))
-      .has_gridlock(moderator->has_gridlock());
+  void publish_changes()
+  {
+    auto heartbeat = heartbeat_tracker.delta(*moderator);
+    if (!heartbeat.has_value())
+      return;
 
-    heartbeat_pub->publish(msg);
+    if (heartbeat->full)
+      heartbeat_pub->publish(std::move(heartbeat->msg));
+    else
+      heartbeat_delta_pub->publish(std::move(heartbeat->msg));
   }
 
   std::shared_ptr<rmf_traffic::blockade::Moderator> moderator;
@@ -42,6 +42,11 @@ public:
   using ReservedRange = rmf_traffic::blockade::ReservedRange;
   using NewRangeCallback = Writer::NewRangeCallback;
 
+  /// The time that the moderator published a heartbeat. The full heartbeats
+  /// and the delta heartbeats arrive on separate topics, so this is used to
+  /// put them back in order.
+  using Stamp = rcutils_time_point_value_t;
+
   struct RectifierStub;
 
   class Requester : public rmf_traffic::blockade::RectificationRequester
@@ -70,6 +75,7 @@ public:
     rmf_traffic::blockade::Rectifier rectifier;
     std::optional<ReservationId> last_reservation_id;
     NewRangeCallback range_cb;
+    Stamp last_heartbeat = 0;
   };
 
   using StubMap = std::unordered_map<
@@ -85,6 +91,8 @@ public:
 
   using HeartbeatMsg = rmf_traffic_msgs::msg::BlockadeHeartbeat;
   rclcpp::Subscription<HeartbeatMsg>::SharedPtr heartbeat_sub;
+  rclcpp::Subscription<HeartbeatMsg>::SharedPtr heartbeat_delta_sub;
+  Stamp last_full_heartbeat = 0;
 
   // NOTE(MXG): Because of some awkwardness in the design of the rectification
   // factory, we can only allow one participant to be constructed at a time.
@@ -102,9 +110,19 @@ public:
     heartbeat_sub = node.create_subscription<HeartbeatMsg>(
       BlockadeHeartbeatTopicName,
       rclcpp::SystemDefaultsQoS().reliable(),
-      [&](const HeartbeatMsg::UniquePtr msg)
+      [&](const HeartbeatMsg::SharedPtr msg, const rclcpp::MessageInfo& info)
+      {
+        check_status(*msg, info.get_rmw_message_info().source_timestamp);
+      });
+
+    // The moderator publishes only the participants that have changed on this
+    // topic in between the full heartbeats.
+    heartbeat_delta_sub = node.create_subscription<HeartbeatMsg>(
+      BlockadeHeartbeatDeltaTopicName,
+      rclcpp::SystemDefaultsQoS().reliable(),
+      [&](const HeartbeatMsg::SharedPtr msg, const rclcpp::MessageInfo& info)
       {
-        check_status(*msg);
+        check_changes(*msg, info.get_rmw_message_info().source_timestamp);
       });
   }
 
@@ -165,7 +183,55 @@ public:
     return range;
   }
 
-  void check_status(const HeartbeatMsg& heartbeat)
+  void apply_status(
+    RectifierStub& stub,
+    const StatusMsg& status,
+    const Stamp stamp)
+  {
+    // A newer heartbeat has already been applied to this participant
+    if (stamp < stub.last_heartbeat)
+      return;
+
+    stub.last_heartbeat = stamp;
+    stub.rectifier.check(convert(status));
+
+    const auto range = get_range(status);
+    stub.last_reservation_id = status.reservation;
+    stub.range_cb(status.reservation, range);
+  }
+
+  /// Apply a heartbeat that only contains the participants whose status has
+  /// changed. Participants that are missing from it are left alone.
+  void check_changes(const HeartbeatMsg& heartbeat, const Stamp stamp)
+  {
+    const auto writer = weak_writer.lock();
+    if (!writer)
+      return;
+
+    std::unique_lock<std::mutex> lock(factory_mutex);
+
+    // This delta was published before the last full heartbeat that was
+    // applied, so everything in it is already out of date.
+    if (stamp < last_full_heartbeat)
+      return;
+    for (const auto& status : heartbeat.statuses)
+    {
+      const auto it = stub_map.find(status.participant);
+      if (it == stub_map.end())
+      {
+        if (dead_set.count(status.participant))
+          writer->cancel(status.participant);
+
+        continue;
+      }
+
+      // Dead stubs will be cleaned up by the next full heartbeat
+      if (const auto stub = it->second.lock())
+        apply_status(*stub, status, stamp);
+    }
+  }
+
+  void check_status(const HeartbeatMsg& heartbeat, const Stamp stamp)
   {
     const auto writer = weak_writer.lock();
     if (!writer)
@@ -173,6 +239,11 @@ public:
 
     std::unique_lock<std::mutex> lock(factory_mutex);
 
+    if (stamp < last_full_heartbeat)
+      return;
+
+    last_full_heartbeat = stamp;
+
     bring_out_your_dead();
     std::unordered_set<rmf_traffic::blockade::ParticipantId> not_dead_yet;
 
@@ -202,12 +273,7 @@ public:
         continue;
       }
 
-      stub->rectifier.check(convert(status));
-
-      const auto range = get_range(status);
-      stub->last_reservation_id = status.reservation;
-      stub->range_cb(status.reservation, range);
-
+      apply_status(*stub, status, stamp);
       stub_map_copy.erase(it);
     }
 
@@ -15,7 +15,11 @@
  *
 */
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
 
 #include <rclcpp/logger.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -92,6 +96,43 @@ public:
 
   std::shared_ptr<rmf_traffic::schedule::Mirror> mirror;
 
+  // Patches are converted on their own thread so that large updates do not
+  // stall the executor, but they are only ever applied to the mirror on the
+  // executor, where every other user of the mirror reads it. This mutex is
+  // taken alongside the user's update_mutex while a patch is applied.
+  mutable std::mutex mirror_mutex;
+
+  // Incremented whenever the mirror is reset, so that patches which were
+  // queued up for the old schedule node get dropped.
+  std::size_t mirror_generation = 0;
+
+  // Protects the request_changes_client, which the service callbacks replace
+  // when the schedule node restarts.
+  std::mutex services_mutex;
+
+  /// A patch that the patch thread has finished converting
+  struct ConvertedPatch
+  {
+    std::size_t generation;
+    MirrorUpdate::SharedPtr msg;
+    std::optional<rmf_traffic::schedule::Patch> patch;
+    std::string error;
+    std::size_t routes;
+    bool parallel;
+    rmf_traffic::Duration conversion_time;
+  };
+
+  std::mutex patch_queue_mutex;
+  std::condition_variable patch_queue_cv;
+  std::deque<std::pair<std::size_t, MirrorUpdate::SharedPtr>> patch_queue;
+  std::deque<ConvertedPatch> converted_patches;
+  rclcpp::TimerBase::SharedPtr apply_patches_timer;
+  bool stop_patch_thread = false;
+  std::thread patch_thread;
+
+  mutable std::mutex metrics_mutex;
+  PatchMetrics metrics;
+
   bool initial_update = true;
 
   rmf_traffic::schedule::Version next_minimum_version = 0;
@@ -122,6 +163,20 @@ public:
       {
         handle_startup_event(*msg);
       });
+
+    patch_thread = std::thread([this]() { run_patch_thread(); });
+  }
+
+  ~Implementation()
+  {
+    {
+      std::lock_guard<std::mutex> lock(patch_queue_mutex);
+      stop_patch_thread = true;
+    }
+    patch_queue_cv.notify_all();
+
+    if (patch_thread.joinable())
+      patch_thread.join();
   }
 
   bool reconnect_schedule(
@@ -280,16 +335,9 @@ public:
 
     try
     {
-      std::mutex* update_mutex = options.update_mutex();
-      if (update_mutex)
-      {
-        std::lock_guard<std::mutex> lock(*update_mutex);
-        mirror->update_participants_info(convert(*msg));
-      }
-      else
-      {
-        mirror->update_participants_info(convert(*msg));
-      }
+      const auto info = convert(*msg);
+      auto lock = lock_mirror();
+      mirror->update_participants_info(info);
     }
     catch (const std::exception& e)
     {
@@ -327,27 +375,175 @@ public:
     stashed_query_updates.clear();
   }
 
-  void apply_patch(
-    const std::shared_ptr<rclcpp::Node>& node,
-    const rmf_traffic_msgs::msg::SchedulePatch& msg,
-    const bool is_remedial)
+  /// Lock the user's update mutex, if one was given, and then the mirror mutex.
+  std::pair<std::unique_lock<std::mutex>, std::unique_lock<std::mutex>>
+  lock_mirror() const
+  {
+    std::unique_lock<std::mutex> user_lock;
+    if (std::mutex* update_mutex = options.update_mutex())
+      user_lock = std::unique_lock<std::mutex>(*update_mutex);
+
+    return {std::move(user_lock), std::unique_lock<std::mutex>(mirror_mutex)};
+  }
+
+  std::optional<rmf_traffic::schedule::Version> latest_mirror_version() const
+  {
+    std::lock_guard<std::mutex> lock(mirror_mutex);
+    return mirror->latest_version();
+  }
+
+  void run_patch_thread()
+  {
+    while (true)
+    {
+      std::unique_lock<std::mutex> lock(patch_queue_mutex);
+      patch_queue_cv.wait(lock, [&]()
+        {
+          return stop_patch_thread || !patch_queue.empty();
+        });
+
+      if (stop_patch_thread)
+        return;
+
+      auto [generation, msg] = std::move(patch_queue.front());
+      patch_queue.pop_front();
+      lock.unlock();
+
+      convert_patch(generation, std::move(msg));
+    }
+  }
+
+  void convert_patch(const std::size_t generation, MirrorUpdate::SharedPtr msg)
   {
-    const rmf_traffic::schedule::Patch patch = convert(msg);
-    if (!mirror->update(patch) && !is_remedial)
+    const auto node = weak_node.lock();
+    if (!node)
+      return;
+
+    ConvertedPatch converted;
+    converted.generation = generation;
+    converted.routes = count_routes(msg->patch);
+    const std::size_t threshold = options.parallel_conversion_threshold();
+    converted.parallel = threshold > 0 && converted.routes >= threshold;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    try
+    {
+      converted.patch = converted.parallel ?
+        convert(msg->patch, std::thread::hardware_concurrency()) :
+        convert(msg->patch);
+    }
+    catch (const std::exception& e)
+    {
+      converted.error = e.what();
+    }
+    converted.conversion_time = std::chrono::steady_clock::now() - start_time;
+    converted.msg = std::move(msg);
+
+    // The mirror is only modified on the executor, so hand the patch back to
+    // it. Patches that finish converting close together are applied by the
+    // same timer callback.
+    std::lock_guard<std::mutex> lock(patch_queue_mutex);
+    converted_patches.push_back(std::move(converted));
+    if (apply_patches_timer)
+      return;
+
+    apply_patches_timer = node->create_wall_timer(
+      std::chrono::nanoseconds(0),
+      [this]()
+      {
+        std::deque<ConvertedPatch> patches;
+        {
+          std::lock_guard<std::mutex> lock(patch_queue_mutex);
+          patches.swap(converted_patches);
+          apply_patches_timer->cancel();
+          apply_patches_timer.reset();
+        }
+
+        for (const auto& converted : patches)
+          apply_patch(converted);
+      });
+  }
+
+  void apply_patch(const ConvertedPatch& converted)
+  {
+    const auto node = weak_node.lock();
+    if (!node)
+      return;
+
+    const auto& msg = *converted.msg;
+    if (!converted.patch.has_value())
+    {
+      RCLCPP_ERROR(
+        node->get_logger(),
+        "[rmf_traffic_ros2::MirrorManager] Failed to deserialize Patch "
+        "message: %s",
+        converted.error.c_str());
+      // Get a full update in case we're just missing some information
+      request_update();
+      return;
+    }
+
+    const auto& patch = *converted.patch;
+    const auto start_time = std::chrono::steady_clock::now();
+    bool updated = false;
+    std::optional<rmf_traffic::schedule::Version> mirror_version;
+    {
+      auto lock = lock_mirror();
+      if (converted.generation != mirror_generation)
+      {
+        // The mirror was reset after this patch arrived, so it no longer
+        // applies.
+        return;
+      }
+
+      updated = mirror->update(patch);
+      mirror_version = mirror->latest_version();
+    }
+    const auto apply_time = std::chrono::steady_clock::now() - start_time;
+
+    {
+      std::lock_guard<std::mutex> lock(metrics_mutex);
+      const auto conversion_time = converted.conversion_time;
+      ++metrics.patches;
+      if (!updated)
+        ++metrics.failed_patches;
+      if (converted.parallel)
+        ++metrics.parallel_conversions;
+      metrics.total_routes += converted.routes;
+      metrics.max_routes = std::max(metrics.max_routes, converted.routes);
+      metrics.total_conversion_time += conversion_time;
+      metrics.max_conversion_time =
+        std::max(metrics.max_conversion_time, conversion_time);
+      metrics.total_apply_time += apply_time;
+      metrics.max_apply_time = std::max(metrics.max_apply_time, apply_time);
+    }
+
+    RCLCPP_DEBUG(
+      node->get_logger(),
+      "Applied patch for DB version %lu with [%lu] participants and [%lu] "
+      "routes: conversion took %fs%s, update took %fs",
+      patch.latest_version(),
+      msg.patch.participants.size(),
+      converted.routes,
+      rmf_traffic::time::to_seconds(converted.conversion_time),
+      converted.parallel ? " (parallel)" : "",
+      rmf_traffic::time::to_seconds(apply_time));
+
+    if (!updated && !msg.is_remedial_update)
     {
       std::string patch_base = patch.base_version() ?
         std::to_string(*patch.base_version()) : std::string("any");
-      std::string mirror_version = mirror->latest_version() ?
-        std::to_string(*mirror->latest_version()) : std::string("none");
+      std::string mirror_version_str = mirror_version ?
+        std::to_string(*mirror_version) : std::string("none");
       RCLCPP_WARN(
         node->get_logger(),
         "Failed to update using patch for DB version %lu "
         "(mirror version: %s, patch base: %s); requesting new update",
         patch.latest_version(),
-        mirror_version.c_str(),
+        mirror_version_str.c_str(),
         patch_base.c_str());
 
-      request_update(mirror->latest_version());
+      request_update(mirror_version);
     }
   }
 
@@ -393,31 +589,20 @@ public:
       return;
     }
 
-    try
+    // Each patch is converted exactly once, on the patch thread, so that large
+    // patches do not hold up the rest of the executor. It comes back to the
+    // executor to be applied.
+    std::size_t generation;
     {
-      const rmf_traffic::schedule::Patch patch = convert(msg->patch);
-
-      std::mutex* update_mutex = options.update_mutex();
-      if (update_mutex)
-      {
-        std::lock_guard<std::mutex> lock(*update_mutex);
-        apply_patch(node, msg->patch, msg->is_remedial_update);
-      }
-      else
-      {
-        apply_patch(node, msg->patch, msg->is_remedial_update);
-      }
+      std::lock_guard<std::mutex> lock(mirror_mutex);
+      generation = mirror_generation;
     }
-    catch (const std::exception& e)
+
     {
-      RCLCPP_ERROR(
-        node->get_logger(),
-        "[rmf_traffic_ros2::MirrorManager] Failed to deserialize Patch "
-        "message: %s",
-        e.what());
-      // Get a full update in case we're just missing some information
-      request_update();
+      std::lock_guard<std::mutex> lock(patch_queue_mutex);
+      patch_queue.emplace_back(generation, msg);
     }
+    patch_queue_cv.notify_one();
   }
 
   void handle_update_timeout()
@@ -429,7 +614,7 @@ public:
     RCLCPP_INFO(
       node->get_logger(),
       "Requesting new schedule update because update timed out");
-    request_update(mirror->latest_version());
+    request_update(latest_mirror_version());
   }
 
   void request_update(std::optional<uint64_t> minimum_version = std::nullopt)
@@ -462,9 +647,15 @@ public:
       request.full_update = true;
     }
 
-    if (request_changes_client && request_changes_client->service_is_ready())
+    RequestChangesClient client;
+    {
+      std::lock_guard<std::mutex> lock(services_mutex);
+      client = request_changes_client;
+    }
+
+    if (client && client->service_is_ready())
     {
-      request_changes_client->async_send_request(
+      client->async_send_request(
         std::make_shared<RequestChanges::Request>(request),
         [this, minimum_version](const RequestChangesFuture response)
         {
@@ -594,8 +785,16 @@ public:
   void reconnect_services()
   {
     register_query_client = nullptr;
-    request_changes_client = nullptr;
-    mirror->reset();
+    {
+      std::lock_guard<std::mutex> lock(services_mutex);
+      request_changes_client = nullptr;
+    }
+
+    {
+      auto lock = lock_mirror();
+      mirror->reset();
+      ++mirror_generation;
+    }
 
     const auto node = weak_node.lock();
     if (!node)
@@ -617,8 +816,12 @@ public:
         register_query_client =
         node->create_client<RegisterQuery>(RegisterQueryServiceName);
 
-        request_changes_client = node->create_client<RequestChanges>(
+        auto client = node->create_client<RequestChanges>(
           RequestChangesServiceName);
+        {
+          std::lock_guard<std::mutex> lock(services_mutex);
+          request_changes_client = std::move(client);
+        }
 
         reconnect_services_timer = nullptr;
       });
@@ -669,6 +872,8 @@ public:
 
   bool update_on_wakeup;
 
+  std::size_t parallel_conversion_threshold = 500;
+
 };
 
 //==============================================================================
@@ -710,6 +915,20 @@ auto MirrorManager::Options::update_on_wakeup(bool choice) -> Options&
   return *this;
 }
 
+//==============================================================================
+std::size_t MirrorManager::Options::parallel_conversion_threshold() const
+{
+  return _pimpl->parallel_conversion_threshold;
+}
+
+//==============================================================================
+auto MirrorManager::Options::parallel_conversion_threshold(std::size_t routes)
+-> Options&
+{
+  _pimpl->parallel_conversion_threshold = routes;
+  return *this;
+}
+
 //==============================================================================
 std::shared_ptr<const rmf_traffic::schedule::Mirror>
 MirrorManager::view() const
@@ -720,7 +939,7 @@ MirrorManager::view() const
 //==============================================================================
 void MirrorManager::update()
 {
-  _pimpl->request_update(_pimpl->mirror->latest_version());
+  _pimpl->request_update(_pimpl->latest_mirror_version());
 }
 
 //==============================================================================
@@ -739,9 +958,17 @@ MirrorManager& MirrorManager::set_options(Options options)
 //==============================================================================
 rmf_traffic::schedule::Database MirrorManager::fork() const
 {
+  std::lock_guard<std::mutex> lock(_pimpl->mirror_mutex);
   return _pimpl->mirror->fork();
 }
 
+//==============================================================================
+auto MirrorManager::patch_metrics() const -> PatchMetrics
+{
+  std::lock_guard<std::mutex> lock(_pimpl->metrics_mutex);
+  return _pimpl->metrics;
+}
+
 //==============================================================================
 MirrorManager::MirrorManager()
 {
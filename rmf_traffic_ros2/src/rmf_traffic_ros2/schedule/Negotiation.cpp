@@ -514,16 +514,24 @@ public:
     auto& room = insertion.first->second.room;
     Negotiation& negotiation = room.negotiation;
 
+    std::vector<TablePtr> queue;
     if (!is_new)
     {
+      bool added = false;
       const auto& old_participants = negotiation.participants();
       for (const auto p : msg.participants)
       {
         if (old_participants.count(p) == 0)
         {
           negotiation.add_participant(p);
+          added = true;
         }
       }
+
+      // Adding participants creates new tables that cached messages might have
+      // been waiting for.
+      if (added)
+        queue = room.check_cache(*negotiators);
     }
 
     if (!relevant)
@@ -535,7 +543,6 @@ public:
     // TODO(MXG): Is the participating flag even relevant?
     participating = true;
 
-    std::vector<TablePtr> queue;
     for (const auto p : negotiation.participants())
       queue.push_back(negotiation.table(p, {}));
 
@@ -574,7 +581,7 @@ public:
       error += " " + std::to_string(msg.for_participant) + " ]";
 
       RCLCPP_WARN(node.get_logger(), "%s", error.c_str());
-      room.cached_proposals.push_back(msg);
+      room.cache(msg);
       return;
     }
 
@@ -593,7 +600,8 @@ public:
       status_callback(msg.conflict_version, table_view);
     }
 
-    std::vector<TablePtr> queue = room.check_cache(*negotiators);
+    std::vector<TablePtr> queue =
+      room.check_cache(*negotiators, received_table);
 
     if (!participating)
       return;
@@ -640,7 +648,7 @@ public:
 
       RCLCPP_WARN(node.get_logger(), "%s", error.c_str());
 
-      room.cached_rejections.push_back(msg);
+      room.cache(msg);
       return;
     }
 
@@ -656,7 +664,7 @@ public:
       status_callback(msg.conflict_version, table_view);
     }
 
-    std::vector<TablePtr> queue = room.check_cache(*negotiators);
+    std::vector<TablePtr> queue = room.check_cache(*negotiators, table);
 
     if (!negotiate_it->second.participating)
       return;
@@ -685,7 +693,7 @@ public:
     const auto table = search.table;
     if (!table)
     {
-      room.cached_forfeits.push_back(msg);
+      room.cache(msg);
       return;
     }
 
@@ -697,7 +705,8 @@ public:
       status_callback(msg.conflict_version, table_view);
     }
 
-    respond_to_queue(room.check_cache(*negotiators), msg.conflict_version);
+    respond_to_queue(
+      room.check_cache(*negotiators, table), msg.conflict_version);
   }
 
   void dump_conclusion_info(
@@ -23,6 +23,7 @@
 
 #include <rmf_traffic_msgs/msg/negotiation_key.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 namespace rmf_traffic_ros2 {
@@ -66,170 +67,330 @@ NegotiationRoom::NegotiationRoom(rmf_traffic::schedule::Negotiation negotiation_
 }
 
 //==============================================================================
-void NegotiationRoom::update_state_msg(
+bool NegotiationRoom::StateDelta::tree_changed() const
+{
+  return tables_added > 0 || submissions_changed > 0 || rejections_changed > 0
+    || participants_changed || rebuilt;
+}
+
+//==============================================================================
+bool NegotiationRoom::StateDelta::any() const
+{
+  return tree_changed() || status_changed || orphans_changed;
+}
+
+//==============================================================================
+auto NegotiationRoom::StateDelta::operator+=(const StateDelta& other)
+-> StateDelta&
+{
+  tables_added += other.tables_added;
+  submissions_changed += other.submissions_changed;
+  rejections_changed += other.rejections_changed;
+  participants_changed = participants_changed || other.participants_changed;
+  status_changed = status_changed || other.status_changed;
+  orphans_changed = orphans_changed || other.orphans_changed;
+  rebuilt = rebuilt || other.rebuilt;
+  return *this;
+}
+
+//==============================================================================
+auto NegotiationRoom::update_state_msg(
   const uint64_t conflict_version,
   rmf_traffic::Time start_time,
-  rmf_traffic::Time last_active_time)
+  rmf_traffic::Time last_active_time) -> StateDelta
 {
-  state_msg.status.participants.clear();
-  state_msg.tree.clear();
-  state_msg.orphan_proposals.clear();
-  state_msg.orphan_rejections.clear();
-  state_msg.orphan_forfeits.clear();
+  StateDelta delta;
+
+  const auto start_time_msg = convert(start_time);
+  const auto last_active_msg = convert(last_active_time);
+  auto& status = state_msg.status;
+  if (status.conflict_version != conflict_version
+    || status.start_time != start_time_msg
+    || status.last_response_time != last_active_msg)
+  {
+    status.conflict_version = conflict_version;
+    status.start_time = start_time_msg;
+    status.last_response_time = last_active_msg;
+    delta.status_changed = true;
+  }
 
-  state_msg.status.conflict_version = conflict_version;
-  state_msg.status.start_time = convert(start_time);
-  state_msg.status.last_response_time = convert(last_active_time);
+  const auto& participants = negotiation.participants();
+  if (status.participants.size() != participants.size())
+  {
+    status.participants.assign(participants.begin(), participants.end());
+    delta.participants_changed = true;
+  }
 
   using Negotiation = rmf_traffic::schedule::Negotiation;
-  std::vector<Negotiation::ConstTablePtr> queue;
-  std::unordered_map<Negotiation::ConstTablePtr, int64_t> table_index;
-
-  for (const auto p : negotiation.participants())
+  // The tree only describes the root table of each participant.
+  std::vector<Negotiation::ConstTablePtr> tables;
+  tables.reserve(participants.size());
+  for (const auto p : participants)
   {
-    state_msg.status.participants.push_back(p);
     const auto p_table = negotiation.table(p, {});
     assert(p_table);
-    queue.push_back(p_table);
+    tables.push_back(p_table);
   }
 
-  while (!queue.empty())
+  std::size_t known = 0;
+  for (const auto& table : tables)
   {
-    Negotiation::ConstTablePtr top = queue.back();
-    queue.pop_back();
+    if (_table_records.count(table))
+      ++known;
+  }
 
-    table_index[top] = state_msg.tree.size();
-    rmf_traffic_msgs::msg::NegotiationTreeNode node;
-    if (const auto parent = top->parent())
+  if (known < _table_records.size())
+  {
+    // Some table that we had before is gone, so the indices in the tree are no
+    // longer reliable. This only happens when the structure of the negotiation
+    // itself changes, so we just start over.
+    _table_records.clear();
+    state_msg.tree.clear();
+    delta.rebuilt = true;
+  }
+
+  for (const auto& table : tables)
+  {
+    const uint64_t version = table->version();
+    const bool rejected = table->rejected();
+
+    const auto it = _table_records.find(table);
+    if (it == _table_records.end())
     {
-      node.parent = table_index.at(parent);
+      rmf_traffic_msgs::msg::NegotiationTreeNode node;
+      if (const auto parent = table->parent())
+      {
+        node.parent = _table_records.at(parent).index;
+      }
+      else
+      {
+        // Root nodes are given a parent value of -1
+        node.parent = -1;
+      }
+
+      using Key = rmf_traffic_msgs::msg::NegotiationKey;
+      node.key = rmf_traffic_msgs::build<Key>()
+        .participant(table->participant())
+        .version(version);
+
+      node.rejected = rejected;
+      if (const auto* submission = table->submission())
+        node.itinerary = convert(*submission);
+
+      _table_records.insert(
+        {table, TableRecord{state_msg.tree.size(), version, rejected}});
+      state_msg.tree.push_back(std::move(node));
+      ++delta.tables_added;
+      continue;
     }
-    else
+
+    auto& record = it->second;
+    auto& node = state_msg.tree[record.index];
+    if (record.version != version)
     {
-      // Root nodes are given a parent value of -1
-      node.parent = -1;
-    }
+      node.key.version = version;
+      node.itinerary.clear();
+      if (const auto* submission = table->submission())
+        node.itinerary = convert(*submission);
 
-    using Key = rmf_traffic_msgs::msg::NegotiationKey;
-    node.key = rmf_traffic_msgs::build<Key>()
-      .participant(top->participant())
-      .version(top->version());
+      record.version = version;
+      ++delta.submissions_changed;
+    }
 
-    node.rejected = top->rejected();
-    if (const auto* submission = top->submission())
-      node.itinerary = convert(*submission);
+    if (record.rejected != rejected)
+    {
+      node.rejected = rejected;
+      record.rejected = rejected;
+      ++delta.rejections_changed;
+    }
+  }
 
-    state_msg.tree.push_back(std::move(node));
+  if (_orphans_changed)
+  {
+    _update_orphans();
+    _orphans_changed = false;
+    delta.orphans_changed = true;
   }
 
-  for (const auto& proposal : cached_proposals)
-    state_msg.orphan_proposals.push_back(proposal);
+  if (delta.any())
+    state_changed = true;
+
+  return delta;
+}
 
-  for (const auto& rejection : cached_rejections)
-    state_msg.orphan_rejections.push_back(rejection);
+//==============================================================================
+std::size_t NegotiationRoom::SequenceHash::operator()(
+  const Sequence& sequence) const
+{
+  std::size_t seed = sequence.size();
+  for (const auto p : sequence)
+    seed ^= std::hash<ParticipantId>{}(p) + 0x9e3779b9 + (seed << 6)
+      + (seed >> 2);
 
-  for (const auto& forfeit : cached_forfeits)
-    state_msg.orphan_forfeits.push_back(forfeit);
+  return seed;
 }
 
+namespace {
 //==============================================================================
-std::vector<rmf_traffic::schedule::Negotiation::TablePtr> NegotiationRoom::
-check_cache(const NegotiatorMap& negotiators)
+std::vector<ParticipantId> participants_of(
+  const std::vector<rmf_traffic_msgs::msg::NegotiationKey>& keys)
 {
-  std::vector<rmf_traffic::schedule::Negotiation::TablePtr> new_tables;
+  std::vector<ParticipantId> output;
+  output.reserve(keys.size() + 1);
+  for (const auto& key : keys)
+    output.push_back(key.participant);
+
+  return output;
+}
+} // anonymous namespace
 
-  bool recheck = false;
-  do
+//==============================================================================
+void NegotiationRoom::cache(const Proposal& proposal)
+{
+  auto sequence = participants_of(proposal.to_accommodate);
+  sequence.push_back(proposal.for_participant);
+  _cache[std::move(sequence)].proposals.push_back(proposal);
+  ++_cached_size;
+  _orphans_changed = true;
+}
+
+//==============================================================================
+void NegotiationRoom::cache(const Rejection& rejection)
+{
+  _cache[participants_of(rejection.table)].rejections.push_back(rejection);
+  ++_cached_size;
+  _orphans_changed = true;
+}
+
+//==============================================================================
+void NegotiationRoom::cache(const Forfeit& forfeit)
+{
+  _cache[participants_of(forfeit.table)].forfeits.push_back(forfeit);
+  ++_cached_size;
+  _orphans_changed = true;
+}
+
+//==============================================================================
+std::size_t NegotiationRoom::cached_size() const
+{
+  return _cached_size;
+}
+
+//==============================================================================
+auto NegotiationRoom::check_cache(
+  const NegotiatorMap& negotiators,
+  const TablePtr& changed_table) -> std::vector<TablePtr>
+{
+  if (_cache.empty() || !changed_table)
+    return {};
+
+  std::vector<Sequence> queue;
+  _queue_changed(*changed_table, queue);
+  return _release(negotiators, std::move(queue));
+}
+
+//==============================================================================
+auto NegotiationRoom::check_cache(const NegotiatorMap& negotiators)
+-> std::vector<TablePtr>
+{
+  std::vector<Sequence> queue;
+  queue.reserve(_cache.size());
+  for (const auto& [sequence, _] : _cache)
+    queue.push_back(sequence);
+
+  return _release(negotiators, std::move(queue));
+}
+
+//==============================================================================
+auto NegotiationRoom::_release(
+  const NegotiatorMap& negotiators,
+  std::vector<Sequence> queue) -> std::vector<TablePtr>
+{
+  std::vector<TablePtr> new_tables;
+  while (!queue.empty() && !_cache.empty())
   {
-    recheck = false;
+    const auto it = _cache.find(queue.back());
+    queue.pop_back();
+    if (it == _cache.end())
+      continue;
 
-    for (auto it = cached_proposals.begin(); it != cached_proposals.end(); )
+    Pending pending = std::move(it->second);
+    _cache.erase(it);
+    _cached_size -= pending.proposals.size() + pending.rejections.size()
+      + pending.forfeits.size();
+    _orphans_changed = true;
+
+    for (const auto& proposal : pending.proposals)
     {
-      const auto& proposal = *it;
       const auto search = negotiation.find(
         proposal.for_participant, convert(proposal.to_accommodate));
 
       if (search.deprecated())
-      {
-        cached_proposals.erase(it++);
         continue;
-      }
 
       const auto table = search.table;
-      if (table)
+      if (!table)
       {
-        const bool updated = table->submit(
-          proposal.plan_id,
-          rmf_traffic_ros2::convert(proposal.itinerary),
-          proposal.proposal_version);
+        cache(proposal);
+        continue;
+      }
 
-        if (updated)
-          new_tables.push_back(table);
+      const bool updated = table->submit(
+        proposal.plan_id,
+        rmf_traffic_ros2::convert(proposal.itinerary),
+        proposal.proposal_version);
 
-        recheck = true;
-        cached_proposals.erase(it++);
+      if (updated)
+      {
+        new_tables.push_back(table);
+        _queue_changed(*table, queue);
       }
-      else
-        ++it;
     }
 
-    for (auto it = cached_rejections.begin(); it != cached_rejections.end(); )
+    for (const auto& rejection : pending.rejections)
     {
-      const auto& rejection = *it;
       const auto search = negotiation.find(convert(rejection.table));
-
       if (search.deprecated())
-      {
-        cached_rejections.erase(it++);
         continue;
-      }
 
       const auto table = search.table;
-      if (table)
+      if (!table)
       {
-        table->reject(
-          rejection.table.back().version,
-          rejection.rejected_by,
-          rmf_traffic_ros2::convert(rejection.alternatives));
-        recheck = true;
-        cached_rejections.erase(it++);
+        cache(rejection);
+        continue;
       }
-      else
-        ++it;
+
+      table->reject(
+        rejection.table.back().version,
+        rejection.rejected_by,
+        rmf_traffic_ros2::convert(rejection.alternatives));
     }
 
-    for (auto it = cached_forfeits.begin(); it != cached_forfeits.end(); )
+    for (const auto& forfeit : pending.forfeits)
     {
-      const auto& forfeit = *it;
       const auto search = negotiation.find(convert(forfeit.table));
-
       if (search.deprecated())
-      {
-        cached_forfeits.erase(it++);
         continue;
-      }
 
       const auto table = search.table;
-      if (table)
+      if (!table)
       {
-        table->forfeit(forfeit.table.back().version);
-        recheck = true;
-        cached_forfeits.erase(it++);
+        cache(forfeit);
+        continue;
       }
-      else
-        ++it;
-    }
 
-  } while (recheck);
+      table->forfeit(forfeit.table.back().version);
+    }
+  }
 
   auto remove_it = std::remove_if(new_tables.begin(), new_tables.end(),
-      [](const rmf_traffic::schedule::Negotiation::TablePtr& table)
+      [](const TablePtr& table)
       {
         return table->forfeited() || table->defunct();
       });
   new_tables.erase(remove_it, new_tables.end());
 
-  std::vector<rmf_traffic::schedule::Negotiation::TablePtr> respond_to;
+  std::vector<TablePtr> respond_to;
   for (const auto& new_table : new_tables)
   {
     for (const auto& n : negotiators)
@@ -243,6 +404,51 @@ check_cache(const NegotiatorMap& negotiators)
   return respond_to;
 }
 
+//==============================================================================
+void NegotiationRoom::_queue_changed(
+  const rmf_traffic::schedule::Negotiation::Table& table,
+  std::vector<Sequence>& queue) const
+{
+  // When a table changes, the messages that could have become applicable are
+  // the ones for that table itself and for its children.
+  Sequence sequence;
+  sequence.reserve(table.sequence().size() + 1);
+  for (const auto& key : table.sequence())
+    sequence.push_back(key.participant);
+
+  for (const auto p : negotiation.participants())
+  {
+    if (std::find(sequence.begin(), sequence.end(), p) != sequence.end())
+      continue;
+
+    auto child = sequence;
+    child.push_back(p);
+    queue.push_back(std::move(child));
+  }
+
+  queue.push_back(std::move(sequence));
+}
+
+//==============================================================================
+void NegotiationRoom::_update_orphans()
+{
+  state_msg.orphan_proposals.clear();
+  state_msg.orphan_rejections.clear();
+  state_msg.orphan_forfeits.clear();
+  for (const auto& [_, pending] : _cache)
+  {
+    state_msg.orphan_proposals.insert(
+      state_msg.orphan_proposals.end(),
+      pending.proposals.begin(), pending.proposals.end());
+    state_msg.orphan_rejections.insert(
+      state_msg.orphan_rejections.end(),
+      pending.rejections.begin(), pending.rejections.end());
+    state_msg.orphan_forfeits.insert(
+      state_msg.orphan_forfeits.end(),
+      pending.forfeits.begin(), pending.forfeits.end());
+  }
+}
+
 //==============================================================================
 void print_negotiation_status(
   rmf_traffic::schedule::Version conflict_version,
@@ -26,7 +26,8 @@
 #include <rmf_traffic_msgs/msg/negotiation_key.hpp>
 #include <rmf_traffic_msgs/msg/negotiation_state.hpp>
 
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace rmf_traffic_ros2 {
 
@@ -50,20 +51,109 @@ struct NegotiationRoom
 {
   NegotiationRoom(rmf_traffic::schedule::Negotiation negotiation_);
 
+  using Proposal = rmf_traffic_msgs::msg::NegotiationProposal;
+  using Rejection = rmf_traffic_msgs::msg::NegotiationRejection;
+  using Forfeit = rmf_traffic_msgs::msg::NegotiationForfeit;
+  using TablePtr = rmf_traffic::schedule::Negotiation::TablePtr;
+
   rmf_traffic::schedule::Negotiation negotiation;
-  std::list<rmf_traffic_msgs::msg::NegotiationProposal> cached_proposals;
-  std::list<rmf_traffic_msgs::msg::NegotiationRejection> cached_rejections;
-  std::list<rmf_traffic_msgs::msg::NegotiationForfeit> cached_forfeits;
+
+  /// Hold onto a message whose table does not exist yet. It will be applied
+  /// by check_cache() once its table shows up.
+  void cache(const Proposal& proposal);
+  void cache(const Rejection& rejection);
+  void cache(const Forfeit& forfeit);
+
+  /// The number of messages that are waiting for their tables
+  std::size_t cached_size() const;
 
   rmf_traffic_msgs::msg::NegotiationState state_msg;
 
-  void update_state_msg(
+  /// True when state_msg has changed since the last time it was published.
+  bool state_changed = true;
+
+  /// A description of what changed in the negotiation tree during one call to
+  /// update_state_msg.
+  struct StateDelta
+  {
+    std::size_t tables_added = 0;
+    std::size_t submissions_changed = 0;
+    std::size_t rejections_changed = 0;
+    bool participants_changed = false;
+    bool status_changed = false;
+    bool orphans_changed = false;
+
+    /// True if the tree had to be rebuilt from scratch because some table that
+    /// was previously in it has disappeared.
+    bool rebuilt = false;
+
+    bool tree_changed() const;
+    bool any() const;
+
+    StateDelta& operator+=(const StateDelta& other);
+  };
+
+  /// Bring state_msg up to date with the negotiation. Only the tree nodes of
+  /// tables that have been added or changed since the last update are
+  /// (re)converted.
+  StateDelta update_state_msg(
     uint64_t conflict_version,
     rmf_traffic::Time start_time,
     rmf_traffic::Time last_active_time);
 
-  std::vector<rmf_traffic::schedule::Negotiation::TablePtr> check_cache(
-    const NegotiatorMap& negotiators);
+  /// Apply the cached messages whose tables have appeared because of a change
+  /// to the given table, e.g. a submission. Only the messages that are waiting
+  /// on that table or its children are looked at. Any tables that the
+  /// negotiators need to respond to are returned.
+  std::vector<TablePtr> check_cache(
+    const NegotiatorMap& negotiators,
+    const TablePtr& changed_table);
+
+  /// Try to apply every cached message. This is needed when tables appear
+  /// without any submission, i.e. when participants are added.
+  std::vector<TablePtr> check_cache(const NegotiatorMap& negotiators);
+
+private:
+  /// The participants of the table that a cached message is waiting for.
+  /// Versions are left out because a message should be retried whenever its
+  /// table is replaced by a newer version.
+  using Sequence = std::vector<ParticipantId>;
+
+  struct SequenceHash
+  {
+    std::size_t operator()(const Sequence& sequence) const;
+  };
+
+  struct Pending
+  {
+    std::vector<Proposal> proposals;
+    std::vector<Rejection> rejections;
+    std::vector<Forfeit> forfeits;
+  };
+
+  std::unordered_map<Sequence, Pending, SequenceHash> _cache;
+  std::size_t _cached_size = 0;
+  bool _orphans_changed = false;
+
+  std::vector<TablePtr> _release(
+    const NegotiatorMap& negotiators,
+    std::vector<Sequence> queue);
+
+  void _queue_changed(
+    const rmf_traffic::schedule::Negotiation::Table& table,
+    std::vector<Sequence>& queue) const;
+
+  void _update_orphans();
+
+  struct TableRecord
+  {
+    std::size_t index;
+    uint64_t version;
+    bool rejected;
+  };
+
+  using ConstTablePtr = rmf_traffic::schedule::Negotiation::ConstTablePtr;
+  std::unordered_map<ConstTablePtr, TableRecord> _table_records;
 };
 
 //==============================================================================
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "NegotiationTrace.hpp"
+
+#include <rclcpp/logging.hpp>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+NegotiationTrace::NegotiationTrace(
+  rclcpp::Logger logger,
+  rmf_traffic::Duration period)
+: _logger(std::move(logger)),
+  _period(period)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void NegotiationTrace::record(
+  const Version conflict_version,
+  const NegotiationRoom& room,
+  const StateDelta& delta)
+{
+  if (!delta.any())
+    return;
+
+  auto& pending = _pending[conflict_version];
+  pending.delta += delta;
+  ++pending.events;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (pending.last_summary.has_value() && now < *pending.last_summary + _period)
+    return;
+
+  _summarize(conflict_version, room, pending);
+}
+
+//==============================================================================
+void NegotiationTrace::finish(
+  const Version conflict_version,
+  const NegotiationRoom& room)
+{
+  const auto it = _pending.find(conflict_version);
+  if (it == _pending.end())
+    return;
+
+  if (it->second.events > 0)
+    _summarize(conflict_version, room, it->second);
+
+  _pending.erase(it);
+}
+
+//==============================================================================
+void NegotiationTrace::_summarize(
+  const Version conflict_version,
+  const NegotiationRoom& room,
+  Pending& pending)
+{
+  std::string participants;
+  for (const auto p : room.negotiation.participants())
+    participants += " " + std::to_string(p);
+
+  const auto& d = pending.delta;
+  RCLCPP_INFO(
+    _logger,
+    "Negotiation [%lu] | participants:%s | tables: %lu (+%lu) | "
+    "submissions: +%lu | rejections: +%lu | orphans: %lu | ready: %s | "
+    "complete: %s | events: %lu%s",
+    conflict_version,
+    participants.c_str(),
+    room.state_msg.tree.size(),
+    d.tables_added,
+    d.submissions_changed,
+    d.rejections_changed,
+    room.cached_size(),
+    room.negotiation.ready() ? "yes" : "no",
+    room.negotiation.complete() ? "yes" : "no",
+    pending.events,
+    d.rebuilt ? " | rebuilt" : "");
+
+  pending.delta = StateDelta();
+  pending.events = 0;
+  pending.last_summary = std::chrono::steady_clock::now();
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
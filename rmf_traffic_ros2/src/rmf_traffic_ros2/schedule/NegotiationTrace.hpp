@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__NEGOTIATIONTRACE_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__NEGOTIATIONTRACE_HPP
+
+#include "NegotiationRoom.hpp"
+
+#include <rmf_traffic/Time.hpp>
+
+#include <rclcpp/logger.hpp>
+
+#include <optional>
+#include <unordered_map>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// Accumulates the changes that happen to each negotiation and logs a one-line
+/// summary of them at most once per period, instead of dumping the whole
+/// negotiation tree every time anything changes.
+class NegotiationTrace
+{
+public:
+
+  using Version = rmf_traffic::schedule::Version;
+  using StateDelta = NegotiationRoom::StateDelta;
+
+  /// Constructor
+  ///
+  /// \param[in] logger
+  ///   The logger that summaries will be written to
+  ///
+  /// \param[in] period
+  ///   The minimum time between two summaries of the same negotiation. A zero
+  ///   period summarizes every change.
+  NegotiationTrace(rclcpp::Logger logger, rmf_traffic::Duration period);
+
+  /// Record a change to a negotiation.
+  void record(
+    Version conflict_version,
+    const NegotiationRoom& room,
+    const StateDelta& delta);
+
+  /// Log anything that is still pending for this negotiation and stop tracking
+  /// it.
+  void finish(Version conflict_version, const NegotiationRoom& room);
+
+private:
+
+  struct Pending
+  {
+    StateDelta delta;
+    std::size_t events = 0;
+    std::optional<rmf_traffic::Time> last_summary;
+  };
+
+  void _summarize(
+    Version conflict_version,
+    const NegotiationRoom& room,
+    Pending& pending);
+
+  rclcpp::Logger _logger;
+  rmf_traffic::Duration _period;
+  std::unordered_map<Version, Pending> _pending;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__NEGOTIATIONTRACE_HPP
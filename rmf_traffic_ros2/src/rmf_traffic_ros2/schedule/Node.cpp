@@ -29,6 +29,7 @@
 #include <rmf_traffic_ros2/schedule/Writer.hpp>
 #include <rmf_traffic_ros2/schedule/ParticipantDescription.hpp>
 #include <rmf_traffic_ros2/schedule/Inconsistencies.hpp>
+#include <rmf_traffic_ros2/schedule/RouteBounds.hpp>
 #include <rmf_traffic_ros2/schedule/ScheduleIdentity.hpp>
 
 #include <rmf_traffic/DetectConflict.hpp>
@@ -36,6 +37,7 @@
 
 #include <rmf_utils/optional.hpp>
 
+#include <filesystem>
 #include <unordered_map>
 #include <uuid/uuid.h>
 
@@ -86,7 +88,15 @@ std::vector<ScheduleNode::ConflictSet> get_conflicts(
         == rmf_traffic::schedule::ParticipantDescription::Rx::Unresponsive;
     };
 
+  // The bounds of each change get compared against every participant, so
+  // they are computed up front.
+  std::vector<rmf_traffic_ros2::schedule::RouteBounds> change_bounds;
+  for (const auto& vc : view_changes)
+    change_bounds.emplace_back(vc.description.profile(), *vc.route);
+
   std::vector<ScheduleNode::ConflictSet> conflicts;
+  std::vector<std::optional<rmf_traffic_ros2::schedule::RouteBounds>>
+  route_bounds;
   const auto& participants = viewer.participant_ids();
   for (const auto participant : participants)
   {
@@ -96,7 +106,12 @@ std::vector<ScheduleNode::ConflictSet> get_conflicts(
     if (!description)
       continue;
 
-    for (auto vc = view_changes.begin(); vc != view_changes.end(); ++vc)
+    // The bounds of the routes of this participant are only computed once a
+    // change on the same map needs them.
+    route_bounds.assign(itinerary.size(), std::nullopt);
+
+    std::size_t c = 0;
+    for (auto vc = view_changes.begin(); vc != view_changes.end(); ++vc, ++c)
     {
       if (vc->participant == participant)
       {
@@ -134,6 +149,13 @@ std::vector<ScheduleNode::ConflictSet> get_conflicts(
         if (dep_u)
           continue;
 
+        auto& bounds = route_bounds[r];
+        if (!bounds.has_value())
+          bounds.emplace(description->profile(), *route);
+
+        if (!bounds->might_conflict(change_bounds[c]))
+          continue;
+
         const auto found_conflict = rmf_traffic::DetectConflict::between(
           vc->description.profile(), vc->route->trajectory(), nullptr,
           description->profile(), route->trajectory(), nullptr);
@@ -167,10 +189,71 @@ ScheduleNode::ScheduleNode(
   heartbeat_period = std::chrono::milliseconds(
     get_parameter("heartbeat_period").as_int());
 
+  // Minimum period, in seconds, between two log summaries of the same
+  // negotiation. A period of zero summarizes every change.
+  declare_parameter<double>("negotiation_trace_period", 1.0);
+  negotiation_trace = std::make_unique<NegotiationTrace>(
+    get_logger(),
+    rmf_traffic::time::from_seconds(
+      get_parameter("negotiation_trace_period").as_double()));
+
+  // Period, in seconds, for refreshing the full negotiation states that are
+  // latched for late subscribers. Changes are still published right away on
+  // the negotiation state updates topic.
+  declare_parameter<double>("negotiation_states_period", 1.0);
+  negotiation_states_period = rmf_traffic::time::from_seconds(
+    get_parameter("negotiation_states_period").as_double());
+
+  // Time, in seconds, to keep collecting proposals after a negotiation first
+  // has one that it could choose, in case a better one arrives. Negotiations
+  // that cannot receive any more proposals conclude right away. A period of
+  // zero concludes every negotiation as soon as it is ready.
+  declare_parameter<double>("negotiation_grace_period", 0.1);
+  negotiation_grace_period = rmf_traffic::time::from_seconds(
+    get_parameter("negotiation_grace_period").as_double());
+
+  // Time, in seconds, that a negotiation may stay open before it is concluded
+  // with the best proposal it has, or forfeited if it has none. A deadline of
+  // zero lets negotiations stay open until they complete.
+  declare_parameter<double>("negotiation_deadline", 15.0);
+  const double deadline = get_parameter("negotiation_deadline").as_double();
+  if (deadline > 0.0)
+    negotiation_deadline = rmf_traffic::time::from_seconds(deadline);
+
+  // Time, in seconds, to keep collecting participant registrations before the
+  // participants are broadcast and the database is checkpointed. This lets a
+  // large fleet register in one batch. A period of zero handles every
+  // registration on its own.
+  declare_parameter<double>("registration_batch_period", 0.05);
+  registration_batch_period = rmf_traffic::time::from_seconds(
+    get_parameter("registration_batch_period").as_double());
+
   // Participant registry location
   declare_parameter<std::string>(
     "log_file_location", ".rmf_schedule_node.yaml");
 
+  // Directory for durable checkpoints of the schedule database. When this is
+  // empty, the schedule is not persisted and starts empty after a restart.
+  declare_parameter<std::string>("checkpoint_directory", "");
+
+  // Period, in seconds, between checkpoints of the schedule database. Every
+  // itinerary change in between checkpoints is logged as it happens.
+  declare_parameter<double>("checkpoint_period", 30.0);
+
+  // Period, in seconds, for handing the logged itinerary changes to the
+  // operating system. Changes that are logged in between are lost if the
+  // node dies. A period of zero hands over every change as soon as it is
+  // logged.
+  declare_parameter<double>("journal_flush_period", 0.1);
+
+  // Period, in seconds, for publishing performance statistics. A period of
+  // zero turns off publishing, but the statistics are still collected.
+  declare_parameter<double>("statistics_period", 10.0);
+
+  // If this is not empty, every window of statistics is also appended to this
+  // file as comma-separated values.
+  declare_parameter<std::string>("statistics_file", "");
+
   // TODO(MXG): Expose a parameter for the update period
   // TODO(MXG): We can probably do something smarter to decide when to update
   // than a simple wall timer
@@ -258,6 +341,10 @@ void ScheduleNode::setup(const QueryMap& queries)
   // Re-instantiate any query update topics based on received queries
   make_mirror_update_topics(queries);
 
+  // This needs to happen before the participant registry is created, because
+  // it might replace the database.
+  setup_journal();
+
   try
   {
     auto participant_logger = std::make_unique<YamlLogger>(log_file_name);
@@ -279,6 +366,10 @@ void ScheduleNode::setup(const QueryMap& queries)
     throw e;
   }
 
+  // Start the first generation of the journal now that the registry has
+  // loaded all the participants.
+  checkpoint();
+
   setup_redundancy();
   setup_query_services();
   setup_participant_services();
@@ -286,7 +377,9 @@ void ScheduleNode::setup(const QueryMap& queries)
   setup_itinerary_topics();
   setup_incosistency_pub();
   setup_conflict_topics_and_thread();
+  setup_negotiation_timer();
   setup_cull_timer();
+  setup_statistics();
 }
 
 //==============================================================================
@@ -463,6 +556,22 @@ void ScheduleNode::setup_conflict_topics_and_thread()
   // Initial conflict-free publication
   negotiation_states_pub->publish(NegotiationStates{});
 
+  negotiation_state_updates_pub = create_publisher<NegotiationStates>(
+    rmf_traffic_ros2::NegotiationStateUpdatesTopicName,
+    rclcpp::SystemDefaultsQoS().reliable().keep_last(100));
+
+  if (negotiation_states_period > rmf_traffic::Duration(0))
+  {
+    negotiation_states_timer = create_wall_timer(
+      negotiation_states_period,
+      [this]()
+      {
+        std::lock_guard<std::mutex> lock(active_conflicts_mutex);
+        if (negotiation_states_stale)
+          publish_full_negotiation_states();
+      });
+  }
+
   negotiation_stasuses_pub = create_publisher<NegotiationStatuses>(
     rmf_traffic_ros2::NegotiationStatusesTopicName,
     single_reliable_transient_local);
@@ -498,6 +607,14 @@ void ScheduleNode::setup_conflict_topics_and_thread()
             continue;
           }
 
+          const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
+          const auto mirror_version = mirror.latest_version().value_or(0);
+          if (mirror_version <= database->latest_version())
+          {
+            metrics.conflict_mirror_lag.record(
+              database->latest_version() - mirror_version);
+          }
+
           if (last_known_participants_version != current_participants_version)
           {
             last_known_participants_version = current_participants_version;
@@ -547,7 +664,12 @@ void ScheduleNode::setup_conflict_topics_and_thread()
           }
         }
 
-        auto conflicts = get_conflicts(view_changes, mirror);
+        std::vector<ConflictSet> conflicts;
+        {
+          const ScheduleMetrics::Timer timer(metrics.conflict_check_time);
+          conflicts = get_conflicts(view_changes, mirror);
+        }
+
         for (ConflictSet& conflict : conflicts)
         {
           // Collect all other participants that have dependencies on the ones
@@ -602,11 +724,14 @@ void ScheduleNode::setup_conflict_topics_and_thread()
 
         for (const auto& n : new_negotiations)
         {
-          std::cout << "Require negotiation for:";
+          std::string names;
           for (const auto p : n.second->participants())
-            std::cout << " " << p;
+            names += " " + std::to_string(p);
+
+          RCLCPP_INFO(
+            get_logger(), "Require negotiation [%lu] for:%s",
+            n.first, names.c_str());
 
-          std::cout << std::endl;
           ConflictNotice msg;
           msg.conflict_version = n.first;
 
@@ -615,6 +740,11 @@ void ScheduleNode::setup_conflict_topics_and_thread()
             participants.begin(), participants.end());
 
           conflict_notice_pub->publish(msg);
+        }
+
+        if (!new_negotiations.empty())
+        {
+          std::unique_lock<std::mutex> lock(active_conflicts_mutex);
           publish_negotiation_states();
         }
       }
@@ -628,6 +758,298 @@ void ScheduleNode::setup_cull_timer()
     std::chrono::minutes(1), [this]() { cull(); });
 }
 
+//==============================================================================
+void ScheduleNode::setup_negotiation_timer()
+{
+  if (negotiation_grace_period <= rmf_traffic::Duration(0)
+    && !negotiation_deadline.has_value())
+  {
+    return;
+  }
+
+  // Grace periods and deadlines are enforced with this resolution
+  negotiation_timer = create_wall_timer(
+    std::chrono::milliseconds(50), [this]() { check_negotiation_timing(); });
+}
+
+//==============================================================================
+void ScheduleNode::check_negotiation_timing()
+{
+  std::lock_guard<std::mutex> lock(active_conflicts_mutex);
+  const auto time = rmf_traffic_ros2::convert(now());
+
+  std::vector<Version> expired;
+  std::vector<Version> due;
+  for (auto& [version, open] : active_conflicts._negotiations)
+  {
+    if (!open.has_value())
+      continue;
+
+    if (negotiation_deadline.has_value()
+      && open->start_time + *negotiation_deadline <= time)
+    {
+      expired.push_back(version);
+      continue;
+    }
+
+    if (!open->ready_time.has_value())
+      continue;
+
+    if (!open->room.negotiation.ready())
+    {
+      // New participants have joined since the negotiation became ready, so
+      // it needs to wait for proposals from them.
+      open->ready_time = std::nullopt;
+      continue;
+    }
+
+    if (*open->ready_time + negotiation_grace_period <= time)
+      due.push_back(version);
+  }
+
+  for (const auto version : expired)
+  {
+    auto* open = active_conflicts.negotiation(version);
+    const auto participants = open->room.negotiation.participants().size();
+    RCLCPP_WARN(
+      get_logger(),
+      "Negotiation [%lu] with %lu participants reached its deadline of %f "
+      "seconds before it could complete",
+      version, participants,
+      rmf_traffic::time::to_seconds(*negotiation_deadline));
+
+    metrics.negotiation_deadline_participants.record(participants);
+    conclude_negotiation(version, *open, time);
+  }
+
+  for (const auto version : due)
+    conclude_negotiation(version, *active_conflicts.negotiation(version), time);
+
+  if (!expired.empty() || !due.empty())
+    publish_negotiation_states();
+}
+
+//==============================================================================
+void ScheduleNode::conclude_negotiation(
+  const Version conflict_version,
+  ConflictRecord::OpenNegotiation& open,
+  const rmf_traffic::Time time)
+{
+  auto& room = open.room;
+  auto& negotiation = room.negotiation;
+
+  ConflictConclusion conclusion;
+  conclusion.conflict_version = conflict_version;
+
+  std::string output;
+  if (negotiation.ready())
+  {
+    const auto choose =
+      negotiation.evaluate(rmf_traffic::schedule::QuickestFinishEvaluator());
+    assert(choose);
+
+    conclusion.resolved = true;
+    conclusion.table = rmf_traffic_ros2::convert(choose->sequence());
+
+    output = "Resolved negotiation [" + std::to_string(conflict_version) + "]:";
+    for (const auto p : conclusion.table)
+      output += " " + std::to_string(p.participant) + ":" + std::to_string(
+        p.version);
+
+    if (open.ready_time.has_value())
+      metrics.negotiation_grace_time.record(time - *open.ready_time);
+  }
+  else
+  {
+    // This implies a complete failure
+    conclusion.resolved = false;
+    output = "Forfeited negotiation [" + std::to_string(conflict_version) + "]";
+  }
+
+  RCLCPP_INFO(get_logger(), "%s", output.c_str());
+  metrics.negotiation_conclusion_time.record(time - open.start_time);
+
+  negotiation_trace->finish(conflict_version, room);
+  active_conflicts.conclude(conflict_version, time);
+
+  conflict_conclusion_pub->publish(std::move(conclusion));
+}
+
+//==============================================================================
+void ScheduleNode::setup_journal()
+{
+  std::string directory;
+  get_parameter_or<std::string>("checkpoint_directory", directory, "");
+  if (directory.empty())
+    return;
+
+  try
+  {
+    journal = std::make_unique<ScheduleJournal>(directory);
+
+    // Only a fresh database gets restored. A database that already has
+    // participants was forked from a mirror during a failover, so it is at
+    // least as new as anything in the journal.
+    if (database->participant_ids().empty())
+    {
+      const auto start = std::chrono::steady_clock::now();
+      if (const auto restored = journal->restore())
+      {
+        database = restored->database;
+        RCLCPP_INFO(
+          get_logger(),
+          "Restored schedule database to version [%lu] from checkpoint [%lu] "
+          "plus [%lu] logged changes in [%f] seconds",
+          database->latest_version(),
+          restored->generation,
+          restored->replayed,
+          rmf_traffic::time::to_seconds(
+            std::chrono::steady_clock::now() - start));
+
+        if (restored->failed > 0)
+        {
+          RCLCPP_WARN(
+            get_logger(),
+            "[%lu] logged changes could not be replayed onto the restored "
+            "schedule database",
+            restored->failed);
+        }
+      }
+    }
+  }
+  catch (const std::exception& e)
+  {
+    // Leave the files alone so that they can be inspected instead of
+    // overwriting them with new checkpoints.
+    RCLCPP_ERROR(
+      get_logger(),
+      "Failed to restore the schedule database from [%s], so it will not be "
+      "persisted: %s",
+      directory.c_str(),
+      e.what());
+    journal.reset();
+    return;
+  }
+
+  const double period = get_parameter("checkpoint_period").as_double();
+  checkpoint_timer = create_wall_timer(
+    std::chrono::duration<double>(period), [this]() { checkpoint(); });
+
+  const double flush_period =
+    get_parameter("journal_flush_period").as_double();
+  journal->flush_every_change(flush_period <= 0.0);
+  if (flush_period > 0.0)
+  {
+    journal_flush_timer = create_wall_timer(
+      std::chrono::duration<double>(flush_period),
+      [this]()
+      {
+        std::lock_guard<std::mutex> lock(database_mutex);
+        journal->flush();
+      });
+  }
+}
+
+//==============================================================================
+void ScheduleNode::checkpoint()
+{
+  if (!journal)
+    return;
+
+  std::optional<ScheduleJournal::Snapshot> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(database_mutex);
+    const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
+    if (last_checkpoint_version == database->latest_version())
+      return;
+
+    snapshot = snapshot_locked();
+  }
+
+  if (snapshot.has_value())
+    write_checkpoint(*snapshot);
+}
+
+//==============================================================================
+std::optional<ScheduleJournal::Snapshot> ScheduleNode::snapshot_locked()
+{
+  registration_checkpoint_pending = false;
+  if (!journal)
+    return std::nullopt;
+
+  last_checkpoint_version = database->latest_version();
+  return journal->snapshot(*database);
+}
+
+//==============================================================================
+void ScheduleNode::write_checkpoint(const ScheduleJournal::Snapshot& snapshot)
+{
+  try
+  {
+    journal->write(snapshot);
+  }
+  catch (const std::exception& e)
+  {
+    RCLCPP_ERROR(
+      get_logger(), "Failed to write schedule checkpoint: %s", e.what());
+  }
+}
+
+//==============================================================================
+void ScheduleNode::setup_statistics()
+{
+  const double period = get_parameter("statistics_period").as_double();
+  if (period <= 0.0)
+    return;
+
+  const auto file_name = get_parameter("statistics_file").as_string();
+  if (!file_name.empty())
+  {
+    const bool exists = std::filesystem::exists(file_name);
+    statistics_file.open(file_name, std::ios::app);
+    if (!statistics_file)
+    {
+      RCLCPP_ERROR(
+        get_logger(),
+        "Unable to open statistics file [%s]",
+        file_name.c_str());
+    }
+    else if (!exists)
+    {
+      statistics_file << ScheduleMetrics::csv_header() << std::endl;
+    }
+  }
+
+  statistics_pub = create_publisher<ScheduleMetrics::MetricsMessage>(
+    ScheduleStatisticsTopicName,
+    rclcpp::SystemDefaultsQoS().reliable());
+
+  statistics_window_start = now();
+  statistics_timer = create_wall_timer(
+    std::chrono::duration<double>(period),
+    [this]() { publish_statistics(); });
+}
+
+//==============================================================================
+void ScheduleNode::publish_statistics()
+{
+  {
+    std::lock_guard<std::mutex> lock(active_conflicts_mutex);
+    metrics.open_negotiations.record(active_conflicts._negotiations.size());
+  }
+
+  const auto window_stop = now();
+  const auto messages = metrics.take(
+    get_fully_qualified_name(),
+    statistics_window_start,
+    window_stop,
+    statistics_file.is_open() ? &statistics_file : nullptr);
+  statistics_window_start = window_stop;
+
+  for (const auto& msg : messages)
+    statistics_pub->publish(msg);
+}
+
 //==============================================================================
 void ScheduleNode::setup_redundancy()
 {
@@ -830,32 +1252,33 @@ void ScheduleNode::cleanup_queries()
 void ScheduleNode::cull()
 {
   const auto time = rmf_traffic_ros2::convert(now());
+  std::optional<ScheduleJournal::Snapshot> snapshot;
   {
     // Cull unnecessary data from the schedule
     std::lock_guard<std::mutex> lock(database_mutex);
+    const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
     database->set_current_time(time);
     database->cull(time - std::chrono::hours(2));
+
+    // Culls are not logged, so the journal needs a new generation after one
+    if (journal && last_checkpoint_version != database->latest_version())
+      snapshot = snapshot_locked();
   }
 
+  if (snapshot.has_value())
+    write_checkpoint(*snapshot);
+
   {
     // Break out of negotiation waits that have hung up
     std::lock_guard<std::mutex> lock(active_conflicts_mutex);
-    std::vector<std::size_t> cull_wait;
-    for (const auto& [v, wait] : active_conflicts._waiting)
-    {
-      if (wait.conclusion_time + std::chrono::seconds(30) > time)
-      {
-        cull_wait.push_back(v);
-      }
-    }
-
-    for (const auto c : cull_wait)
+    const auto cull_wait =
+      active_conflicts.cull_waiting(time, std::chrono::seconds(30));
+    for (const auto p : cull_wait)
     {
       RCLCPP_WARN(
         get_logger(),
-        "Forcibly ending the wait period for negotiation [%lu] because it has "
-        "timed out.", c);
-      active_conflicts._waiting.erase(c);
+        "Forcibly ending the wait period of participant [%lu] because it has "
+        "timed out.", p);
     }
 
     std::vector<uint64_t> cull_negotiation;
@@ -863,8 +1286,9 @@ void ScheduleNode::cull()
     {
       if (open.has_value())
       {
-        // TODO(MXG): Make this deadline configurable
-        if (open->last_active_time + std::chrono::seconds(30) > time)
+        // Negotiations that nobody has spoken in for a long time are culled
+        // even when negotiation_deadline is turned off.
+        if (open->last_active_time + std::chrono::seconds(30) < time)
         {
           cull_negotiation.push_back(v);
         }
@@ -914,44 +1338,95 @@ void ScheduleNode::register_participant(
   const RegisterParticipant::Request::SharedPtr& request,
   const RegisterParticipant::Response::SharedPtr& response)
 {
-  std::unique_lock<std::mutex> lock(database_mutex);
-
-  // TODO(MXG): Use try on every database operation
-  try
+  std::optional<ScheduleJournal::Snapshot> snapshot;
   {
-    const auto registration = participant_registry
-      ->add_or_retrieve_participant(
-      rmf_traffic_ros2::convert(request->description));
+    std::unique_lock<std::mutex> lock(database_mutex);
+    const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
 
-    using Response = rmf_traffic_msgs::srv::RegisterParticipant::Response;
+    // TODO(MXG): Use try on every database operation
+    try
+    {
+      const auto registration = participant_registry
+        ->add_or_retrieve_participant(
+        rmf_traffic_ros2::convert(request->description));
 
-    *response =
-      rmf_traffic_msgs::build<Response>()
-      .participant_id(registration.id())
-      .last_itinerary_version(registration.last_itinerary_version())
-      .last_plan_id(registration.last_plan_id())
-      .next_storage_base(registration.next_storage_base())
-      .error("");
+      using Response = rmf_traffic_msgs::srv::RegisterParticipant::Response;
 
-    RCLCPP_INFO(
-      get_logger(),
-      "Registered participant [%ld] named [%s] owned by [%s]",
-      response->participant_id,
-      request->description.name.c_str(),
-      request->description.owner.c_str());
+      *response =
+        rmf_traffic_msgs::build<Response>()
+        .participant_id(registration.id())
+        .last_itinerary_version(registration.last_itinerary_version())
+        .last_plan_id(registration.last_plan_id())
+        .next_storage_base(registration.next_storage_base())
+        .error("");
 
-    broadcast_participants();
-  }
-  catch (const std::exception& e)
-  {
-    RCLCPP_ERROR(
-      get_logger(),
-      "Failed to register participant [%s] owned by [%s]: %s",
-      request->description.name.c_str(),
-      request->description.owner.c_str(),
-      e.what());
-    response->error = e.what();
+      RCLCPP_INFO(
+        get_logger(),
+        "Registered participant [%ld] named [%s] owned by [%s]",
+        response->participant_id,
+        request->description.name.c_str(),
+        request->description.owner.c_str());
+
+      // Registrations are not logged, so the journal needs a new generation.
+      // The conflict checker needs to know about the participant right away,
+      // but the rest can wait for the other registrations of this batch.
+      registration_checkpoint_pending = true;
+      ++current_participants_version;
+      if (registration_batch_period > rmf_traffic::Duration(0))
+        schedule_registration_flush();
+      else
+        snapshot = flush_registrations_locked();
+    }
+    catch (const std::exception& e)
+    {
+      RCLCPP_ERROR(
+        get_logger(),
+        "Failed to register participant [%s] owned by [%s]: %s",
+        request->description.name.c_str(),
+        request->description.owner.c_str(),
+        e.what());
+      response->error = e.what();
+    }
   }
+
+  if (snapshot.has_value())
+    write_checkpoint(*snapshot);
+}
+
+//==============================================================================
+void ScheduleNode::schedule_registration_flush()
+{
+  if (registration_timer)
+    return;
+
+  registration_timer = create_wall_timer(
+    registration_batch_period,
+    [this]()
+    {
+      std::optional<ScheduleJournal::Snapshot> snapshot;
+      {
+        std::lock_guard<std::mutex> lock(database_mutex);
+        const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
+        registration_timer->cancel();
+        registration_timer.reset();
+        snapshot = flush_registrations_locked();
+      }
+
+      if (snapshot.has_value())
+        write_checkpoint(*snapshot);
+    });
+}
+
+//==============================================================================
+std::optional<ScheduleJournal::Snapshot>
+ScheduleNode::flush_registrations_locked()
+{
+  broadcast_participants();
+
+  if (!registration_checkpoint_pending)
+    return std::nullopt;
+
+  return snapshot_locked();
 }
 
 //==============================================================================
@@ -961,6 +1436,7 @@ void ScheduleNode::unregister_participant(
   const UnregisterParticipant::Response::SharedPtr& response)
 {
   std::unique_lock<std::mutex> lock(database_mutex);
+  const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
 
   const auto& p = database->get_participant(request->participant_id);
   if (!p)
@@ -986,6 +1462,14 @@ void ScheduleNode::unregister_participant(
     database->clear(request->participant_id, version);
     response->confirmation = true;
 
+    if (journal)
+    {
+      ItineraryClear clear;
+      clear.participant = request->participant_id;
+      clear.itinerary_version = version;
+      log_to_journal(clear);
+    }
+
     RCLCPP_INFO(
       get_logger(),
       "Unregistered participant [%ld] named [%s] owned by [%s]",
@@ -1088,7 +1572,9 @@ void ScheduleNode::request_changes(
 //==============================================================================
 void ScheduleNode::itinerary_set(const ItinerarySet& set)
 {
+  metrics.itinerary_changes.record(1);
   std::unique_lock<std::mutex> lock(database_mutex);
+  const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
   assert(!set.itinerary.empty());
   try
   {
@@ -1099,6 +1585,8 @@ void ScheduleNode::itinerary_set(const ItinerarySet& set)
       set.storage_base,
       set.itinerary_version);
 
+    log_to_journal(set);
+
     publish_inconsistencies(set.participant);
 
     std::lock_guard<std::mutex> lock2(active_conflicts_mutex);
@@ -1113,7 +1601,9 @@ void ScheduleNode::itinerary_set(const ItinerarySet& set)
 //==============================================================================
 void ScheduleNode::itinerary_extend(const ItineraryExtend& extend)
 {
+  metrics.itinerary_changes.record(1);
   std::unique_lock<std::mutex> lock(database_mutex);
+  const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
   try
   {
     database->extend(
@@ -1121,6 +1611,8 @@ void ScheduleNode::itinerary_extend(const ItineraryExtend& extend)
       rmf_traffic_ros2::convert(extend.routes),
       extend.itinerary_version);
 
+    log_to_journal(extend);
+
     publish_inconsistencies(extend.participant);
 
     std::lock_guard<std::mutex> lock2(active_conflicts_mutex);
@@ -1136,7 +1628,9 @@ void ScheduleNode::itinerary_extend(const ItineraryExtend& extend)
 //==============================================================================
 void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
 {
+  metrics.itinerary_changes.record(1);
   std::unique_lock<std::mutex> lock(database_mutex);
+  const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
   const auto duration = rmf_traffic::Duration(delay.delay);
 
   static const auto delay_limit = std::chrono::hours(1);
@@ -1181,6 +1675,8 @@ void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
       duration,
       delay.itinerary_version);
 
+    log_to_journal(delay);
+
     publish_inconsistencies(delay.participant);
 
     std::lock_guard<std::mutex> lock2(active_conflicts_mutex);
@@ -1196,7 +1692,9 @@ void ScheduleNode::itinerary_delay(const ItineraryDelay& delay)
 //==============================================================================
 void ScheduleNode::itinerary_reached(const ItineraryReached& msg)
 {
+  metrics.itinerary_changes.record(1);
   std::unique_lock<std::mutex> lock(database_mutex);
+  const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
   try
   {
     database->reached(
@@ -1205,6 +1703,8 @@ void ScheduleNode::itinerary_reached(const ItineraryReached& msg)
       msg.reached_checkpoints,
       msg.progress_version);
 
+    log_to_journal(msg);
+
     // There is no risk of inconsistencies or conflicts occurring due to new
     // progress being reported, so we do not need to check for either.
   }
@@ -1218,11 +1718,15 @@ void ScheduleNode::itinerary_reached(const ItineraryReached& msg)
 //==============================================================================
 void ScheduleNode::itinerary_clear(const ItineraryClear& clear)
 {
+  metrics.itinerary_changes.record(1);
   std::unique_lock<std::mutex> lock(database_mutex);
+  const ScheduleMetrics::Timer lock_timer(metrics.database_lock_time);
   try
   {
     database->clear(clear.participant, clear.itinerary_version);
 
+    log_to_journal(clear);
+
     publish_inconsistencies(clear.participant);
 
     std::lock_guard<std::mutex> lock2(active_conflicts_mutex);
@@ -1359,6 +1863,13 @@ bool ScheduleNode::update_query(
   msg.is_remedial_update = is_remedial;
   publisher->publish(msg);
 
+  std::size_t routes = 0;
+  for (const auto& p : patch)
+    routes += p.additions().items().size();
+
+  metrics.mirror_update_routes.record(routes);
+  metrics.mirror_update_participants.record(patch.size());
+
   return true;
 }
 
@@ -1444,6 +1955,7 @@ void ScheduleNode::refuse(std::size_t conflict_version)
     + std::to_string(conflict_version) + "]";
   RCLCPP_INFO(get_logger(), "%s", output.c_str());
 
+  negotiation_trace->finish(conflict_version, negotiation_room->room);
   active_conflicts.refuse(conflict_version);
 
   ConflictConclusion conclusion;
@@ -1484,7 +1996,7 @@ void ScheduleNode::receive_proposal(const ConflictProposal& msg)
     error += "]";
 
     RCLCPP_WARN(get_logger(), "%s", error.c_str());
-    room.cached_proposals.push_back(msg);
+    room.cache(msg);
     return;
   }
 
@@ -1493,57 +2005,31 @@ void ScheduleNode::receive_proposal(const ConflictProposal& msg)
     rmf_traffic_ros2::convert(msg.itinerary),
     msg.proposal_version);
 
-  room.check_cache({});
+  room.check_cache({}, table);
 
-  // TODO(MXG): This should be removed once we have a negotiation visualizer
-  rmf_traffic_ros2::schedule::print_negotiation_status(
-    msg.conflict_version,
-    negotiation);
-  open->update_state_msg(msg.conflict_version);
+  negotiation_trace->record(
+    msg.conflict_version, room, open->update_state_msg(msg.conflict_version));
 
   if (negotiation.ready())
   {
-    // TODO(MXG): If the negotiation is not complete yet, give some time for
-    // more proposals to arrive before choosing one.
-    const auto choose =
-      negotiation.evaluate(rmf_traffic::schedule::QuickestFinishEvaluator());
-    assert(choose);
-
-    active_conflicts.conclude(
-      msg.conflict_version, rmf_traffic_ros2::convert(now()));
-
-    ConflictConclusion conclusion;
-    conclusion.conflict_version = msg.conflict_version;
-    conclusion.resolved = true;
-    conclusion.table = rmf_traffic_ros2::convert(choose->sequence());
-
-    std::string output = "Resolved negotiation ["
-      + std::to_string(msg.conflict_version) + "]:";
-
-    for (const auto p : conclusion.table)
-      output += " " + std::to_string(p.participant) + ":" + std::to_string(
-        p.version);
-    RCLCPP_INFO(get_logger(), "%s", output.c_str());
-
-    conflict_conclusion_pub->publish(std::move(conclusion));
-//    print_conclusion(active_conflicts._waiting);
+    // Once every table has either finished or forfeited, there is nothing
+    // left to wait for. Otherwise give more proposals some time to arrive
+    // before choosing one.
+    const auto time = rmf_traffic_ros2::convert(now());
+    if (negotiation.complete()
+      || negotiation_grace_period <= rmf_traffic::Duration(0))
+    {
+      conclude_negotiation(msg.conflict_version, *open, time);
+    }
+    else if (!open->ready_time.has_value())
+    {
+      open->ready_time = time;
+    }
   }
   else if (negotiation.complete())
   {
-    std::string output = "Forfeited negotiation ["
-      + std::to_string(msg.conflict_version) + "]";
-    RCLCPP_INFO(get_logger(), "%s", output.c_str());
-
-    active_conflicts.conclude(
-      msg.conflict_version, rmf_traffic_ros2::convert(now()));
-
-    // This implies a complete failure
-    ConflictConclusion conclusion;
-    conclusion.conflict_version = msg.conflict_version;
-    conclusion.resolved = false;
-
-    conflict_conclusion_pub->publish(conclusion);
-//    print_conclusion(active_conflicts._waiting);
+    conclude_negotiation(
+      msg.conflict_version, *open, rmf_traffic_ros2::convert(now()));
   }
 
   publish_negotiation_states();
@@ -1577,7 +2063,7 @@ void ScheduleNode::receive_rejection(const ConflictRejection& msg)
     error += "]";
 
     RCLCPP_WARN(get_logger(), "%s", error.c_str());
-    room.cached_rejections.push_back(msg);
+    room.cache(msg);
     return;
   }
 
@@ -1586,13 +2072,10 @@ void ScheduleNode::receive_rejection(const ConflictRejection& msg)
     msg.rejected_by,
     rmf_traffic_ros2::convert(msg.alternatives));
 
-  room.check_cache({});
+  room.check_cache({}, table);
 
-  // TODO(MXG): This should be removed once we have a negotiation visualizer
-  rmf_traffic_ros2::schedule::print_negotiation_status(
-    msg.conflict_version,
-    negotiation);
-  open->update_state_msg(msg.conflict_version);
+  negotiation_trace->record(
+    msg.conflict_version, room, open->update_state_msg(msg.conflict_version));
 
   publish_negotiation_states();
 }
@@ -1625,34 +2108,22 @@ void ScheduleNode::receive_forfeit(const ConflictForfeit& msg)
     error += "]";
 
     RCLCPP_WARN(get_logger(), "%s", error.c_str());
-    room.cached_forfeits.push_back(msg);
+    room.cache(msg);
     return;
   }
 
   table->forfeit(msg.table.back().version);
-  room.check_cache({});
+  room.check_cache({}, table);
 
-  // TODO(MXG): This should be removed once we have a negotiation visualizer
-  rmf_traffic_ros2::schedule::print_negotiation_status(
-    msg.conflict_version,
-    negotiation);
-  open->update_state_msg(msg.conflict_version);
+  negotiation_trace->record(
+    msg.conflict_version, room, open->update_state_msg(msg.conflict_version));
 
   if (negotiation.complete())
   {
-    std::string output = "Forfeited negotiation ["
-      + std::to_string(msg.conflict_version) + "]";
-    RCLCPP_INFO(get_logger(), "%s", output.c_str());
-
-    active_conflicts.conclude(
-      msg.conflict_version, rmf_traffic_ros2::convert(now()));
-
-    ConflictConclusion conclusion;
-    conclusion.conflict_version = msg.conflict_version;
-    conclusion.resolved = false;
-
-    conflict_conclusion_pub->publish(conclusion);
-//    print_conclusion(active_conflicts._waiting);
+    // If the negotiation was ready and waiting for more proposals, this was
+    // the last table it was waiting on, so its best proposal can be chosen.
+    conclude_negotiation(
+      msg.conflict_version, *open, rmf_traffic_ros2::convert(now()));
   }
 
   publish_negotiation_states();
@@ -1661,19 +2132,49 @@ void ScheduleNode::receive_forfeit(const ConflictForfeit& msg)
 //==============================================================================
 void ScheduleNode::publish_negotiation_states()
 {
+  // Only the negotiations that changed since the last publication are sent out
+  // right away. The full states are refreshed by the negotiation states timer.
+  // The statuses are small, so all of them are always sent so that subscribers
+  // can tell which negotiations are still open.
   NegotiationStates states;
   NegotiationStatuses statuses;
+  for (auto& [_, n_opt] : active_conflicts._negotiations)
+  {
+    if (!n_opt.has_value())
+      continue;
+
+    auto& room = n_opt->room;
+    if (room.state_changed)
+    {
+      states.negotiations.push_back(room.state_msg);
+      room.state_changed = false;
+    }
+
+    statuses.negotiations.push_back(room.state_msg.status);
+  }
+
+  if (!states.negotiations.empty())
+    negotiation_state_updates_pub->publish(states);
+
+  negotiation_stasuses_pub->publish(statuses);
+
+  negotiation_states_stale = true;
+  if (!negotiation_states_timer)
+    publish_full_negotiation_states();
+}
+
+//==============================================================================
+void ScheduleNode::publish_full_negotiation_states()
+{
+  NegotiationStates states;
   for (const auto& [_, n_opt] : active_conflicts._negotiations)
   {
     if (n_opt.has_value())
-    {
       states.negotiations.push_back(n_opt->room.state_msg);
-      statuses.negotiations.push_back(n_opt->room.state_msg.status);
-    }
   }
 
   negotiation_states_pub->publish(states);
-  negotiation_stasuses_pub->publish(statuses);
+  negotiation_states_stale = false;
 }
 
 std::shared_ptr<rclcpp::Node> make_node(const rclcpp::NodeOptions& options)
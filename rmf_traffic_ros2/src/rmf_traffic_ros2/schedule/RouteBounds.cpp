@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic_ros2/schedule/RouteBounds.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+namespace {
+//==============================================================================
+double radius(const rmf_traffic::geometry::ConstFinalConvexShapePtr& shape)
+{
+  if (!shape)
+    return 0.0;
+
+  return shape->get_characteristic_length();
+}
+
+//==============================================================================
+// Between two waypoints, the trajectory is a cubic Hermite spline. Its
+// position is a blend of the two endpoints plus a term for each endpoint
+// velocity whose weight never exceeds 4/27 of the segment duration, so this is
+// the furthest the spline can stray outside the box of its endpoints.
+Eigen::Vector2d spline_slack(
+  const rmf_traffic::Trajectory::Waypoint& from,
+  const rmf_traffic::Trajectory::Waypoint& to)
+{
+  const double dt = rmf_traffic::time::to_seconds(to.time() - from.time());
+  const Eigen::Vector2d v0 = from.velocity().block<2, 1>(0, 0);
+  const Eigen::Vector2d v1 = to.velocity().block<2, 1>(0, 0);
+  return 4.0/27.0 * std::abs(dt) * (v0.cwiseAbs() + v1.cwiseAbs());
+}
+} // anonymous namespace
+
+//==============================================================================
+RouteBounds::RouteBounds(
+  const rmf_traffic::Profile& profile,
+  const rmf_traffic::Route& route)
+: _map(route.map())
+{
+  const auto& trajectory = route.trajectory();
+  if (trajectory.size() < 2)
+    return;
+
+  const rmf_traffic::Trajectory::Waypoint* previous = nullptr;
+  for (const auto& wp : trajectory)
+  {
+    const Eigen::Vector2d p = wp.position().block<2, 1>(0, 0);
+    if (!previous)
+    {
+      _min = p;
+      _max = p;
+      previous = &wp;
+      continue;
+    }
+
+    const Eigen::Vector2d slack = spline_slack(*previous, wp);
+    const Eigen::Vector2d p0 = previous->position().block<2, 1>(0, 0);
+    _min = _min.cwiseMin(p0.cwiseMin(p) - slack);
+    _max = _max.cwiseMax(p0.cwiseMax(p) + slack);
+    previous = &wp;
+  }
+
+  // Conflicts are detected between the footprint of each participant and the
+  // vicinity of the other, so growing each box by the larger of the two is
+  // enough to cover both directions.
+  const double r = std::max(
+    radius(profile.footprint()), radius(profile.vicinity()));
+  _min -= Eigen::Vector2d::Constant(r);
+  _max += Eigen::Vector2d::Constant(r);
+
+  _start = *trajectory.start_time();
+  _finish = *trajectory.finish_time();
+  _bounded = true;
+}
+
+//==============================================================================
+bool RouteBounds::might_conflict(const RouteBounds& other) const
+{
+  if (_map != other._map)
+    return false;
+
+  if (!_bounded || !other._bounded)
+    return true;
+
+  if (_finish < other._start || other._finish < _start)
+    return false;
+
+  return (_min.array() <= other._max.array()).all()
+    && (other._min.array() <= _max.array()).all();
+}
+
+//==============================================================================
+const std::string& RouteBounds::map() const
+{
+  return _map;
+}
+
+//==============================================================================
+bool RouteBounds::bounded() const
+{
+  return _bounded;
+}
+
+//==============================================================================
+const Eigen::Vector2d& RouteBounds::min() const
+{
+  return _min;
+}
+
+//==============================================================================
+const Eigen::Vector2d& RouteBounds::max() const
+{
+  return _max;
+}
+
+//==============================================================================
+rmf_traffic::Time RouteBounds::start_time() const
+{
+  return _start;
+}
+
+//==============================================================================
+rmf_traffic::Time RouteBounds::finish_time() const
+{
+  return _finish;
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ScheduleJournal.hpp"
+
+#include <rmf_traffic_ros2/Route.hpp>
+#include <rmf_traffic_ros2/schedule/ParticipantDescription.hpp>
+#include <rmf_traffic_ros2/schedule/Patch.hpp>
+
+#include <rmf_traffic/schedule/Mirror.hpp>
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <set>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+namespace {
+//==============================================================================
+constexpr char CheckpointMagic[] = {'R', 'M', 'F', 'S', 'C', 'H', 'K', '1'};
+const std::string CheckpointPrefix = "checkpoint_";
+const std::string LogPrefix = "log_";
+const std::string Extension = ".bin";
+
+//==============================================================================
+std::optional<std::size_t> parse_generation(
+  const std::filesystem::path& path,
+  const std::string& prefix)
+{
+  if (path.extension() != Extension)
+    return std::nullopt;
+
+  const std::string stem = path.stem().string();
+  if (stem.rfind(prefix, 0) != 0)
+    return std::nullopt;
+
+  const std::string number = stem.substr(prefix.size());
+  if (number.empty())
+    return std::nullopt;
+
+  for (const char c : number)
+  {
+    if (!std::isdigit(static_cast<unsigned char>(c)))
+      return std::nullopt;
+  }
+
+  return std::stoull(number);
+}
+
+//==============================================================================
+template<typename Msg>
+void write_record(std::ostream& out, const Msg& msg)
+{
+  static const rclcpp::Serialization<Msg> serializer;
+  rclcpp::SerializedMessage serialized;
+  serializer.serialize_message(&msg, &serialized);
+
+  const auto& raw = serialized.get_rcl_serialized_message();
+  const uint32_t length = static_cast<uint32_t>(raw.buffer_length);
+  out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  out.write(reinterpret_cast<const char*>(raw.buffer), length);
+}
+
+//==============================================================================
+/// Returns false if the stream ended before a whole record could be read,
+/// which is what a log looks like if the process died while writing to it.
+template<typename Msg>
+bool read_record(std::istream& in, Msg& msg)
+{
+  uint32_t length = 0;
+  if (!in.read(reinterpret_cast<char*>(&length), sizeof(length)))
+    return false;
+
+  rclcpp::SerializedMessage serialized(length);
+  auto& raw = serialized.get_rcl_serialized_message();
+  if (!in.read(reinterpret_cast<char*>(raw.buffer), length))
+    return false;
+
+  raw.buffer_length = length;
+
+  static const rclcpp::Serialization<Msg> serializer;
+  serializer.deserialize_message(&serialized, &msg);
+  return true;
+}
+
+//==============================================================================
+void apply(
+  rmf_traffic::schedule::Database& database,
+  const ScheduleJournal::ItinerarySet& set)
+{
+  database.set(
+    set.participant,
+    set.plan,
+    rmf_traffic_ros2::convert(set.itinerary),
+    set.storage_base,
+    set.itinerary_version);
+}
+
+//==============================================================================
+void apply(
+  rmf_traffic::schedule::Database& database,
+  const ScheduleJournal::ItineraryExtend& extend)
+{
+  database.extend(
+    extend.participant,
+    rmf_traffic_ros2::convert(extend.routes),
+    extend.itinerary_version);
+}
+
+//==============================================================================
+void apply(
+  rmf_traffic::schedule::Database& database,
+  const ScheduleJournal::ItineraryDelay& delay)
+{
+  database.delay(
+    delay.participant,
+    rmf_traffic::Duration(delay.delay),
+    delay.itinerary_version);
+}
+
+//==============================================================================
+void apply(
+  rmf_traffic::schedule::Database& database,
+  const ScheduleJournal::ItineraryReached& reached)
+{
+  database.reached(
+    reached.participant,
+    reached.plan,
+    reached.reached_checkpoints,
+    reached.progress_version);
+}
+
+//==============================================================================
+void apply(
+  rmf_traffic::schedule::Database& database,
+  const ScheduleJournal::ItineraryClear& clear)
+{
+  database.clear(clear.participant, clear.itinerary_version);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+ScheduleJournal::ScheduleJournal(std::filesystem::path directory)
+: _directory(std::move(directory))
+{
+  std::filesystem::create_directories(_directory);
+
+  for (const auto& file : std::filesystem::directory_iterator(_directory))
+  {
+    if (const auto g = parse_generation(file.path(), CheckpointPrefix))
+    {
+      _generation = std::max(_generation, *g);
+      _last_written = std::max(_last_written, *g);
+    }
+    else if (const auto g = parse_generation(file.path(), LogPrefix))
+    {
+      _generation = std::max(_generation, *g);
+    }
+  }
+}
+
+//==============================================================================
+auto ScheduleJournal::restore() -> std::optional<Restored>
+{
+  std::optional<std::size_t> latest;
+  std::set<std::size_t> logs;
+  for (const auto& file : std::filesystem::directory_iterator(_directory))
+  {
+    if (const auto g = parse_generation(file.path(), CheckpointPrefix))
+    {
+      if (!latest.has_value() || *latest < *g)
+        latest = *g;
+    }
+    else if (const auto g = parse_generation(file.path(), LogPrefix))
+    {
+      logs.insert(*g);
+    }
+  }
+
+  if (!latest.has_value())
+    return std::nullopt;
+
+  const auto path = _checkpoint_path(*latest);
+  std::ifstream in(path, std::ios::binary);
+  char magic[sizeof(CheckpointMagic)];
+  if (!in.read(magic, sizeof(magic))
+    || std::memcmp(magic, CheckpointMagic, sizeof(magic)) != 0)
+  {
+    throw std::runtime_error(
+            "[" + path.string() + "] is not a schedule checkpoint");
+  }
+
+  rmf_traffic_msgs::msg::Participants participants;
+  rmf_traffic_msgs::msg::SchedulePatch patch;
+  if (!read_record(in, participants) || !read_record(in, patch))
+  {
+    throw std::runtime_error(
+            "Schedule checkpoint [" + path.string() + "] is truncated");
+  }
+
+  // A mirror is able to fork a database that continues from exactly the same
+  // version as the patch, just like a monitor node does during failover.
+  rmf_traffic::schedule::Mirror mirror;
+  mirror.update_participants_info(rmf_traffic_ros2::convert(participants));
+  if (!mirror.update(rmf_traffic_ros2::convert(patch)))
+  {
+    throw std::runtime_error(
+            "Schedule checkpoint [" + path.string() + "] is inconsistent");
+  }
+
+  Restored restored{
+    std::make_shared<Database>(mirror.fork()),
+    *latest,
+    0,
+    0
+  };
+
+  // If the process died between starting a new generation and finishing its
+  // checkpoint, the changes are split across the logs of both generations.
+  for (const auto g : logs)
+  {
+    if (g >= *latest)
+      _replay(_log_path(g), *restored.database, restored);
+  }
+
+  return restored;
+}
+
+//==============================================================================
+auto ScheduleJournal::snapshot(const Database& database) -> Snapshot
+{
+  Snapshot snapshot;
+  snapshot.generation = ++_generation;
+
+  rmf_traffic::schedule::ParticipantDescriptionsMap participants;
+  for (const auto id : database.participant_ids())
+    participants.insert({id, *database.get_participant(id)});
+
+  snapshot.participants = rmf_traffic_ros2::convert(participants);
+  snapshot.patch = rmf_traffic_ros2::convert(
+    database.changes(rmf_traffic::schedule::query_all(), std::nullopt));
+
+  // Any changes after this point belong to the new generation. Replacing the
+  // stream closes the old log, which flushes whatever is left in it.
+  _log_file = std::ofstream(
+    _log_path(snapshot.generation), std::ios::binary | std::ios::trunc);
+  _unflushed = false;
+
+  return snapshot;
+}
+
+//==============================================================================
+void ScheduleJournal::write(const Snapshot& snapshot)
+{
+  std::lock_guard<std::mutex> lock(_write_mutex);
+  if (snapshot.generation <= _last_written)
+  {
+    // A newer checkpoint has already been written
+    return;
+  }
+
+  const auto path = _checkpoint_path(snapshot.generation);
+  auto temp_path = path;
+  temp_path += ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(CheckpointMagic, sizeof(CheckpointMagic));
+    write_record(out, snapshot.participants);
+    write_record(out, snapshot.patch);
+    out.flush();
+    if (!out)
+    {
+      throw std::runtime_error(
+              "Failed to write schedule checkpoint [" + temp_path.string()
+              + "]");
+    }
+  }
+
+  // Renaming is atomic, so a checkpoint file is always complete
+  std::filesystem::rename(temp_path, path);
+  _last_written = snapshot.generation;
+
+  for (const auto& file : std::filesystem::directory_iterator(_directory))
+  {
+    auto g = parse_generation(file.path(), CheckpointPrefix);
+    if (!g.has_value())
+      g = parse_generation(file.path(), LogPrefix);
+
+    if (g.has_value() && *g < snapshot.generation)
+    {
+      std::error_code ec;
+      std::filesystem::remove(file.path(), ec);
+    }
+  }
+}
+
+//==============================================================================
+template<typename Msg>
+void ScheduleJournal::_log(const Entry entry, const Msg& msg)
+{
+  if (!_log_file.is_open())
+    return;
+
+  const auto raw_entry = static_cast<uint8_t>(entry);
+  _log_file.write(reinterpret_cast<const char*>(&raw_entry), sizeof(raw_entry));
+  write_record(_log_file, msg);
+
+  _unflushed = true;
+  if (_flush_every_change)
+    flush();
+}
+
+//==============================================================================
+void ScheduleJournal::flush()
+{
+  if (!_unflushed)
+    return;
+
+  _log_file.flush();
+  _unflushed = false;
+}
+
+//==============================================================================
+void ScheduleJournal::flush_every_change(const bool value)
+{
+  _flush_every_change = value;
+}
+
+//==============================================================================
+void ScheduleJournal::log(const ItinerarySet& msg)
+{
+  _log(Entry::Set, msg);
+}
+
+//==============================================================================
+void ScheduleJournal::log(const ItineraryExtend& msg)
+{
+  _log(Entry::Extend, msg);
+}
+
+//==============================================================================
+void ScheduleJournal::log(const ItineraryDelay& msg)
+{
+  _log(Entry::Delay, msg);
+}
+
+//==============================================================================
+void ScheduleJournal::log(const ItineraryReached& msg)
+{
+  _log(Entry::Reached, msg);
+}
+
+//==============================================================================
+void ScheduleJournal::log(const ItineraryClear& msg)
+{
+  _log(Entry::Clear, msg);
+}
+
+//==============================================================================
+const std::filesystem::path& ScheduleJournal::directory() const
+{
+  return _directory;
+}
+
+//==============================================================================
+template<typename Msg>
+bool ScheduleJournal::_replay_entry(
+  std::istream& in,
+  Database& database,
+  Restored& restored)
+{
+  Msg msg;
+  if (!read_record(in, msg))
+    return false;
+
+  try
+  {
+    apply(database, msg);
+    ++restored.replayed;
+  }
+  catch (const std::exception&)
+  {
+    // The live database would have rejected this change too, but then it would
+    // not have been logged, so this can only happen for a damaged log.
+    ++restored.failed;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void ScheduleJournal::_replay(
+  const std::filesystem::path& path,
+  Database& database,
+  Restored& restored)
+{
+  std::ifstream in(path, std::ios::binary);
+  uint8_t raw_entry = 0;
+  while (in.read(reinterpret_cast<char*>(&raw_entry), sizeof(raw_entry)))
+  {
+    bool complete = false;
+    switch (static_cast<Entry>(raw_entry))
+    {
+      case Entry::Set:
+        complete = _replay_entry<ItinerarySet>(in, database, restored);
+        break;
+      case Entry::Extend:
+        complete = _replay_entry<ItineraryExtend>(in, database, restored);
+        break;
+      case Entry::Delay:
+        complete = _replay_entry<ItineraryDelay>(in, database, restored);
+        break;
+      case Entry::Reached:
+        complete = _replay_entry<ItineraryReached>(in, database, restored);
+        break;
+      case Entry::Clear:
+        complete = _replay_entry<ItineraryClear>(in, database, restored);
+        break;
+    }
+
+    if (!complete)
+    {
+      // Either the last entry was only partly written or the entry type is
+      // unknown. Nothing after this point can be trusted.
+      break;
+    }
+  }
+}
+
+//==============================================================================
+std::filesystem::path ScheduleJournal::_checkpoint_path(
+  const std::size_t generation) const
+{
+  return _directory / (CheckpointPrefix + std::to_string(generation)
+    + Extension);
+}
+
+//==============================================================================
+std::filesystem::path ScheduleJournal::_log_path(
+  const std::size_t generation) const
+{
+  return _directory / (LogPrefix + std::to_string(generation) + Extension);
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
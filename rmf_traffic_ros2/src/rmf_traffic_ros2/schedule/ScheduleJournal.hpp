@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__SCHEDULEJOURNAL_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__SCHEDULEJOURNAL_HPP
+
+#include <rmf_traffic/schedule/Database.hpp>
+
+#include <rmf_traffic_msgs/msg/itinerary_clear.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_delay.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_extend.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_reached.hpp>
+#include <rmf_traffic_msgs/msg/itinerary_set.hpp>
+#include <rmf_traffic_msgs/msg/participants.hpp>
+#include <rmf_traffic_msgs/msg/schedule_patch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// Keeps a durable copy of a schedule database on disk so that a schedule node
+/// can be restored after a restart without waiting for every participant to
+/// send its itinerary again.
+///
+/// The journal consists of binary checkpoints of the whole database plus a
+/// write-ahead log of the itinerary changes that were applied after each
+/// checkpoint. Every checkpoint starts a new generation of the log. Restoring
+/// loads the latest complete checkpoint and replays every log from that
+/// generation onwards, which reproduces the exact schedule versions that
+/// mirrors have already seen.
+///
+/// Changes that are not itinerary changes, like registering participants or
+/// culling, are not logged. A new checkpoint must be made after them.
+class ScheduleJournal
+{
+public:
+
+  using Database = rmf_traffic::schedule::Database;
+  using ItinerarySet = rmf_traffic_msgs::msg::ItinerarySet;
+  using ItineraryExtend = rmf_traffic_msgs::msg::ItineraryExtend;
+  using ItineraryDelay = rmf_traffic_msgs::msg::ItineraryDelay;
+  using ItineraryReached = rmf_traffic_msgs::msg::ItineraryReached;
+  using ItineraryClear = rmf_traffic_msgs::msg::ItineraryClear;
+
+  /// Constructor
+  ///
+  /// \param[in] directory
+  ///   The directory that the checkpoints and logs are kept in. It will be
+  ///   created if it does not exist yet.
+  ///
+  /// \throws std::filesystem::filesystem_error if the directory cannot be
+  /// created.
+  explicit ScheduleJournal(std::filesystem::path directory);
+
+  struct Restored
+  {
+    std::shared_ptr<Database> database;
+
+    /// The generation of the checkpoint that was loaded
+    std::size_t generation;
+
+    /// How many logged changes were replayed on top of the checkpoint
+    std::size_t replayed;
+
+    /// How many logged changes could not be replayed
+    std::size_t failed;
+  };
+
+  /// Restore the database from the latest checkpoint in the directory. If
+  /// there are no checkpoints, nothing is returned.
+  ///
+  /// \throws std::runtime_error if the latest checkpoint is corrupt.
+  std::optional<Restored> restore();
+
+  /// The state of a database at the moment that a new generation began.
+  struct Snapshot
+  {
+    std::size_t generation;
+    rmf_traffic_msgs::msg::Participants participants;
+    rmf_traffic_msgs::msg::SchedulePatch patch;
+  };
+
+  /// Take a snapshot of the database and begin a new generation of the log.
+  /// This must be called while the database is locked, in the same order as
+  /// the changes that get logged.
+  Snapshot snapshot(const Database& database);
+
+  /// Write a snapshot to disk as a checkpoint and delete the checkpoints and
+  /// logs that it supersedes. This does not need the database to be locked.
+  ///
+  /// \throws std::runtime_error if the checkpoint cannot be written.
+  void write(const Snapshot& snapshot);
+
+  /// Log an itinerary change. These must be called while the database is
+  /// locked, after the change has been successfully applied to it.
+  ///
+  /// Unless flush_every_change is set, the change is buffered until the next
+  /// call to flush(), or until the buffer is full.
+  void log(const ItinerarySet& msg);
+  void log(const ItineraryExtend& msg);
+  void log(const ItineraryDelay& msg);
+  void log(const ItineraryReached& msg);
+  void log(const ItineraryClear& msg);
+
+  /// Hand every buffered change to the operating system so that it survives
+  /// this process dying. This must be called while the database is locked.
+  void flush();
+
+  /// Flush every change as soon as it is logged.
+  void flush_every_change(bool value);
+
+  /// The directory of this journal
+  const std::filesystem::path& directory() const;
+
+private:
+
+  enum class Entry : uint8_t
+  {
+    Set = 0,
+    Extend = 1,
+    Delay = 2,
+    Reached = 3,
+    Clear = 4
+  };
+
+  template<typename Msg>
+  void _log(Entry entry, const Msg& msg);
+
+  template<typename Msg>
+  bool _replay_entry(std::istream& in, Database& database, Restored& restored);
+
+  void _replay(
+    const std::filesystem::path& path,
+    Database& database,
+    Restored& restored);
+
+  std::filesystem::path _checkpoint_path(std::size_t generation) const;
+  std::filesystem::path _log_path(std::size_t generation) const;
+
+  std::filesystem::path _directory;
+  std::size_t _generation = 0;
+  std::ofstream _log_file;
+  bool _unflushed = false;
+  bool _flush_every_change = false;
+
+  std::mutex _write_mutex;
+  std::size_t _last_written = 0;
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__SCHEDULEJOURNAL_HPP
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ScheduleMetrics.hpp"
+
+#include <cstdio>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+auto ScheduleMetrics::take(
+  const std::string& source,
+  const builtin_interfaces::msg::Time& window_start,
+  const builtin_interfaces::msg::Time& window_stop,
+  std::ostream* csv) -> std::vector<MetricsMessage>
+{
+  char stamp[32];
+  std::snprintf(
+    stamp, sizeof(stamp), "%d.%09u", window_stop.sec, window_stop.nanosec);
+
+  std::vector<MetricsMessage> messages;
+  _for_each(
+    [&](const char* name, const char* unit, Histogram& histogram)
+    {
+      const auto summary = histogram.take();
+
+      messages.emplace_back(
+        make_metrics_message(
+          source, name, unit, window_start, window_stop, summary));
+
+      if (csv)
+      {
+        *csv << stamp << "," << name << "," << unit << ","
+             << summary.count << "," << summary.mean() << ","
+             << summary.min << "," << summary.max << ","
+             << summary.percentile(0.5) << ","
+             << summary.percentile(0.9) << ","
+             << summary.percentile(0.99) << "\n";
+      }
+    });
+
+  if (csv)
+    csv->flush();
+
+  return messages;
+}
+
+//==============================================================================
+const char* ScheduleMetrics::csv_header()
+{
+  return "window_stop,metric,unit,count,mean,min,max,p50,p90,p99";
+}
+
+//==============================================================================
+void ScheduleMetrics::_for_each(
+  std::function<void(const char* name, const char* unit, Histogram&)> f)
+{
+  f("conflict_check_time", "ns", conflict_check_time);
+  f("database_lock_time", "ns", database_lock_time);
+  f("mirror_update_routes", "routes", mirror_update_routes);
+  f("mirror_update_participants", "participants", mirror_update_participants);
+  f("conflict_mirror_lag", "versions", conflict_mirror_lag);
+  f("open_negotiations", "negotiations", open_negotiations);
+  f("itinerary_changes", "changes", itinerary_changes);
+  f("negotiation_conclusion_time", "ns", negotiation_conclusion_time);
+  f("negotiation_grace_time", "ns", negotiation_grace_time);
+  f(
+    "negotiation_deadline_participants", "participants",
+    negotiation_deadline_participants);
+}
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
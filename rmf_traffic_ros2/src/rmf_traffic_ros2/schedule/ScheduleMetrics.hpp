@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef SRC__RMF_TRAFFIC_ROS2__SCHEDULE__SCHEDULEMETRICS_HPP
+#define SRC__RMF_TRAFFIC_ROS2__SCHEDULE__SCHEDULEMETRICS_HPP
+
+#include <rmf_traffic_ros2/Metrics.hpp>
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rmf_traffic_ros2 {
+namespace schedule {
+
+//==============================================================================
+/// Histograms of the timing and load of the hot paths of a schedule node.
+class ScheduleMetrics
+{
+public:
+
+  using Histogram = rmf_traffic_ros2::Histogram;
+  using Timer = Histogram::Timer;
+
+  /// Time spent looking for conflicts in each batch of changes
+  Histogram conflict_check_time;
+
+  /// Time that database_mutex is held for each time it is locked
+  Histogram database_lock_time;
+
+  /// Routes that were added by each mirror update that got published
+  Histogram mirror_update_routes;
+
+  /// Participants that were included in each mirror update that got published
+  Histogram mirror_update_participants;
+
+  /// How many versions the conflict detection mirror is behind the database
+  /// each time it catches up
+  Histogram conflict_mirror_lag;
+
+  /// Negotiations that are open, sampled once per window
+  Histogram open_negotiations;
+
+  /// Itinerary changes received from participants
+  Histogram itinerary_changes;
+
+  /// Time from the start of each negotiation until its conclusion
+  Histogram negotiation_conclusion_time;
+
+  /// Time that each resolved negotiation spent collecting more proposals after
+  /// it became ready
+  Histogram negotiation_grace_time;
+
+  /// Participants of each negotiation that was cut off by its deadline
+  Histogram negotiation_deadline_participants;
+
+  using MetricsMessage = statistics_msgs::msg::MetricsMessage;
+
+  /// Summarize every metric since the last call and start a new window.
+  ///
+  /// \param[in] source
+  ///   The name of the node that the metrics belong to
+  ///
+  /// \param[in] window_start
+  ///   When the previous window ended
+  ///
+  /// \param[in] window_stop
+  ///   Now
+  ///
+  /// \param[in] csv
+  ///   If this is not null, every metric is also appended to it as one line of
+  ///   comma-separated values.
+  std::vector<MetricsMessage> take(
+    const std::string& source,
+    const builtin_interfaces::msg::Time& window_start,
+    const builtin_interfaces::msg::Time& window_stop,
+    std::ostream* csv = nullptr);
+
+  /// The header line that matches the lines written by take()
+  static const char* csv_header();
+
+private:
+  void _for_each(
+    std::function<void(const char* name, const char* unit, Histogram&)> f);
+};
+
+} // namespace schedule
+} // namespace rmf_traffic_ros2
+
+#endif // SRC__RMF_TRAFFIC_ROS2__SCHEDULE__SCHEDULEMETRICS_HPP
@@ -35,6 +35,9 @@
 
 #include <rmf_utils/RateLimiter.hpp>
 
+#include <list>
+#include <mutex>
+
 using namespace std::chrono_literals;
 
 namespace rmf_traffic_ros2 {
@@ -290,6 +293,25 @@ public:
     rclcpp::Client<Register>::SharedPtr register_client;
     rclcpp::Client<Unregister>::SharedPtr unregister_client;
 
+    using RegisterResponse = std::shared_ptr<Register::Response>;
+
+    /// A registration request that was sent before make_participant asked for
+    /// it, so that several participants can be registered at once.
+    struct Prefetched
+    {
+      rmf_traffic_msgs::msg::ParticipantDescription description;
+      std::shared_future<RegisterResponse> response;
+      std::chrono::steady_clock::time_point expiry;
+    };
+
+    /// How long a prefetched registration is kept for if nothing claims it.
+    /// Registering the same description again later is harmless, so this only
+    /// needs to be long enough for a batch of participants to be made.
+    static constexpr std::chrono::seconds prefetch_timeout{60};
+
+    std::mutex prefetch_mutex;
+    std::list<Prefetched> prefetched;
+
     using ScheduleId = rmf_traffic_msgs::msg::ScheduleIdentity;
     using ScheduleStartupSub = rclcpp::Subscription<ScheduleId>::SharedPtr;
     ScheduleStartupSub schedule_startup_sub;
@@ -446,10 +468,11 @@ public:
     {
       using namespace std::chrono_literals;
 
-      auto request = std::make_shared<Register::Request>();
-      request->description = convert(participant_info);
+      auto description = convert(participant_info);
+      auto future = take_prefetched(description);
+      if (!future.valid())
+        future = send_registration(std::move(description));
 
-      auto future = register_client->async_send_request(std::move(request));
       while (future.wait_for(100ms) != std::future_status::ready)
       {
         if (!rclcpp::ok(context))
@@ -475,6 +498,95 @@ public:
       return convert(*response);
     }
 
+    std::shared_future<RegisterResponse> send_registration(
+      rmf_traffic_msgs::msg::ParticipantDescription description)
+    {
+      auto request = std::make_shared<Register::Request>();
+      request->description = std::move(description);
+
+      auto promise = std::make_shared<std::promise<RegisterResponse>>();
+      std::shared_future<RegisterResponse> response = promise->get_future();
+
+      using Response = std::shared_future<RegisterResponse>;
+      std::function<void(Response)> cb =
+        [promise](const Response& future_response)
+        {
+          try
+          {
+            promise->set_value(future_response.get());
+          }
+          catch (...)
+          {
+            promise->set_exception(std::current_exception());
+          }
+        };
+
+      register_client->async_send_request(std::move(request), std::move(cb));
+      return response;
+    }
+
+    void prefetch_registration(
+      const rmf_traffic::schedule::ParticipantDescription& participant_info)
+    {
+      auto description = convert(participant_info);
+      auto response = send_registration(description);
+      const auto expiry = std::chrono::steady_clock::now() + prefetch_timeout;
+
+      std::lock_guard<std::mutex> lock(prefetch_mutex);
+      prune_prefetched_locked();
+      prefetched.push_back(
+        {std::move(description), std::move(response), expiry});
+    }
+
+    std::shared_future<RegisterResponse> take_prefetched(
+      const rmf_traffic_msgs::msg::ParticipantDescription& description)
+    {
+      std::lock_guard<std::mutex> lock(prefetch_mutex);
+      prune_prefetched_locked();
+      for (auto it = prefetched.begin(); it != prefetched.end(); ++it)
+      {
+        if (it->description == description)
+        {
+          auto response = std::move(it->response);
+          prefetched.erase(it);
+          return response;
+        }
+      }
+
+      return {};
+    }
+
+    /// Drop prefetched registrations that failed or that nothing claimed in
+    /// time, e.g. because the batch that asked for them was abandoned. The
+    /// prefetch_mutex must be locked while this is called.
+    void prune_prefetched_locked()
+    {
+      const auto now = std::chrono::steady_clock::now();
+      for (auto it = prefetched.begin(); it != prefetched.end(); )
+      {
+        if (it->expiry < now || failed(it->response))
+          it = prefetched.erase(it);
+        else
+          ++it;
+      }
+    }
+
+    static bool failed(const std::shared_future<RegisterResponse>& response)
+    {
+      using namespace std::chrono_literals;
+      if (response.wait_for(0s) != std::future_status::ready)
+        return false;
+
+      try
+      {
+        return !response.get() || !response.get()->error.empty();
+      }
+      catch (...)
+      {
+        return true;
+      }
+    }
+
     void async_register_participant(
       rmf_traffic::schedule::ParticipantDescription participant_info,
       std::function<void(Registration)> callback)
@@ -645,6 +757,39 @@ public:
 
     worker.detach();
   }
+
+  void async_make_participants(
+    std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions,
+    std::function<void(std::vector<rmf_traffic::schedule::Participant>)>
+    ready_callback)
+  {
+    // Send every registration request up front. The participants are still
+    // made one at a time below, but each of them will pick up the response to
+    // a request that is already in flight.
+    for (const auto& description : descriptions)
+      transport->prefetch_registration(description);
+
+    std::thread worker(
+      [descriptions = std::move(descriptions),
+      this,
+      ready_callback = std::move(ready_callback)]() mutable
+      {
+        std::vector<rmf_traffic::schedule::Participant> participants;
+        participants.reserve(descriptions.size());
+        for (auto& description : descriptions)
+        {
+          participants.push_back(
+            rmf_traffic::schedule::make_participant(
+              std::move(description), transport,
+              transport->rectifier_factory));
+        }
+
+        if (ready_callback)
+          ready_callback(std::move(participants));
+      });
+
+    worker.detach();
+  }
 };
 
 //==============================================================================
@@ -700,6 +845,16 @@ void Writer::async_make_participant(
     std::move(description), std::move(ready_callback));
 }
 
+//==============================================================================
+void Writer::async_make_participants(
+  std::vector<rmf_traffic::schedule::ParticipantDescription> descriptions,
+  std::function<void(std::vector<rmf_traffic::schedule::Participant>)>
+  ready_callback)
+{
+  _pimpl->async_make_participants(
+    std::move(descriptions), std::move(ready_callback));
+}
+
 //==============================================================================
 Writer::Writer()
 {
@@ -72,7 +72,19 @@ public:
     {
       auto index = _buffer.size();
       _name_to_index[uuid] = index;
-      _buffer.push_back(serialize(operation));
+      const auto record = serialize(operation);
+      _buffer.push_back(record);
+
+      if (index > 0 && _buffer.Style() != YAML::EmitterStyle::Flow)
+      {
+        // Only the new record needs to be written, so append it to the file
+        // instead of writing out every registration again.
+        YAML::Emitter emitter;
+        emitter << YAML::BeginSeq << record << YAML::EndSeq;
+        std::ofstream file(_file_path, std::ios::app);
+        file << "\n" << emitter.c_str();
+        return;
+      }
     }
 
     std::ofstream file(_file_path);
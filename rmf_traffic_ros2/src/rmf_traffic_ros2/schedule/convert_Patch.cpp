@@ -26,6 +26,9 @@
 
 #include "internal_convert_vector.hpp"
 
+#include <algorithm>
+#include <future>
+
 using Time = rmf_traffic::Time;
 using Duration = rmf_traffic::Duration;
 
@@ -147,4 +150,71 @@ rmf_traffic::schedule::Patch convert(
   };
 }
 
+//==============================================================================
+rmf_traffic::schedule::Patch convert(
+  const rmf_traffic_msgs::msg::SchedulePatch& from,
+  const std::size_t max_threads)
+{
+  const std::size_t N = from.participants.size();
+  const std::size_t num_threads = std::min(max_threads, N);
+  if (num_threads < 2)
+    return convert(from);
+
+  // Each thread converts one contiguous block of participants, so the output
+  // keeps the same order as the message.
+  const std::size_t block = (N + num_threads - 1) / num_threads;
+  std::vector<std::future<std::vector<rmf_traffic::schedule::Patch::Participant>>>
+  futures;
+  futures.reserve(num_threads);
+  for (std::size_t begin = 0; begin < N; begin += block)
+  {
+    const std::size_t end = std::min(begin + block, N);
+    futures.emplace_back(
+      std::async(
+        std::launch::async,
+        [&from, begin, end]()
+        {
+          std::vector<rmf_traffic::schedule::Patch::Participant> output;
+          output.reserve(end - begin);
+          for (std::size_t i = begin; i < end; ++i)
+            output.emplace_back(convert(from.participants[i]));
+
+          return output;
+        }));
+  }
+
+  std::vector<rmf_traffic::schedule::Patch::Participant> participants;
+  participants.reserve(N);
+  for (auto& f : futures)
+  {
+    for (auto& p : f.get())
+      participants.emplace_back(std::move(p));
+  }
+
+  std::optional<rmf_traffic::schedule::Change::Cull> cull;
+  if (!from.cull.empty())
+    cull = convert(from.cull.front());
+
+  std::optional<rmf_traffic::schedule::Version> base_version;
+  if (from.has_base_version)
+    base_version = from.base_version;
+
+  return rmf_traffic::schedule::Patch{
+    std::move(participants),
+    std::move(cull),
+    base_version,
+    from.latest_version
+  };
+}
+
+//==============================================================================
+std::size_t count_routes(const rmf_traffic_msgs::msg::SchedulePatch& msg)
+{
+  std::size_t count = 0;
+  for (const auto& p : msg.participants)
+    count += p.additions.items.size();
+
+  return count;
+}
+
 } // namespace rmf_traffic_ros2
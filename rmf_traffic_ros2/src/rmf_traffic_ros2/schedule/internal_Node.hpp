@@ -19,6 +19,9 @@
 #define SRC__RMF_TRAFFIC_SCHEDULE__SCHEDULENODE_HPP
 
 #include "NegotiationRoom.hpp"
+#include "NegotiationTrace.hpp"
+#include "ScheduleJournal.hpp"
+#include "ScheduleMetrics.hpp"
 
 #include <rmf_traffic/schedule/Database.hpp>
 #include <rmf_traffic/schedule/Negotiation.hpp>
@@ -63,6 +66,7 @@
 
 #include <rmf_utils/Modular.hpp>
 
+#include <fstream>
 #include <optional>
 #include <set>
 #include <unordered_map>
@@ -162,6 +166,21 @@ public:
 
   RegisterParticipantSrv::SharedPtr register_participant_service;
 
+  // A registration only changes the database right away. Making a new
+  // checkpoint and broadcasting the participants are done once for each batch
+  // of registrations, so that a whole fleet coming online does not do them
+  // once per robot.
+  rmf_traffic::Duration registration_batch_period;
+  rclcpp::TimerBase::SharedPtr registration_timer;
+  bool registration_checkpoint_pending = false;
+  void schedule_registration_flush();
+
+  // Broadcast the participants and, if a checkpoint is pending, start a new
+  // generation of the journal. This must be called while database_mutex is
+  // locked, and the snapshot that it returns should be written after the
+  // mutex is released.
+  std::optional<ScheduleJournal::Snapshot> flush_registrations_locked();
+
   using UnregisterParticipant = rmf_traffic_msgs::srv::UnregisterParticipant;
   using UnregisterParticipantSrv = rclcpp::Service<UnregisterParticipant>;
 
@@ -308,14 +327,24 @@ public:
 
   using NegotiationStates = rmf_traffic_msgs::msg::NegotiationStates;
   using NegotiationStatesPub = rclcpp::Publisher<NegotiationStates>;
+  // The full state of every open negotiation, latched for late subscribers
   NegotiationStatesPub::SharedPtr negotiation_states_pub;
+  // Only the negotiations that changed since the last publication
+  NegotiationStatesPub::SharedPtr negotiation_state_updates_pub;
   void publish_negotiation_states();
+  void publish_full_negotiation_states();
+  rmf_traffic::Duration negotiation_states_period;
+  rclcpp::TimerBase::SharedPtr negotiation_states_timer;
+  bool negotiation_states_stale = false;
 
   using NegotiationStatuses = rmf_traffic_msgs::msg::NegotiationStatuses;
   using NegotiationStatusesPub = rclcpp::Publisher<NegotiationStatuses>;
   // Published by publish_negotiation_states
   NegotiationStatusesPub::SharedPtr negotiation_stasuses_pub;
 
+  // Summarizes negotiation progress in the log at a limited rate
+  std::unique_ptr<NegotiationTrace> negotiation_trace;
+
   class ConflictRecord
   {
   public:
@@ -328,9 +357,13 @@ public:
       rmf_traffic::Time start_time;
       rmf_traffic::Time last_active_time;
 
-      void update_state_msg(uint64_t conflict_version)
+      // When the negotiation first had a finished table to choose from
+      std::optional<rmf_traffic::Time> ready_time;
+
+      NegotiationRoom::StateDelta update_state_msg(uint64_t conflict_version)
       {
-        room.update_state_msg(conflict_version, start_time, last_active_time);
+        return room.update_state_msg(
+          conflict_version, start_time, last_active_time);
       }
     };
 
@@ -401,7 +434,8 @@ public:
             viewer.snapshot(), std::vector<ParticipantId>(
               add_to_negotiation.begin(), add_to_negotiation.end())),
           time, // start time
-          time  // last update time
+          time, // last update time
+          std::nullopt // ready time
         };
       }
       else
@@ -411,6 +445,10 @@ public:
           update_negotiation->room.negotiation.add_participant(p);
           update_negotiation->last_active_time = time;
         }
+
+        // Adding participants creates new tables that cached messages might
+        // have been waiting for.
+        update_negotiation->room.check_cache({});
       }
 
       update_negotiation->update_state_msg(negotiation_version);
@@ -525,6 +563,25 @@ public:
       }
     }
 
+    // Stop waiting for participants that have not caught up with the
+    // conclusion of their negotiation within the timeout, and return them.
+    std::vector<ParticipantId> cull_waiting(
+      const rmf_traffic::Time time,
+      const rmf_traffic::Duration timeout)
+    {
+      std::vector<ParticipantId> culled;
+      for (const auto& [p, wait] : _waiting)
+      {
+        if (wait.conclusion_time + timeout < time)
+          culled.push_back(p);
+      }
+
+      for (const auto p : culled)
+        _waiting.erase(p);
+
+      return culled;
+    }
+
 //  private:
     std::unordered_map<ParticipantId, Version> _version;
     std::unordered_map<Version,
@@ -535,11 +592,72 @@ public:
 
   ConflictRecord active_conflicts;
   std::mutex active_conflicts_mutex;
+
+  // How long to keep collecting proposals after a negotiation becomes ready,
+  // in case a better one arrives
+  rmf_traffic::Duration negotiation_grace_period;
+
+  // How long a negotiation may stay open before it gets concluded with
+  // whatever it has
+  std::optional<rmf_traffic::Duration> negotiation_deadline;
+
+  rclcpp::TimerBase::SharedPtr negotiation_timer;
+  void setup_negotiation_timer();
+  void check_negotiation_timing();
+
+  // Choose the best finished table of a negotiation, or forfeit it if there is
+  // none, and announce the conclusion. This must be called while
+  // active_conflicts_mutex is locked, and it invalidates the open negotiation.
+  void conclude_negotiation(
+    Version conflict_version,
+    ConflictRecord::OpenNegotiation& open,
+    rmf_traffic::Time time);
   std::shared_ptr<ParticipantRegistry> participant_registry;
 
   virtual void setup_conflict_topics_and_thread();
   void setup_cull_timer();
 
+  // Durable checkpoints of the database and a log of the itinerary changes
+  // since the last one. This is only used when the checkpoint_directory
+  // parameter is set.
+  std::unique_ptr<ScheduleJournal> journal;
+  rclcpp::TimerBase::SharedPtr checkpoint_timer;
+  rclcpp::TimerBase::SharedPtr journal_flush_timer;
+  void setup_journal();
+
+  // Make a new checkpoint. The snapshot is taken while database_mutex is
+  // locked, but it is written to disk after the mutex is released.
+  void checkpoint();
+  void write_checkpoint(const ScheduleJournal::Snapshot& snapshot);
+
+  // Start a new generation of the journal. This must be called while
+  // database_mutex is locked. The snapshot should be passed to
+  // write_checkpoint after the mutex is released.
+  std::optional<ScheduleJournal::Snapshot> snapshot_locked();
+  VersionOpt last_checkpoint_version;
+
+  // Log an itinerary change while database_mutex is locked.
+  //
+  // Changes for a participant that registered after the last checkpoint can
+  // only be replayed once the next registration flush has taken its snapshot.
+  // If the node dies before that, those changes are lost from the journal,
+  // and the participant sends its itinerary again once it has reconnected.
+  template<typename Change>
+  void log_to_journal(const Change& change)
+  {
+    if (journal)
+      journal->log(change);
+  }
+
+  // Performance statistics of the hot paths of this node
+  ScheduleMetrics metrics;
+  rclcpp::Publisher<ScheduleMetrics::MetricsMessage>::SharedPtr statistics_pub;
+  rclcpp::TimerBase::SharedPtr statistics_timer;
+  rclcpp::Time statistics_window_start;
+  std::ofstream statistics_file;
+  void setup_statistics();
+  void publish_statistics();
+
   // TODO(MXG): Build this into the Database/Mirror class, tracking participant
   // description versions separately from itinerary versions.
   std::size_t last_known_participants_version = 0;
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures how many participant updates per second the blockade moderator can
+// absorb, comparing a full heartbeat after every update against batched delta
+// heartbeats. Each participant is on its own map so that the cost of the
+// moderator itself stays the same for both approaches.
+
+#include <rmf_traffic_ros2/blockade/HeartbeatTracker.hpp>
+
+#include <rmf_traffic/blockade/Moderator.hpp>
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using HeartbeatTracker = rmf_traffic_ros2::blockade::HeartbeatTracker;
+using HeartbeatMsg = HeartbeatTracker::HeartbeatMsg;
+using Moderator = rmf_traffic::blockade::Moderator;
+using Checkpoint = rmf_traffic::blockade::Writer::Checkpoint;
+using Reservation = rmf_traffic::blockade::Writer::Reservation;
+
+namespace {
+
+constexpr std::size_t NumCheckpoints = 20;
+
+//==============================================================================
+struct Result
+{
+  double seconds = 0.0;
+  std::size_t updates = 0;
+  std::size_t heartbeats = 0;
+  std::size_t bytes = 0;
+};
+
+//==============================================================================
+std::shared_ptr<Moderator> make_moderator(const std::size_t participants)
+{
+  auto moderator = std::make_shared<Moderator>();
+  for (std::size_t p = 0; p < participants; ++p)
+  {
+    const std::string map = "map_" + std::to_string(p);
+    std::vector<Checkpoint> path;
+    for (std::size_t i = 0; i < NumCheckpoints; ++i)
+      path.push_back(Checkpoint{Eigen::Vector2d(2.0*i, 0.0), map, true});
+
+    moderator->set(p, 0, Reservation{std::move(path), 0.5});
+  }
+
+  return moderator;
+}
+
+//==============================================================================
+std::size_t serialized_size(const HeartbeatMsg& msg)
+{
+  static rclcpp::Serialization<HeartbeatMsg> serializer;
+  rclcpp::SerializedMessage serialized;
+  serializer.serialize_message(&msg, &serialized);
+  return serialized.size();
+}
+
+//==============================================================================
+/// Every participant moves through its whole path. Each checkpoint takes one
+/// ready and one reached update.
+template<typename Apply, typename Flush>
+Result run(
+  const std::size_t participants,
+  Apply apply,
+  Flush flush)
+{
+  Result result;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < NumCheckpoints; ++i)
+  {
+    for (std::size_t p = 0; p < participants; ++p)
+    {
+      apply([&](Moderator& m) { m.ready(p, 0, i); }, result);
+      apply([&](Moderator& m) { m.reached(p, 0, i); }, result);
+    }
+
+    flush(result);
+  }
+
+  result.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+//==============================================================================
+Result run_full(const std::size_t participants)
+{
+  const auto moderator = make_moderator(participants);
+  HeartbeatTracker tracker;
+  return run(
+    participants,
+    [&](const auto& update, Result& result)
+    {
+      update(*moderator);
+      ++result.updates;
+
+      const auto msg = tracker.full(*moderator);
+      ++result.heartbeats;
+      result.bytes += serialized_size(msg);
+    },
+    [](Result&) {});
+}
+
+//==============================================================================
+Result run_delta(const std::size_t participants)
+{
+  const auto moderator = make_moderator(participants);
+  HeartbeatTracker tracker;
+  tracker.full(*moderator);
+  return run(
+    participants,
+    [&](const auto& update, Result& result)
+    {
+      update(*moderator);
+      ++result.updates;
+    },
+    [&](Result& result)
+    {
+      const auto heartbeat = tracker.delta(*moderator);
+      if (!heartbeat.has_value())
+        return;
+
+      ++result.heartbeats;
+      result.bytes += serialized_size(heartbeat->msg);
+    });
+}
+
+//==============================================================================
+void print(const std::string& name, const Result& result)
+{
+  std::cout << "  " << name << ": " << result.updates << " updates in "
+            << result.seconds << "s (" << result.updates / result.seconds
+            << " updates/s), " << result.heartbeats << " heartbeats, "
+            << result.bytes << " bytes" << std::endl;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::vector<std::size_t> sizes = {10, 50, 100, 200};
+  if (argc > 1)
+  {
+    sizes.clear();
+    for (int i = 1; i < argc; ++i)
+      sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+  }
+
+  for (const auto n : sizes)
+  {
+    std::cout << n << " participants:" << std::endl;
+    print("full ", run_full(n));
+    print("delta", run_delta(n));
+  }
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+// Measures how long it takes to find every conflicting pair among a set of
+// routes spread over a floor, comparing DetectConflict::between on every pair
+// of routes on the same map against filtering the pairs with RouteBounds first.
+
+#include <rmf_traffic_ros2/schedule/RouteBounds.hpp>
+
+#include <rmf_traffic/DetectConflict.hpp>
+#include <rmf_traffic/geometry/Circle.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using RouteBounds = rmf_traffic_ros2::schedule::RouteBounds;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr double FloorSize = 100.0;
+constexpr std::size_t WaypointsPerRoute = 10;
+
+//==============================================================================
+struct Result
+{
+  double seconds = 0.0;
+  std::size_t narrow_checks = 0;
+  std::size_t conflicts = 0;
+};
+
+//==============================================================================
+/// Each route wanders a short distance from a random spot on the floor over a
+/// random window of a few minutes.
+std::vector<rmf_traffic::Route> make_routes(const std::size_t count)
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> spot(0.0, FloorSize);
+  std::uniform_real_distribution<double> step(-2.0, 2.0);
+  std::uniform_int_distribution<int> delay(0, 300);
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<rmf_traffic::Route> routes;
+  routes.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    Eigen::Vector3d p(spot(rng), spot(rng), 0.0);
+    auto t = start + std::chrono::seconds(delay(rng));
+    rmf_traffic::Trajectory trajectory;
+    for (std::size_t w = 0; w < WaypointsPerRoute; ++w)
+    {
+      trajectory.insert(t, p, Eigen::Vector3d::Zero());
+      p += Eigen::Vector3d(step(rng), step(rng), 0.0);
+      t += 5s;
+    }
+
+    routes.emplace_back("L1", std::move(trajectory));
+  }
+
+  return routes;
+}
+
+//==============================================================================
+Result run_narrow(
+  const rmf_traffic::Profile& profile,
+  const std::vector<rmf_traffic::Route>& routes)
+{
+  Result result;
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    for (std::size_t j = i+1; j < routes.size(); ++j)
+    {
+      if (routes[i].map() != routes[j].map())
+        continue;
+
+      ++result.narrow_checks;
+      if (rmf_traffic::DetectConflict::between(
+          profile, routes[i].trajectory(), nullptr,
+          profile, routes[j].trajectory(), nullptr))
+      {
+        ++result.conflicts;
+      }
+    }
+  }
+
+  result.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+//==============================================================================
+Result run_broad(
+  const rmf_traffic::Profile& profile,
+  const std::vector<rmf_traffic::Route>& routes)
+{
+  Result result;
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<RouteBounds> bounds;
+  bounds.reserve(routes.size());
+  for (const auto& route : routes)
+    bounds.emplace_back(profile, route);
+
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    for (std::size_t j = i+1; j < routes.size(); ++j)
+    {
+      if (!bounds[i].might_conflict(bounds[j]))
+        continue;
+
+      ++result.narrow_checks;
+      if (rmf_traffic::DetectConflict::between(
+          profile, routes[i].trajectory(), nullptr,
+          profile, routes[j].trajectory(), nullptr))
+      {
+        ++result.conflicts;
+      }
+    }
+  }
+
+  result.seconds = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+//==============================================================================
+void print(const std::string& name, const Result& result)
+{
+  std::cout << "  " << name << ": " << result.seconds * 1000.0 << "ms, "
+            << result.narrow_checks << " narrow phase checks, "
+            << result.conflicts << " conflicts" << std::endl;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  std::vector<std::size_t> sizes = {50, 100, 200, 400};
+  if (argc > 1)
+  {
+    sizes.clear();
+    for (int i = 1; i < argc; ++i)
+      sizes.push_back(std::strtoul(argv[i], nullptr, 10));
+  }
+
+  const rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(0.5)};
+
+  for (const auto n : sizes)
+  {
+    const auto routes = make_routes(n);
+    std::cout << n << " routes:" << std::endl;
+    print("narrow only ", run_narrow(profile, routes));
+    print("broad+narrow", run_broad(profile, routes));
+  }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+#include <rmf_utils/catch.hpp>
+
+#include <algorithm>
+
+#include "../../src/rmf_traffic_ros2/schedule/internal_Node.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+using namespace std::chrono_literals;
+
+SCENARIO("Conflict record stops waiting for participants that time out")
+{
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0);
+
+  const auto make_description = [&](const std::string& name)
+    {
+      return rmf_traffic::schedule::ParticipantDescription(
+        name,
+        "test_ConflictRecord",
+        rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+        rmf_traffic::Profile{shape});
+    };
+
+  rmf_traffic::schedule::Database db;
+  const auto p1 = db.register_participant(make_description("p1")).id();
+  const auto p2 = db.register_participant(make_description("p2")).id();
+
+  const auto start = std::chrono::steady_clock::now();
+  ScheduleNode::ConflictRecord record;
+  const auto entry = record.insert({p1, p2}, start, db);
+  REQUIRE(entry.has_value());
+
+  const auto concluded = start + 5s;
+  record.conclude(entry->first, concluded);
+  REQUIRE(record._waiting.size() == 2);
+
+  WHEN("The timeout has not passed yet")
+  {
+    const auto culled = record.cull_waiting(concluded + 10s, 30s);
+
+    THEN("The participants are still being waited for")
+    {
+      CHECK(culled.empty());
+      CHECK(record._waiting.size() == 2);
+    }
+  }
+
+  WHEN("The timeout passes")
+  {
+    auto culled = record.cull_waiting(concluded + 31s, 30s);
+    std::sort(culled.begin(), culled.end());
+
+    THEN("Every participant is culled")
+    {
+      CHECK(culled == std::vector<rmf_traffic::schedule::ParticipantId>{
+        std::min(p1, p2), std::max(p1, p2)});
+      CHECK(record._waiting.empty());
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic/schedule/Database.hpp>
+#include <rmf_traffic_ros2/schedule/Itinerary.hpp>
+#include <rmf_utils/catch.hpp>
+
+#include "../../src/rmf_traffic_ros2/schedule/NegotiationRoom.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+using namespace std::chrono_literals;
+
+SCENARIO("Negotiation room releases cached messages when their table appears")
+{
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0);
+
+  const auto make_description = [&](const std::string& name)
+    {
+      return rmf_traffic::schedule::ParticipantDescription(
+        name,
+        "test_NegotiationRoom",
+        rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+        rmf_traffic::Profile{shape});
+    };
+
+  rmf_traffic::schedule::Database db;
+  const auto p1 = db.register_participant(make_description("p1")).id();
+  const auto p2 = db.register_participant(make_description("p2")).id();
+
+  const auto now = std::chrono::steady_clock::now();
+  rmf_traffic::Trajectory trajectory;
+  trajectory.insert(now, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  trajectory.insert(now + 10s, {10.0, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  const rmf_traffic::schedule::Itinerary itinerary =
+  {rmf_traffic::Route("test_map", trajectory)};
+
+  NegotiationRoom room(
+    *rmf_traffic::schedule::Negotiation::make(db.snapshot(), {p1, p2}));
+
+  // A proposal from p2 that accommodates version 1 of p1's proposal, which
+  // has not arrived yet
+  NegotiationRoom::Proposal proposal;
+  proposal.conflict_version = 0;
+  proposal.proposal_version = 1;
+  proposal.for_participant = p2;
+  proposal.to_accommodate = rmf_traffic_ros2::convert(
+    rmf_traffic::schedule::Negotiation::VersionedKeySequence{{p1, 1}});
+  proposal.itinerary = rmf_traffic_ros2::convert(itinerary);
+
+  REQUIRE_FALSE(room.negotiation.find(p2, {{p1, 1}}).table);
+  room.cache(proposal);
+  CHECK(room.cached_size() == 1);
+
+  WHEN("An unrelated table changes")
+  {
+    const auto p2_table = room.negotiation.table(p2, {});
+    REQUIRE(p2_table);
+    p2_table->submit(0, itinerary, 1);
+    room.check_cache({}, p2_table);
+
+    THEN("The proposal stays cached")
+    {
+      CHECK(room.cached_size() == 1);
+    }
+  }
+
+  WHEN("The table that the proposal builds on receives its submission")
+  {
+    const auto p1_table = room.negotiation.table(p1, {});
+    REQUIRE(p1_table);
+    p1_table->submit(0, itinerary, 1);
+    room.check_cache({}, p1_table);
+
+    THEN("The proposal is applied")
+    {
+      CHECK(room.cached_size() == 0);
+      const auto child = room.negotiation.find(p2, {{p1, 1}}).table;
+      REQUIRE(child);
+      CHECK(child->submission());
+    }
+  }
+
+  WHEN("Every cached message is retried")
+  {
+    const auto p1_table = room.negotiation.table(p1, {});
+    REQUIRE(p1_table);
+    p1_table->submit(0, itinerary, 1);
+    room.check_cache({});
+
+    THEN("The proposal is applied")
+    {
+      CHECK(room.cached_size() == 0);
+    }
+  }
+}
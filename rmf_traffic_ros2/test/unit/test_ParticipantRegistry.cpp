@@ -233,6 +233,49 @@ SCENARIO("Test file logger")
     }
   }
 
+  GIVEN("records that are appended after an update")
+  {
+    auto p1_updated = p1;
+    p1_updated.responsiveness(
+      rmf_traffic::schedule::ParticipantDescription::Rx::Unresponsive);
+
+    {
+      YamlLogger logger1("test_yamllogger.yaml");
+      logger1.write_operation({AtomicOperation::OpType::Add, p1});
+      logger1.write_operation({AtomicOperation::OpType::Add, p2});
+      logger1.write_operation({AtomicOperation::OpType::Update, p1_updated});
+    }
+
+    {
+      YamlLogger logger2("test_yamllogger.yaml");
+      while (logger2.read_next_record())
+      {
+        // Load the records that are already in the file
+      }
+
+      logger2.write_operation({AtomicOperation::OpType::Add, p3});
+    }
+
+    THEN("Every record is retrieved in order")
+    {
+      YamlLogger logger3("test_yamllogger.yaml");
+      std::vector<AtomicOperation> expected = {
+        {AtomicOperation::OpType::Add, p1_updated},
+        {AtomicOperation::OpType::Add, p2},
+        {AtomicOperation::OpType::Add, p3}
+      };
+
+      std::size_t i = 0;
+      while (auto record = logger3.read_next_record())
+      {
+        REQUIRE(i < expected.size());
+        CHECK(expected[i] == *record);
+        i++;
+      }
+      CHECK(i == expected.size());
+    }
+  }
+
   GIVEN("corrupt file that is in no way YAML")
   {
     std::ofstream invalid_yaml;
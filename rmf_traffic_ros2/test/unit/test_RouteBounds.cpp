@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic/DetectConflict.hpp>
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic_ros2/schedule/RouteBounds.hpp>
+#include <rmf_utils/catch.hpp>
+
+#include <random>
+
+using rmf_traffic_ros2::schedule::RouteBounds;
+using namespace std::chrono_literals;
+
+namespace {
+//==============================================================================
+rmf_traffic::Route straight(
+  const std::string& map,
+  const rmf_traffic::Time start,
+  const Eigen::Vector2d from,
+  const Eigen::Vector2d to)
+{
+  rmf_traffic::Trajectory trajectory;
+  const Eigen::Vector3d zero = Eigen::Vector3d::Zero();
+  trajectory.insert(start, {from.x(), from.y(), 0.0}, zero);
+  trajectory.insert(start + 10s, {to.x(), to.y(), 0.0}, zero);
+  return rmf_traffic::Route(map, std::move(trajectory));
+}
+} // anonymous namespace
+
+SCENARIO("Route bounds rule out routes that cannot conflict")
+{
+  const rmf_traffic::Profile profile{
+    rmf_traffic::geometry::make_final_convex<
+      rmf_traffic::geometry::Circle>(0.5)};
+
+  const auto now = std::chrono::steady_clock::now();
+  const auto crossing_a = straight("L1", now, {-5, 0}, {5, 0});
+  const auto crossing_b = straight("L1", now, {0, -5}, {0, 5});
+  const auto far = straight("L1", now, {100, 100}, {110, 100});
+  const auto other_map = straight("L2", now, {0, -5}, {0, 5});
+  const auto later = straight("L1", now + 1min, {0, -5}, {0, 5});
+
+  const RouteBounds a(profile, crossing_a);
+  CHECK(a.bounded());
+  CHECK(a.min().x() == Approx(-5.5));
+  CHECK(a.max().y() == Approx(0.5));
+
+  CHECK(a.might_conflict(RouteBounds(profile, crossing_b)));
+  CHECK(rmf_traffic::DetectConflict::between(
+      profile, crossing_a.trajectory(), nullptr,
+      profile, crossing_b.trajectory(), nullptr));
+
+  CHECK_FALSE(a.might_conflict(RouteBounds(profile, far)));
+  CHECK_FALSE(a.might_conflict(RouteBounds(profile, other_map)));
+  CHECK_FALSE(a.might_conflict(RouteBounds(profile, later)));
+
+  GIVEN("A trajectory that cannot be bounded")
+  {
+    rmf_traffic::Trajectory single;
+    single.insert(now, {100, 100, 0}, Eigen::Vector3d::Zero());
+    const RouteBounds b(profile, rmf_traffic::Route("L1", single));
+    CHECK_FALSE(b.bounded());
+    CHECK(a.might_conflict(b));
+    CHECK_FALSE(RouteBounds(profile, other_map).might_conflict(b));
+  }
+
+  GIVEN("Curved trajectories")
+  {
+    // Whenever the narrow phase finds a conflict, the broad phase must have
+    // let the pair through.
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> position(-10.0, 10.0);
+    std::uniform_real_distribution<double> velocity(-3.0, 3.0);
+    const auto random_route = [&]()
+      {
+        rmf_traffic::Trajectory trajectory;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+          trajectory.insert(
+            now + i*5s,
+            {position(rng), position(rng), 0.0},
+            {velocity(rng), velocity(rng), 0.0});
+        }
+
+        return rmf_traffic::Route("L1", std::move(trajectory));
+      };
+
+    std::size_t conflicts = 0;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+      const auto r0 = random_route();
+      const auto r1 = random_route();
+      if (rmf_traffic::DetectConflict::between(
+          profile, r0.trajectory(), nullptr,
+          profile, r1.trajectory(), nullptr))
+      {
+        ++conflicts;
+        CHECK(RouteBounds(profile, r0).might_conflict(
+            RouteBounds(profile, r1)));
+      }
+    }
+
+    CHECK(conflicts > 0);
+  }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_traffic/geometry/Circle.hpp>
+#include <rmf_traffic_ros2/schedule/Itinerary.hpp>
+#include <rmf_utils/catch.hpp>
+#include <filesystem>
+
+#include "../../src/rmf_traffic_ros2/schedule/ScheduleJournal.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+using namespace std::chrono_literals;
+
+SCENARIO("Schedule journal restores checkpoints and logged changes")
+{
+  using Database = rmf_traffic::schedule::Database;
+
+  const auto directory =
+    std::filesystem::temp_directory_path() / "test_schedule_journal";
+  std::filesystem::remove_all(directory);
+
+  const auto shape = rmf_traffic::geometry::make_final_convex<
+    rmf_traffic::geometry::Circle>(1.0);
+
+  rmf_traffic::schedule::ParticipantDescription p1(
+    "participant 1",
+    "test_Participant",
+    rmf_traffic::schedule::ParticipantDescription::Rx::Responsive,
+    rmf_traffic::Profile{shape});
+
+  const auto now = std::chrono::steady_clock::now();
+  rmf_traffic::Trajectory trajectory;
+  trajectory.insert(now, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  trajectory.insert(now + 10s, {10.0, 0.0, 0.0}, {0.0, 0.0, 0.0});
+  const rmf_traffic::schedule::Itinerary itinerary =
+  {rmf_traffic::Route("test_map", trajectory)};
+
+  auto db = std::make_shared<Database>();
+  const auto registration = db->register_participant(p1);
+  const auto id = registration.id();
+  db->set(
+    id, registration.last_plan_id() + 1, itinerary,
+    registration.next_storage_base(),
+    registration.last_itinerary_version() + 1);
+
+  GIVEN("A checkpoint followed by logged changes")
+  {
+    ScheduleJournal journal(directory);
+    journal.write(journal.snapshot(*db));
+
+    ScheduleJournal::ItineraryDelay delay;
+    delay.participant = id;
+    delay.delay = std::chrono::nanoseconds(5s).count();
+    delay.itinerary_version = db->itinerary_version(id) + 1;
+    db->delay(id, 5s, delay.itinerary_version);
+    journal.log(delay);
+
+    ScheduleJournal::ItinerarySet set;
+    set.participant = id;
+    set.plan = registration.last_plan_id() + 2;
+    set.itinerary = rmf_traffic_ros2::convert(itinerary);
+    set.storage_base = registration.next_storage_base() + 1;
+    set.itinerary_version = db->itinerary_version(id) + 1;
+    db->set(
+      id, set.plan, itinerary, set.storage_base, set.itinerary_version);
+    journal.log(set);
+
+    THEN("Restoring reproduces the database")
+    {
+      ScheduleJournal reopened(directory);
+      const auto restored = reopened.restore();
+      REQUIRE(restored.has_value());
+      CHECK(restored->replayed == 2);
+      CHECK(restored->failed == 0);
+
+      const auto& restored_db = *restored->database;
+      CHECK(restored_db.latest_version() == db->latest_version());
+      CHECK(restored_db.itinerary_version(id) == db->itinerary_version(id));
+      REQUIRE(restored_db.get_participant(id));
+      CHECK(*restored_db.get_participant(id) == p1);
+
+      const auto restored_itinerary = restored_db.get_itinerary(id);
+      REQUIRE(restored_itinerary.has_value());
+      CHECK(restored_itinerary->size() == itinerary.size());
+    }
+
+    THEN("A newer checkpoint supersedes the old files")
+    {
+      journal.write(journal.snapshot(*db));
+
+      std::size_t files = 0;
+      for ([[maybe_unused]] const auto& f :
+        std::filesystem::directory_iterator(directory))
+      {
+        ++files;
+      }
+
+      // One checkpoint and the empty log of its generation
+      CHECK(files == 2);
+
+      ScheduleJournal reopened(directory);
+      const auto restored = reopened.restore();
+      REQUIRE(restored.has_value());
+      CHECK(restored->replayed == 0);
+      CHECK(restored->database->latest_version() == db->latest_version());
+    }
+  }
+
+  GIVEN("An empty directory")
+  {
+    ScheduleJournal journal(directory);
+    CHECK_FALSE(journal.restore().has_value());
+  }
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <rmf_utils/catch.hpp>
+#include <sstream>
+
+#include "../../src/rmf_traffic_ros2/schedule/ScheduleMetrics.hpp"
+
+using namespace rmf_traffic_ros2::schedule;
+
+SCENARIO("Schedule metrics summarize each window")
+{
+  ScheduleMetrics metrics;
+  for (uint64_t i = 1; i <= 1000; ++i)
+    metrics.conflict_check_time.record(i);
+
+  GIVEN("A histogram with recorded values")
+  {
+    const auto summary = metrics.conflict_check_time.take();
+    CHECK(summary.count == 1000);
+    CHECK(summary.min == 1);
+    CHECK(summary.max == 1000);
+    CHECK(summary.mean() == Approx(500.5));
+
+    // Percentiles are only accurate to within a factor of two
+    CHECK(summary.percentile(0.5) >= 500);
+    CHECK(summary.percentile(0.5) < 1000);
+    CHECK(summary.percentile(0.99) == 1000);
+
+    THEN("The next window starts empty")
+    {
+      const auto next = metrics.conflict_check_time.take();
+      CHECK(next.count == 0);
+      CHECK(next.min == 0);
+      CHECK(next.max == 0);
+    }
+  }
+
+  GIVEN("Recorded durations")
+  {
+    metrics.negotiation_conclusion_time.record(std::chrono::milliseconds(2));
+    metrics.negotiation_conclusion_time.record(std::chrono::seconds(-1));
+
+    const auto summary = metrics.negotiation_conclusion_time.take();
+    CHECK(summary.count == 2);
+    CHECK(summary.min == 0);
+    CHECK(summary.max == 2000000);
+  }
+
+  GIVEN("A request for messages")
+  {
+    std::stringstream csv;
+    builtin_interfaces::msg::Time start;
+    builtin_interfaces::msg::Time stop;
+    stop.sec = 10;
+    const auto messages = metrics.take("test", start, stop, &csv);
+
+    CHECK(messages.size() == 10);
+    for (const auto& msg : messages)
+    {
+      CHECK(msg.measurement_source_name == "test");
+      CHECK(msg.statistics.size() == 4);
+    }
+
+    std::size_t lines = 0;
+    std::string line;
+    while (std::getline(csv, line))
+      ++lines;
+
+    CHECK(lines == messages.size());
+    CHECK(metrics.conflict_check_time.take().count == 0);
+  }
+}